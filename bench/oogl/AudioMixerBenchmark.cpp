@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     AudioMixerBenchmark.cpp
+///! \brief    This file contains a micro-benchmark of the class oogl::AudioMixer. 512 looping
+///!           voices with various gains and pans are mixed at 48 kHz into a null sink, at each
+///!           instruction set level the processor supports, and the share of one core needed to
+///!           keep up with real time is reported. When a path is given, the output of the best
+///!           level is also recorded into a WAV file.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::AudioMixer
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Include list
+#include "AudioMixer.hpp"
+#include "NullAudioSink.hpp"
+#include "WavFileSink.hpp"
+
+
+
+//==================================================================================================
+// Benchmark parameters.
+//==================================================================================================
+namespace
+{
+    unsigned int const VOICE_COUNT  = 512;      // Concurrent voices
+    unsigned int const SAMPLE_RATE  = 48000;    // Frames per second
+    unsigned int const SECONDS      = 10;       // Audio time mixed per level
+    std::size_t const  PERIOD       = 480;      // Frames pulled by each output callback
+
+    char const * const ISA_NAMES[] = { "scalar", "sse2", "avx2", "avx512" };
+}
+
+
+//==================================================================================================
+// Mix the voices at every supported level.
+//==================================================================================================
+int main(int argc, char ** argv)
+{
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> uniform(-1.f, 1.f);
+
+    std::vector<std::vector<float>> sounds(16);    // voices share a few sounds, of various lengths
+    for (std::size_t sound = 0; sound < sounds.size(); sound++) {
+        sounds[sound].resize(SAMPLE_RATE / 4 + sound * 997);
+        for (float & sample : sounds[sound]) {
+            sample = uniform(random);
+        }
+    }
+
+    oogl::IsaLevel const supported = oogl::Blitter::detectIsaLevel();
+
+    std::printf("%-8s %8s %12s\n", "isa", "voices", "core %");
+
+    for (int level = 0; level <= static_cast<int>(supported); level++) {
+        oogl::AudioMixer mixer(SAMPLE_RATE);
+        mixer.setIsaLevel(static_cast<oogl::IsaLevel>(level));
+
+        for (unsigned int voice = 0; voice < VOICE_COUNT; voice++) {
+            std::vector<float> const & sound = sounds[voice % sounds.size()];
+            mixer.play(sound.data(), sound.size(), 1.f / VOICE_COUNT, uniform(random), true);
+        }
+
+        std::unique_ptr<oogl::IAudioSink> sink;
+        if (argc > 1 && level == static_cast<int>(supported)) {
+            sink.reset(new oogl::WavFileSink(argv[1], SAMPLE_RATE));
+        } else {
+            sink.reset(new oogl::NullAudioSink());
+        }
+
+        std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+
+        for (std::size_t frame = 0; frame < SAMPLE_RATE * SECONDS; frame += PERIOD) {
+            mixer.render(PERIOD);
+            mixer.drain(*sink, PERIOD);
+        }
+
+        std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+
+        std::printf("%-8s %8u %12.2f\n", ISA_NAMES[level], VOICE_COUNT,
+                    100. * elapsed.count() / SECONDS);
+    }
+
+    return 0;
+}
@@ -0,0 +1,998 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     BenchmarkSuite.cpp
+///! \brief    This file contains the micro-benchmark suite of the framework core : the handler
+///!           tracker (track, untrack, exit with 1k to 1M objects, flat or owned by each other),
+///!           the window tree (link, unlink, stacking and children access on deep and wide
+///!           trees, traversal of a UI tree through the links and flattened, copy and move
+///!           construction, property updates call by call and batched), the routing of the
+///!           pointer events (spatial index over 100k windows, against a walk of every window,
+///!           and its incremental maintenance), the error paths (exception construction, message,
+///!           throw and catch, against the results of the non-throwing API), the job system (task
+///!           submission, parallel loops and nested fork-join), the dispatch of the hot calls
+///!           (virtual calls, against the calls bound at compile time to the static backend), the
+///!           input state (publication, and snapshot reads while idle and while published), the
+///!           replay of a recorded session through the event path and, when the compiler supports
+///!           them, the coroutines of the main loop (spawn of a task and round trip of an event
+///!           to the coroutine awaiting it).
+///!           Each benchmark is repeated and its best time per operation is kept. The results are
+///!           printed as a table, and written as JSON when an output file is given ; the compare
+///!           mode reads two such files and flags the benchmarks which got slower than a threshold,
+///!           so that upgrades can be gated on it.
+///!
+///!           Usage :   BenchmarkSuite [--filter <prefix>] [--output <results.json>]
+///!                     BenchmarkSuite --compare <baseline.json> <current.json> [<threshold %>]
+///!
+///!           The compare mode exits with 1 when a benchmark regressed, or when a benchmark of the
+///!           baseline is missing from the current run.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::OOGLHandler
+///! \see      oogl::Window
+///! \see      oogl::WindowTree
+///! \see      oogl::WindowTransaction
+///! \see      oogl::WindowIndex
+///! \see      oogl::OOGLException
+///! \see      oogl::WorkerPool
+///! \see      oogl::BackendWindow
+///! \see      oogl::InputState
+///! \see      oogl::EventReplayer
+///! \see      oogl::Scheduler
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Include list
+#include "BenchmarkSupport.hpp"
+#include "Coroutine.hpp"
+#include "EventRecorder.hpp"
+#include "EventReplayer.hpp"
+#include "ITrackableObject.hpp"
+#include "InputState.hpp"
+#include "OOGLException.hpp"
+#include "OOGLHandler.hpp"
+#include "OOGLHandlerFactory.hpp"
+#include "ReplayScene.hpp"
+#include "Result.hpp"
+#include "StaticBackend.hpp"
+#include "Window.hpp"
+#include "WindowIndex.hpp"
+#include "WindowTransaction.hpp"
+#include "WindowTree.hpp"
+#include "WorkerPool.hpp"
+
+
+
+//==================================================================================================
+// Benchmark helpers.
+//==================================================================================================
+namespace
+{
+    // Repetitions of a benchmark : at least the minimum, then more until the time budget is spent.
+    std::size_t const MIN_REPETITIONS = 5;
+    std::size_t const MAX_REPETITIONS = 1000;
+    double const      TIME_BUDGET     = 2.0e8;    // nanoseconds per benchmark
+
+    // Default slowdown flagged as a regression by the compare mode, in percent.
+    double const      DEFAULT_THRESHOLD = 10.0;
+
+    // Result of a benchmark.
+    struct Result
+    {
+        std::string    name;           // Benchmark identifier, as "group/case/size"
+        std::size_t    operations;     // Operations timed per repetition
+        std::size_t    repetitions;    // Repetitions run
+        double         nsPerOp;        // Best time per operation, in nanoseconds
+    };
+
+    // Trackable object doing nothing, possibly owned by another one.
+    class Dummy : public oogl::ITrackableObject
+    {
+        public:
+        virtual void init() override {}
+        virtual void free() override {}
+        virtual oogl::ITrackableObject * getOwner() const noexcept override { return owner; }
+
+        Dummy * owner = nullptr;
+    };
+
+    using oogl::bench::measure;
+    using oogl::bench::s_sink;
+
+
+    // Benchmarks registry, runner and reporter.
+    class Suite
+    {
+        public:
+
+        explicit Suite(std::string const & filter) : m_filter(filter), m_results() {}
+
+        // Run a benchmark : the setup and the teardown of each repetition are not timed.
+        void run(std::string const & name, std::size_t operations,
+                 std::function<void()> const & setup, std::function<void()> const & body,
+                 std::function<void()> const & teardown)
+        {
+            if (name.compare(0, m_filter.size(), m_filter) != 0) {    // filtered out
+                return;
+            }
+
+            double      best        = 0.0;
+            double      spent       = 0.0;
+            std::size_t repetitions = 0;
+
+            while (repetitions < MIN_REPETITIONS
+                   || (spent < TIME_BUDGET && repetitions < MAX_REPETITIONS)) {
+                setup();
+                double const time = measure(body);
+                teardown();
+
+                best   = repetitions == 0 ? time : std::min(best, time);
+                spent += time;
+                repetitions++;
+            }
+
+            m_results.push_back(Result { name, operations, repetitions, best / operations });
+            std::printf("%-40s %10zu %8zu %14.2f\n", name.c_str(), operations, repetitions,
+                        best / operations);
+            std::fflush(stdout);
+        }
+
+        // Run a benchmark without setup nor teardown.
+        void run(std::string const & name, std::size_t operations,
+                 std::function<void()> const & body)
+        {
+            run(name, operations, [] () {}, body, [] () {});
+        }
+
+        // Write the results as a JSON document.
+        void writeJson(std::ostream & stream) const
+        {
+            stream << "{\n  \"suite\": \"oogl\",\n  \"results\": [\n";
+
+            for (std::size_t index = 0; index < m_results.size(); index++) {
+                Result const & result = m_results[index];
+                char           nsPerOp[32];
+                std::snprintf(nsPerOp, sizeof(nsPerOp), "%.3f", result.nsPerOp);
+
+                stream << "    {\"name\": \"" << result.name << "\", \"operations\": "
+                       << result.operations << ", \"repetitions\": " << result.repetitions
+                       << ", \"ns_per_op\": " << nsPerOp << "}"
+                       << (index + 1 < m_results.size() ? ",\n" : "\n");
+            }
+
+            stream << "  ]\n}\n";
+        }
+
+        private:
+
+        std::string            m_filter;     // Prefix of the benchmarks to run
+        std::vector<Result>    m_results;    // Results of the benchmarks run so far
+    };
+
+
+    // Read the string following a key of a JSON object, from the given position.
+    bool readString(std::string const & text, std::string const & key, std::size_t & position,
+                    std::string & value)
+    {
+        position = text.find("\"" + key + "\"", position);
+        if (position == std::string::npos) { return false; }
+
+        std::size_t const first = text.find('"', text.find(':', position) + 1);
+        std::size_t const last  = text.find('"', first + 1);
+        if (first == std::string::npos || last == std::string::npos) { return false; }
+
+        value    = text.substr(first + 1, last - first - 1);
+        position = last + 1;
+        return true;
+    }
+
+    // Read the number following a key of a JSON object, from the given position.
+    bool readNumber(std::string const & text, std::string const & key, std::size_t & position,
+                    double & value)
+    {
+        position = text.find("\"" + key + "\"", position);
+        if (position == std::string::npos) { return false; }
+
+        char const * const first = text.c_str() + text.find(':', position) + 1;
+        char *             last  = nullptr;
+        value    = std::strtod(first, &last);
+        position = static_cast<std::size_t>(last - text.c_str());
+        return last != first;
+    }
+
+    // Read the time per operation of each benchmark of a results file written by the suite.
+    bool readResults(char const * path, std::map<std::string, double> & results)
+    {
+        std::ifstream file(path);
+        if (! file) {
+            std::fprintf(stderr, "Cannot read the results file %s\n", path);
+            return false;
+        }
+
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        std::string const text = buffer.str();
+
+        std::size_t position = 0;
+        std::string name;
+        double      nsPerOp  = 0.0;
+
+        while (readString(text, "name", position, name)) {
+            if (! readNumber(text, "ns_per_op", position, nsPerOp)) {
+                std::fprintf(stderr, "Malformed results file %s\n", path);
+                return false;
+            }
+            results[name] = nsPerOp;
+        }
+
+        return true;
+    }
+
+    // Compare two results files : returns the exit code of the program.
+    int compare(char const * baselinePath, char const * currentPath, double threshold)
+    {
+        std::map<std::string, double> baseline;
+        std::map<std::string, double> current;
+
+        if (! readResults(baselinePath, baseline) || ! readResults(currentPath, current)) {
+            return 2;
+        }
+
+        std::size_t regressions = 0;
+
+        std::printf("%-40s %14s %14s %9s\n", "benchmark", "baseline ns", "current ns", "change");
+
+        for (std::pair<std::string const, double> const & entry : baseline) {
+            std::map<std::string, double>::const_iterator const found = current.find(entry.first);
+
+            if (found == current.end()) {
+                std::printf("%-40s %14.2f %14s %9s  MISSING\n", entry.first.c_str(), entry.second,
+                            "-", "-");
+                regressions++;
+                continue;
+            }
+
+            double const change     = entry.second > 0.0
+                                    ? (found->second / entry.second - 1.0) * 100.0 : 0.0;
+            bool const   regression = change > threshold;
+
+            std::printf("%-40s %14.2f %14.2f %+8.1f%%%s\n", entry.first.c_str(), entry.second,
+                        found->second, change, regression ? "  REGRESSION" : "");
+            regressions += regression;
+        }
+
+        for (std::pair<std::string const, double> const & entry : current) {
+            if (baseline.find(entry.first) == baseline.end()) {
+                std::printf("%-40s %14s %14.2f %9s  NEW\n", entry.first.c_str(), "-",
+                            entry.second, "-");
+            }
+        }
+
+        std::printf("%zu regression(s) above %.1f%%\n", regressions, threshold);
+        return regressions == 0 ? 0 : 1;
+    }
+
+
+    // Tracker of the graphic library handler, from 1k to 1M objects.
+    void benchmarkHandler(Suite & suite, oogl::OOGLHandler & handler)
+    {
+        for (std::size_t count = 1000; count <= 1000000; count *= 10) {
+            std::vector<Dummy> objects(count);
+            std::string const  size = "/" + std::to_string(count);
+
+            auto const trackAll = [&] () {
+                for (Dummy & object : objects) { handler.track(&object); }
+            };
+            auto const untrackAll = [&] () {
+                for (Dummy & object : objects) { handler.untrack(&object); }
+            };
+
+            suite.run("handler/track" + size, count, [] () {}, trackAll, untrackAll);
+            suite.run("handler/untrack" + size, count, trackAll, untrackAll, [] () {});
+            suite.run("handler/exit" + size, count,
+                      [&] () { handler.init(); trackAll(); },
+                      [&] () { handler.exit(); },
+                      [] () {});
+
+            // Same objects as a binary tree : freed level by level, leaves first
+            for (std::size_t index = 1; index < count; index++) {
+                objects[index].owner = &objects[(index - 1) / 2];
+            }
+
+            suite.run("handler/exit/tree" + size, count,
+                      [&] () { handler.init(); trackAll(); },
+                      [&] () { handler.exit(); },
+                      [] () {});
+        }
+    }
+
+    // Window tree : deep trees are chains of windows, wide trees are one root with many children.
+    void benchmarkWindowTree(Suite & suite)
+    {
+        for (std::size_t count = 1000; count <= 100000; count *= 10) {
+            std::vector<oogl::Window> windows(count + 1);
+            std::string const         size = "/" + std::to_string(count);
+
+            auto const linkDeep = [&] () {
+                for (std::size_t index = 1; index <= count; index++) {
+                    windows[index].linkToParent(windows[index - 1]);
+                }
+            };
+            auto const linkWide = [&] () {
+                for (std::size_t index = 1; index <= count; index++) {
+                    windows[index].linkToParent(windows[0]);
+                }
+            };
+            auto const looseAll = [&] () {
+                for (std::size_t index = 1; index <= count; index++) {
+                    windows[index].looseParent();
+                }
+            };
+
+            suite.run("window/link/deep" + size, count, [] () {}, linkDeep, looseAll);
+            suite.run("window/link/wide" + size, count, [] () {}, linkWide, looseAll);
+            suite.run("window/loose/deep" + size, count, linkDeep, looseAll, [] () {});
+            suite.run("window/loose/wide" + size, count, linkWide, looseAll, [] () {});
+
+            // Walk down the chain, one children access per level
+            suite.run("window/children/deep" + size, count, linkDeep, [&] () {
+                oogl::Window * window = &windows[0];
+                for (std::size_t level = 0; level < count; level++) {
+                    window = &*window->getChildren().begin();
+                }
+                s_sink = s_sink + (window == &windows[count]);
+            }, looseAll);
+
+            // View of the children
+            suite.run("window/children/wide" + size, 1, linkWide, [&] () {
+                s_sink = s_sink + windows[0].getChildren().size();
+            }, looseAll);
+
+            // Stacking changes : every child of the wide tree goes to the top, then to the bottom
+            suite.run("window/raise/wide" + size, count, linkWide, [&] () {
+                for (std::size_t index = 1; index <= count; index++) {
+                    windows[index].raise();
+                }
+            }, looseAll);
+            suite.run("window/lower/wide" + size, count, linkWide, [&] () {
+                for (std::size_t index = 1; index <= count; index++) {
+                    windows[index].lower();
+                }
+            }, looseAll);
+        }
+
+        // UI tree of 50k windows : 50 panels of 100 groups of 10 widgets, walked through the links
+        // of the windows, and through the flattened tree
+        std::size_t const         count = 50000;
+        std::vector<oogl::Window> windows(count + 1);
+        std::size_t               next  = 1;
+
+        while (next < count) {
+            std::size_t const panel = next++;
+            windows[panel].linkToParent(windows[0]);
+
+            for (std::size_t group = 0; group < 100 && next < count; group++) {
+                std::size_t const node = next++;
+                windows[node].linkToParent(windows[panel]);
+
+                for (std::size_t widget = 0; widget < 10 && next < count; widget++) {
+                    windows[next++].linkToParent(windows[node]);
+                }
+            }
+        }
+
+        // Both walks count the leaves, reading every window
+        std::function<std::size_t (oogl::Window const &)> walk;
+        walk = [&walk] (oogl::Window const & window) {
+            std::size_t leaves = window.getFirstChild() == nullptr;
+            for (oogl::Window const & child : window.getChildren()) { leaves += walk(child); }
+            return leaves;
+        };
+
+        suite.run("window/traverse/links/50000", count, [&] () {
+            s_sink = s_sink + walk(windows[0]);
+        });
+
+        oogl::WindowTree tree;
+        suite.run("window/flatten/50000", count, [&] () {
+            tree.build(windows[0]);
+            s_sink = s_sink + tree.size();
+        });
+
+        suite.run("window/traverse/flat/50000", count, [&] () {
+            std::size_t leaves = 0;
+            for (std::size_t index = 0; index < tree.size(); index++) {
+                leaves += tree.getWindow(index).getFirstChild() == nullptr;
+            }
+            s_sink = s_sink + leaves;
+        });
+    }
+
+    // Window copy and move construction, without and with children, and with pixels.
+    void benchmarkWindowCopy(Suite & suite)
+    {
+        std::size_t const          count = 1000;
+        std::vector<oogl::Window>  children(64);
+        std::vector<oogl::Window>  copies;
+        copies.reserve(count);
+
+        oogl::Window bare("benchmark window", { 0, 0, 128, 96 });
+        oogl::Window parent("benchmark window", { 0, 0, 128, 96 });
+        for (oogl::Window & child : children) { child.linkToParent(parent); }
+
+        oogl::Window pixels("benchmark window", { 0, 0, 128, 96 });
+        pixels.init();
+
+        auto const clear = [&] () { copies.clear(); };
+        std::vector<std::pair<char const *, oogl::Window *>> const sources = {
+            { "bare", &bare }, { "children", &parent }, { "pixels", &pixels }
+        };
+
+        for (std::pair<char const *, oogl::Window *> const & source : sources) {
+            suite.run(std::string("window/copy/") + source.first, count, [] () {}, [&] () {
+                for (std::size_t index = 0; index < count; index++) {
+                    copies.emplace_back(*source.second);
+                }
+            }, clear);
+        }
+
+        // The moved-from windows are rebuilt by copy, outside of the timing
+        std::vector<oogl::Window> sourcesToMove;
+        sourcesToMove.reserve(count);
+
+        for (std::pair<char const *, oogl::Window *> const & source : sources) {
+            suite.run(std::string("window/move/") + source.first, count, [&] () {
+                sourcesToMove.clear();
+                for (std::size_t index = 0; index < count; index++) {
+                    sourcesToMove.emplace_back(*source.second);
+                }
+            }, [&] () {
+                for (oogl::Window & window : sourcesToMove) {
+                    copies.emplace_back(std::move(window));
+                }
+            }, [&] () { clear(); sourcesToMove.clear(); });
+        }
+
+        pixels.free();
+    }
+
+    // Opening 500 tool windows, each with a title, options and three layout passes : applied call
+    // by call, against one transaction committed once.
+    void benchmarkWindowTransaction(Suite & suite)
+    {
+        std::size_t const         count = 500;
+        std::vector<oogl::Window> windows(count);
+
+        auto const layout = [] (std::size_t index, unsigned int pass) {
+            unsigned int const slot = static_cast<unsigned int>(index);
+            return oogl::Rectangle { (slot % 25) * 40, (slot / 25) * 30,
+                                     16 + pass * 8, 12 + pass * 6 };
+        };
+        auto const freeAll = [&] () {
+            for (oogl::Window & window : windows) { window.free(); }
+        };
+
+        suite.run("transaction/immediate/500", count, [] () {}, [&] () {
+            for (std::size_t index = 0; index < count; index++) {
+                oogl::Window & window = windows[index];
+                window.setDimensions(layout(index, 0));
+                window.init();
+                window.setTitle("tool window");
+                window.activateOption(oogl::WindowOption::RESIZABLE);
+                window.activateOption(oogl::WindowOption::SHOWN);
+                window.setDimensions(layout(index, 1));
+                window.setDimensions(layout(index, 2));
+            }
+        }, freeAll);
+
+        oogl::WindowTransaction transaction;
+
+        suite.run("transaction/batched/500", count, [] () {}, [&] () {
+            for (std::size_t index = 0; index < count; index++) {
+                oogl::Window & window = windows[index];
+                transaction.setDimensions(window, layout(index, 0)).open(window)
+                           .setTitle(window, "tool window")
+                           .activateOption(window, oogl::WindowOption::RESIZABLE)
+                           .activateOption(window, oogl::WindowOption::SHOWN)
+                           .setDimensions(window, layout(index, 1))
+                           .setDimensions(window, layout(index, 2));
+            }
+            transaction.commit();
+        }, freeAll);
+    }
+
+    // Pointer routing over a UI tree of 100k windows on a 4K screen : 40 overlapping panels, each
+    // one a grid of 49 groups of 50 widgets. One second of mouse motion at 1 kHz goes through the
+    // spatial index, against a walk composing the area of every window for each event.
+    void benchmarkHitTest(Suite & suite)
+    {
+        std::size_t const         count  = 100000;
+        std::size_t const         events = 1000;
+        std::vector<oogl::Window> windows(count + 1);
+        std::size_t               next   = 1;
+        uint32_t                  seed   = 1;
+
+        auto const random = [&seed] (unsigned int range) {
+            seed = seed * 1664525u + 1013904223u;
+            return (seed >> 8) % range;
+        };
+
+        windows[0].setDimensions({ 0, 0, 3840, 2160 });
+
+        for (std::size_t panel = 0; panel < 40; panel++) {
+            oogl::Window & panelWindow = windows[next++];
+            panelWindow.setDimensions({ random(2880), random(1440), 960, 720 });
+            panelWindow.linkToParent(windows[0]);
+
+            for (unsigned int group = 0; group < 49; group++) {    // grid of 7 x 7 groups
+                oogl::Window & groupWindow = windows[next++];
+                groupWindow.setDimensions({ (group % 7) * 137, (group / 7) * 102, 137, 102 });
+                groupWindow.linkToParent(panelWindow);
+
+                for (unsigned int widget = 0; widget < 50; widget++) {    // grid of 10 x 5
+                    oogl::Window & widgetWindow = windows[next++];
+                    widgetWindow.setDimensions({ (widget % 10) * 13 + 1, (widget / 10) * 20 + 1,
+                                                 8 + random(4), 12 + random(6) });
+                    widgetWindow.linkToParent(groupWindow);
+                }
+            }
+        }
+
+        // Mouse path : a random walk across the screen
+        std::vector<oogl::Event> path(events);
+        int32_t                  x = 1920;
+        int32_t                  y = 1080;
+
+        for (oogl::Event & event : path) {
+            x = std::min(3839, std::max(0, x + static_cast<int32_t>(random(65)) - 32));
+            y = std::min(2159, std::max(0, y + static_cast<int32_t>(random(65)) - 32));
+            event         = oogl::Event();
+            event.type    = oogl::EventType::MOUSE_MOTION;
+            event.mouse.x = x;
+            event.mouse.y = y;
+        }
+
+        suite.run("hittest/build/100000", count + 1, [&] () {
+            oogl::WindowIndex const index(windows[0]);
+            s_sink = s_sink + index.size();
+        });
+
+        // Walk of the flattened tree in drawing order : the last window under the pointer is the
+        // topmost one
+        oogl::WindowTree tree;
+        tree.build(windows[0]);
+
+        std::vector<oogl::Rectangle> areas(tree.size());
+        std::vector<oogl::Rectangle> origins(tree.size());
+
+        suite.run("hittest/linear/100000", events, [&] () {
+            std::size_t hits = 0;
+
+            for (oogl::Event const & event : path) {
+                unsigned int const pointerX = static_cast<unsigned int>(event.mouse.x);
+                unsigned int const pointerY = static_cast<unsigned int>(event.mouse.y);
+                oogl::Window *     hit      = nullptr;
+
+                for (std::size_t index = 0; index < tree.size(); index++) {
+                    oogl::Window &        window     = tree.getWindow(index);
+                    oogl::Rectangle const dimensions = window.getDimensions();
+                    uint32_t const        parent     = tree.getParent(index);
+
+                    if (parent == oogl::WindowTree::NO_PARENT) {
+                        origins[index] = dimensions;
+                        areas[index]   = dimensions;
+                    } else {
+                        oogl::Rectangle const & bounds = areas[parent];
+                        unsigned int const left   = origins[parent].xPosition
+                                                    + dimensions.xPosition;
+                        unsigned int const top    = origins[parent].yPosition
+                                                    + dimensions.yPosition;
+                        unsigned int const right  = std::min(left + dimensions.width,
+                                                             bounds.xPosition + bounds.width);
+                        unsigned int const bottom = std::min(top + dimensions.height,
+                                                             bounds.yPosition + bounds.height);
+                        unsigned int const clipX  = std::max(left, bounds.xPosition);
+                        unsigned int const clipY  = std::max(top, bounds.yPosition);
+
+                        origins[index] = { left, top, dimensions.width, dimensions.height };
+                        areas[index]   = { clipX, clipY, right > clipX ? right - clipX : 0,
+                                           bottom > clipY ? bottom - clipY : 0 };
+                    }
+
+                    oogl::Rectangle const & area = areas[index];
+                    if (pointerX - area.xPosition < area.width
+                        && pointerY - area.yPosition < area.height && pointerX >= area.xPosition
+                        && pointerY >= area.yPosition
+                        && ! window.hasOption(oogl::WindowOption::HIDDEN)
+                        && ! window.hasOption(oogl::WindowOption::MINIMIZED)) {
+                        hit = &window;
+                    }
+                }
+
+                hits += hit != nullptr;
+            }
+
+            s_sink = s_sink + hits;
+        });
+
+        oogl::WindowIndex index(windows[0]);
+
+        suite.run("hittest/index/100000", events, [&] () {
+            std::size_t hits = 0;
+            for (oogl::Event event : path) { hits += index.route(event) != nullptr; }
+            s_sink = s_sink + hits;
+        });
+
+        // Incremental maintenance : 1000 widgets moved, each one updating its area in the index
+        suite.run("hittest/move/100000", events, [&] () {
+            for (std::size_t widget = 0; widget < events; widget++) {
+                oogl::Window &        window     = windows[count - widget * 97];
+                oogl::Rectangle const dimensions = window.getDimensions();
+                window.setDimensions({ random(120), random(80), dimensions.width,
+                                       dimensions.height });
+            }
+        });
+    }
+
+    // Error paths : exception construction, message, and the full throw and catch, against the
+    // same error reported through a result.
+    void benchmarkException(Suite & suite, oogl::OOGLHandler & handler)
+    {
+        std::size_t const count = 10000;
+
+        suite.run("exception/construct", count, [&] () {
+            for (std::size_t index = 0; index < count; index++) {
+                oogl::OOGLException const exception(oogl::ExceptionCode::WIN_NOT_CREATED);
+                s_sink = s_sink + exception.getCode();
+            }
+        });
+
+        oogl::OOGLException const exception(oogl::ExceptionCode::WIN_NOT_CREATED);
+
+        suite.run("exception/what", count, [&] () {
+            for (std::size_t index = 0; index < count; index++) {
+                s_sink = s_sink + (exception.what() != nullptr);
+            }
+        });
+
+        suite.run("exception/throw", count, [&] () {
+            for (std::size_t index = 0; index < count; index++) {
+                try {
+                    throw oogl::OOGLException(oogl::ExceptionCode::WIN_NOT_CREATED);
+                } catch (oogl::OOGLException const & caught) {
+                    s_sink = s_sink + caught.getCode();
+                }
+            }
+        });
+
+        suite.run("exception/result", count, [&] () {
+            for (std::size_t index = 0; index < count; index++) {
+                oogl::Result<void> const result(oogl::ExceptionCode::WIN_NOT_CREATED);
+                s_sink = s_sink + result.getCode();
+            }
+        });
+
+        // Tracking nullptr : the error of the throwing and of the non-throwing tracker
+        suite.run("exception/track/throw", count, [&] () {
+            for (std::size_t index = 0; index < count; index++) {
+                try {
+                    handler.track(nullptr);
+                } catch (oogl::OOGLException const & caught) {
+                    s_sink = s_sink + caught.getCode();
+                }
+            }
+        });
+
+        suite.run("exception/track/result", count, [&] () {
+            for (std::size_t index = 0; index < count; index++) {
+                s_sink = s_sink + handler.tryTrack(nullptr).getCode();
+            }
+        });
+    }
+
+    // Recursive fork-join : each call forks one half as a task, and runs the other half itself.
+    std::size_t forkJoin(oogl::WorkerPool & pool, unsigned int depth)
+    {
+        if (depth == 0) {
+            return 1;
+        }
+
+        std::size_t     left = 0;
+        oogl::TaskGroup group(pool);
+
+        group.run([&pool, &left, depth] () { left = forkJoin(pool, depth - 1); });
+        std::size_t const right = forkJoin(pool, depth - 1);
+        group.wait();
+
+        return left + right;
+    }
+
+    // Job system : submission and completion of single tasks, parallel loops of small bodies, and
+    // nested fork-join stealing tasks between the workers.
+    void benchmarkWorkerPool(Suite & suite)
+    {
+        oogl::WorkerPool pool;
+        pool.start();
+
+        std::size_t const count = 10000;
+
+        suite.run("pool/group/run", count, [&] () {
+            oogl::TaskGroup group(pool);
+            for (std::size_t index = 0; index < count; index++) {
+                group.run([] () { s_sink = s_sink + 1; });
+            }
+            group.wait();
+        });
+
+        std::vector<std::size_t> values(1000000, 1);
+
+        for (std::size_t count = 1000; count <= 1000000; count *= 1000) {
+            suite.run("pool/parallelFor/" + std::to_string(count), count, [&] () {
+                pool.parallelFor(count, [&values] (std::size_t index) { values[index] += index; });
+            });
+        }
+
+        suite.run("pool/forkjoin/16", std::size_t(1) << 16, [&] () {
+            s_sink = s_sink + forkJoin(pool, 16);
+        });
+
+        pool.stop();
+    }
+
+    // Input state : publication of a poll, and snapshot reads by another thread, while nothing
+    // gets published and while a writer publishes without pause.
+    void benchmarkInputState(Suite & suite)
+    {
+        std::size_t const count = 100000;
+        oogl::InputState  state;
+        oogl::Event       event = oogl::Event();
+
+        event.type = oogl::EventType::MOUSE_MOTION;
+
+        suite.run("input/publish", count, [&] () {
+            for (std::size_t index = 0; index < count; index++) {
+                event.mouse.x = static_cast<int32_t>(index);
+                state.apply(event);
+                state.publish();
+            }
+        });
+
+        auto const read = [&] () {
+            uint64_t sum = 0;
+            for (std::size_t index = 0; index < count; index++) {
+                sum += static_cast<uint64_t>(state.read().mouseX);
+            }
+            s_sink = s_sink + sum;
+        };
+
+        suite.run("input/read", count, read);
+
+        std::atomic<bool> isPublishing(true);
+        std::thread       writer([&] () {
+            for (int32_t x = 0; isPublishing.load(std::memory_order_relaxed); x++) {
+                event.mouse.x = x;
+                state.apply(event);
+                state.publish();
+            }
+        });
+
+        suite.run("input/read/published", count, read);
+
+        isPublishing.store(false, std::memory_order_relaxed);
+        writer.join();
+    }
+
+    // Replay of a recorded session of one minute through the event queue, the spatial index and
+    // the compositor, per event : the log is synthesized once, then replayed as fast as possible.
+    void benchmarkReplay(Suite & suite)
+    {
+        std::string const path = "BenchmarkSuite.log";
+        std::size_t       count = 0;
+
+        {
+            oogl::EventRecorder recorder(path);
+            oogl::bench::synthesizeSession(recorder, 60000);
+            recorder.close();
+            count = static_cast<std::size_t>(recorder.getEventCount());
+        }
+
+        {
+            oogl::EventReplayer      replayer(path);
+            oogl::bench::ReplayScene scene;
+
+            suite.run("events/replay/60s", count, [&] () {
+                s_sink = s_sink + scene.replay(replayer, oogl::ReplaySpeed::MAXIMUM);
+            });
+        }
+
+        std::remove(path.c_str());
+    }
+
+#if defined(OOGL_HAS_COROUTINES)
+    // Task doing nothing : its cost is the one of its frame and of its scheduling.
+    oogl::Task runEmpty()
+    {
+        co_return;
+    }
+
+    // Task awaiting a number of events of any window.
+    oogl::Task awaitEvents(std::size_t count)
+    {
+        for (std::size_t index = 0; index < count; index++) {
+            oogl::Event const event = co_await oogl::nextEvent();
+            s_sink = s_sink + event.window;
+        }
+    }
+
+    // Coroutines of the main loop : spawn of a task, its frame taken from the pool of the
+    // scheduler, and round trip of an event from its dispatch to the coroutine awaiting it.
+    void benchmarkCoroutine(Suite & suite, oogl::OOGLHandler & handler)
+    {
+        oogl::Scheduler & scheduler = handler.getScheduler();
+        std::size_t const count     = 10000;
+
+        suite.run("coroutine/spawn", count, [&] () {
+            for (std::size_t index = 0; index < count; index++) {
+                oogl::spawn(runEmpty());
+            }
+            scheduler.run();
+        });
+
+        oogl::Event event = oogl::Event();
+        event.type        = oogl::EventType::USER;
+        event.window      = 1;
+
+        suite.run("coroutine/nextEvent", count, [&] () {
+            oogl::spawn(awaitEvents(count));
+            scheduler.run();
+            for (std::size_t index = 0; index < count; index++) {
+                scheduler.dispatch(event);
+                scheduler.run();
+            }
+        });
+    }
+#endif
+
+    // Hot calls through the virtual interface, against the same calls on the static backend :
+    // the windows are reached through base pointers in the first case, and through their final
+    // class in the second.
+    void benchmarkDispatch(Suite & suite)
+    {
+        std::size_t const count  = 1000;
+        std::size_t const passes = 100;
+
+        std::vector<oogl::StaticWindow>   windows(count, oogl::StaticWindow("benchmark window",
+                                                                            { 0, 0, 16, 16 }));
+        std::vector<oogl::Window *>       virtualWindows;
+        std::vector<oogl::StaticWindow *> staticWindows;
+
+        for (oogl::StaticWindow & window : windows) {
+            window.init();
+            virtualWindows.push_back(&window);
+            staticWindows.push_back(&window);
+        }
+
+        // Same body for both : only the static type of the windows changes
+        auto const dispatch = [&] (std::string const & name, auto & targets, auto && call) {
+            suite.run(name, count * passes, [&] () {
+                std::size_t sum = 0;
+                for (std::size_t pass = 0; pass < passes; pass++) {
+                    for (auto * window : targets) { sum += call(*window); }
+                }
+                s_sink = s_sink + sum;
+            });
+        };
+
+        auto const getDimensions = [] (auto & window) { return window.getDimensions().width; };
+        auto const hasOption     = [] (auto & window) {
+            return window.hasOption(oogl::WindowOption::FULLSCREEN);
+        };
+        auto const fill          = [] (auto & window) {
+            window.fill({ 1, 1, 1, 1 }, 0xFF000000);
+            return 0;
+        };
+
+        dispatch("dispatch/virtual/getDimensions", virtualWindows, getDimensions);
+        dispatch("dispatch/static/getDimensions",  staticWindows,  getDimensions);
+        dispatch("dispatch/virtual/hasOption",     virtualWindows, hasOption);
+        dispatch("dispatch/static/hasOption",      staticWindows,  hasOption);
+        dispatch("dispatch/virtual/fill",          virtualWindows, fill);
+        dispatch("dispatch/static/fill",           staticWindows,  fill);
+
+        // Tracking round trips, through the handler interface and through the backend class
+        oogl::OOGLHandlerFactory const factory;
+        oogl::OOGLHandler &            virtualHandler = factory.getGraphicLibraryHandler();
+        oogl::StaticHandler &          staticHandler  = oogl::getStaticHandler();
+        std::vector<Dummy>             objects(count);
+
+        auto const track = [&] (std::string const & name, auto & handler) {
+            suite.run(name, count * passes, [&] () {
+                for (std::size_t pass = 0; pass < passes; pass++) {
+                    for (Dummy & object : objects) { handler.track(&object); }
+                    for (Dummy & object : objects) { handler.untrack(&object); }
+                }
+            });
+        };
+
+        track("dispatch/virtual/track", virtualHandler);
+        track("dispatch/static/track",  staticHandler);
+
+        for (oogl::StaticWindow & window : windows) {
+            window.free();
+        }
+    }
+}
+
+
+//==================================================================================================
+// Run the suite, or compare two runs.
+//==================================================================================================
+int main(int argc, char ** argv)
+{
+    if (argc >= 4 && std::strcmp(argv[1], "--compare") == 0) {
+        return compare(argv[2], argv[3], argc >= 5 ? std::atof(argv[4]) : DEFAULT_THRESHOLD);
+    }
+
+    std::string  filter;
+    char const * output = nullptr;
+
+    for (int index = 1; index < argc; index++) {
+        if (std::strcmp(argv[index], "--filter") == 0 && index + 1 < argc) {
+            filter = argv[++index];
+        } else if (std::strcmp(argv[index], "--output") == 0 && index + 1 < argc) {
+            output = argv[++index];
+        } else {
+            std::fprintf(stderr, "Usage : %s [--filter <prefix>] [--output <results.json>]\n"
+                         "        %s --compare <baseline.json> <current.json> [<threshold %%>]\n",
+                         argv[0], argv[0]);
+            return 2;
+        }
+    }
+
+    oogl::OOGLHandlerFactory factory;
+    factory.createGraphicLibraryHandler(oogl::GraphicLibrary::SOFTWARE);
+
+    Suite suite(filter);
+
+    std::printf("%-40s %10s %8s %14s\n", "benchmark", "operations", "runs", "ns per op");
+
+    benchmarkHandler(suite, factory.getGraphicLibraryHandler());
+    benchmarkWindowTree(suite);
+    benchmarkWindowCopy(suite);
+    benchmarkWindowTransaction(suite);
+    benchmarkHitTest(suite);
+    benchmarkException(suite, factory.getGraphicLibraryHandler());
+    benchmarkWorkerPool(suite);
+    benchmarkDispatch(suite);
+    benchmarkInputState(suite);
+    benchmarkReplay(suite);
+#if defined(OOGL_HAS_COROUTINES)
+    benchmarkCoroutine(suite, factory.getGraphicLibraryHandler());
+#endif
+
+    factory.destroyGraphicLibraryHandler();
+
+    if (output != nullptr) {
+        std::ofstream file(output);
+        suite.writeJson(file);
+
+        if (! file) {
+            std::fprintf(stderr, "Cannot write the results file %s\n", output);
+            return 2;
+        }
+    }
+
+    return 0;
+}
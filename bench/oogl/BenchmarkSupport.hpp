@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     BenchmarkSupport.hpp
+///! \brief    This file contains the helpers shared by the benchmarks : the sink keeping the
+///!           compiler from dropping the measured work, and the timing of a function. Each
+///!           benchmark is a program of its own, built from a single source file.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                       // Non standard include guard
+
+#ifndef OOGL_BENCHMARKSUPPORT_HPP_INCLUDED         // Standard include guard
+#define OOGL_BENCHMARKSUPPORT_HPP_INCLUDED
+
+
+// Standard include list
+#include <chrono>
+#include <cstdint>
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl BenchmarkSupport.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  bench BenchmarkSupport.hpp
+///! \brief      The namespace oogl::bench contains the helpers shared by the benchmarks.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace bench
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \brief    Sink of the measured work : the benchmarks add their results to it, so that the
+    ///!           compiler cannot drop the work producing them.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    inline volatile uint64_t s_sink = 0;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \brief             Time spent in the given function.
+    ///! \param function    Function to call once.
+    ///! \return            The time spent in the function, in nanoseconds.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename Function>
+    double measure(Function && function)
+    {
+        std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+        function();
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start)
+               .count();
+    }
+
+}
+
+}
+
+
+
+#endif    // OOGL_BENCHMARKSUPPORT_HPP_INCLUDED
@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     BlitterBenchmark.cpp
+///! \brief    This file contains a micro-benchmark of the class oogl::Blitter. Each kernel is run
+///!           at each instruction set level the processor supports, on 1000 overlapping sprites of
+///!           256 x 256 pixels drawn into a 1920 x 1080 framebuffer, and its throughput is reported
+///!           in gigapixels per second.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::Blitter
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <chrono>
+#include <cstdio>
+#include <functional>
+
+// Include list
+#include "Blitter.hpp"
+#include "Framebuffer.hpp"
+
+
+
+//==================================================================================================
+// Benchmark parameters.
+//==================================================================================================
+namespace
+{
+    unsigned int const SPRITE_COUNT  = 1000;    // Sprites drawn per run
+    unsigned int const SPRITE_SIZE   = 256;     // Width and height of a sprite
+    unsigned int const TARGET_WIDTH  = 1920;    // Width of the framebuffer drawn into
+    unsigned int const TARGET_HEIGHT = 1080;    // Height of the framebuffer drawn into
+    unsigned int const RUN_COUNT     = 5;       // Runs per kernel, the best one being kept
+
+    char const * const ISA_NAMES[] = { "scalar", "sse2", "avx2", "avx512" };
+
+    // Best time of the runs, in seconds, of drawing every sprite with the given operation.
+    double measure(std::function<void(unsigned int, unsigned int)> const & draw)
+    {
+        double best = 1e30;
+
+        for (unsigned int run = 0; run < RUN_COUNT; run++) {
+            std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+
+            for (unsigned int sprite = 0; sprite < SPRITE_COUNT; sprite++) {    // spread overlaps
+                draw((sprite * 97)  % (TARGET_WIDTH  - SPRITE_SIZE),
+                     (sprite * 131) % (TARGET_HEIGHT - SPRITE_SIZE));
+            }
+
+            std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+            best = std::min(best, elapsed.count());
+        }
+
+        return best;
+    }
+}
+
+
+//==================================================================================================
+// Run every kernel at every supported level.
+//==================================================================================================
+int main()
+{
+    oogl::Framebuffer target;
+    oogl::Framebuffer sprite;
+    oogl::Framebuffer large;
+
+    target.allocate(TARGET_WIDTH, TARGET_HEIGHT);
+    sprite.allocate(SPRITE_SIZE, SPRITE_SIZE);
+    large.allocate(SPRITE_SIZE * 2, SPRITE_SIZE * 2);
+
+    target.clear(0xFF203040);
+    large.clear(0xFF806040);
+    for (unsigned int y = 0; y < SPRITE_SIZE; y++) {    // premultiplied translucent gradient
+        for (unsigned int x = 0; x < SPRITE_SIZE; x++) {
+            uint32_t const alpha = x;
+            sprite.getRow(y)[x] = (alpha << 24) | ((alpha * y / SPRITE_SIZE) << 16) | (alpha / 2);
+        }
+    }
+
+    oogl::Rectangle const area  = { 0, 0, SPRITE_SIZE, SPRITE_SIZE };
+    oogl::Rectangle const whole = { 0, 0, SPRITE_SIZE * 2, SPRITE_SIZE * 2 };
+    double const          pixels = static_cast<double>(SPRITE_COUNT) * SPRITE_SIZE * SPRITE_SIZE;
+
+    oogl::IsaLevel const supported = oogl::Blitter::detectIsaLevel();
+
+    std::printf("%-10s %-8s %12s\n", "kernel", "isa", "Gpixel/s");
+
+    for (int level = 0; level <= static_cast<int>(supported); level++) {
+        oogl::Blitter::selectKernels(static_cast<oogl::IsaLevel>(level));
+
+        double const blit = measure([&] (unsigned int x, unsigned int y) {
+            oogl::Blitter::blit(target, x, y, sprite, area);
+        });
+        double const stretch = measure([&] (unsigned int x, unsigned int y) {
+            oogl::Blitter::stretchBlit(target, { x, y, SPRITE_SIZE, SPRITE_SIZE }, large, whole);
+        });
+        double const blend = measure([&] (unsigned int x, unsigned int y) {
+            oogl::Blitter::blend(target, x, y, sprite, area, oogl::BlendMode::SOURCE_OVER);
+        });
+
+        std::printf("%-10s %-8s %12.3f\n", "blit",    ISA_NAMES[level], pixels / blit    * 1e-9);
+        std::printf("%-10s %-8s %12.3f\n", "stretch", ISA_NAMES[level], pixels / stretch * 1e-9);
+        std::printf("%-10s %-8s %12.3f\n", "blend",   ISA_NAMES[level], pixels / blend   * 1e-9);
+    }
+
+    return 0;
+}
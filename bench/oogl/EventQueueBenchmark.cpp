@@ -0,0 +1,224 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     EventQueueBenchmark.cpp
+///! \brief    This file contains a micro-benchmark of the class oogl::EventQueue. Producer threads
+///!           push events as fast as they can while the consumer drains them by batches, and the
+///!           sustained throughput of the consumer is reported in millions of events per second,
+///!           with the number of events dropped because the queue was full. The throughput runs
+///!           push key presses into the discrete lane, and pointer motions of a new window each
+///!           time into the bulk lane, so that none gets merged ; the coalescing runs push runs of
+///!           motions over a few windows, and report the events handed and the ones merged.
+///!           Then key presses are pushed at 1 kHz during a flood of pointer motions, and the
+///!           latency from their push to their handler is reported by percentile.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::EventQueue
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// Include list
+#include "EventQueue.hpp"
+
+
+
+//==================================================================================================
+// Benchmark parameters.
+//==================================================================================================
+namespace
+{
+    std::size_t const EVENT_COUNT  = 1 << 24;    // Events pushed per run, over all the producers
+    std::size_t const BATCH_SIZE   = 256;        // Events popped per poll
+    std::size_t const KEY_COUNT    = 1000;       // Key presses of a latency run, one per ms
+    uint64_t const    HANDLER_WORK = 200;        // Nanoseconds spent handling each event
+    uint32_t const    FLOOD_BURST  = 1024;       // Motions pushed by a flood between two yields
+
+    // Events pushed by the producers of a run.
+    enum class Stream
+    {
+        DISCRETE,    // Key presses
+        BULK,        // Pointer motions, each one of its own window : never merged
+        RUNS         // Pointer motions, by runs of 64 over four windows per producer
+    };
+
+    // Push the events of one producer, retrying the dropped ones so that all of them get through.
+    void produce(oogl::EventQueue & queue, std::size_t count, uint32_t producer, Stream stream)
+    {
+        oogl::Event event = {};
+        event.type        = stream == Stream::DISCRETE ? oogl::EventType::KEY_DOWN
+                                                       : oogl::EventType::MOUSE_MOTION;
+
+        for (std::size_t index = 0; index < count; index++) {
+            uint32_t const number = static_cast<uint32_t>(index);
+
+            if (stream == Stream::DISCRETE) {
+                event.key.code = number;
+            } else {    // count < 2^24 : the bulk windows are distinct
+                event.window  = stream == Stream::BULK ? (producer << 24) | number
+                                                       : producer * 4 + (number >> 6) % 4;
+                event.mouse.x = static_cast<int32_t>(number);
+            }
+
+            while (! queue.push(event)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // Drain the events of producers pushing a stream, and print the throughput of the consumer.
+    void measureThroughput(unsigned int producers, Stream stream, char const * label)
+    {
+        oogl::EventQueue         queue;
+        std::vector<std::thread> threads;
+        std::vector<oogl::Event> batch(BATCH_SIZE);
+        std::size_t const        share = EVENT_COUNT / producers;
+        std::size_t              received = 0;
+
+        std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+
+        for (unsigned int producer = 0; producer < producers; producer++) {
+            threads.emplace_back(produce, std::ref(queue), share, producer, stream);
+        }
+
+        // The merged motions count as received : they got through, into a later one
+        while (received + queue.getCoalescedCount() < share * producers) {
+            std::size_t const count = queue.poll(batch.data(), batch.size());
+            if (count == 0) {
+                std::this_thread::yield();
+            }
+            received += count;
+        }
+
+        std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+
+        for (std::thread & thread : threads) {
+            thread.join();
+        }
+
+        std::printf("%-10u %-10s %14.2f %12llu %12zu %12llu\n", producers, label,
+                    share * producers / elapsed.count() * 1e-6,
+                    static_cast<unsigned long long>(queue.getOverflowCount()), received,
+                    static_cast<unsigned long long>(queue.getCoalescedCount()));
+    }
+
+    // Push bursts of pointer motions over a few windows until stopped, the dropped ones being
+    // lost : a burst of FLOOD_BURST motions, then the thread yields, as a device thread would.
+    void flood(oogl::EventQueue & queue, std::atomic<bool> const & running, uint32_t producer)
+    {
+        oogl::Event event = {};
+        event.type        = oogl::EventType::MOUSE_MOTION;
+
+        for (uint32_t index = 0; running.load(std::memory_order_relaxed); index++) {
+            event.window    = producer * 4 + (index >> 6) % 4;    // runs of 64 motions per window
+            event.mouse.x   = static_cast<int32_t>(index);
+            event.timestamp = oogl::getEventTimestamp();
+            queue.push(event);
+
+            if (index % FLOOD_BURST == FLOOD_BURST - 1) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // Push the key presses, one per millisecond, each one stamped when pushed.
+    void type(oogl::EventQueue & queue)
+    {
+        std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+        oogl::Event event = {};
+        event.type        = oogl::EventType::KEY_DOWN;
+
+        for (std::size_t index = 0; index < KEY_COUNT; index++) {
+            std::this_thread::sleep_until(start + std::chrono::milliseconds(index));
+            event.key.code  = static_cast<uint32_t>(index);
+            event.timestamp = oogl::getEventTimestamp();
+            while (! queue.push(event)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // Latency of the key presses while floods of motions get pushed by the given producers.
+    void measureLatency(unsigned int floods)
+    {
+        oogl::EventQueue         queue;
+        std::atomic<bool>        running(true);
+        std::vector<std::thread> threads;
+        std::vector<uint64_t>    latencies;
+        std::size_t              handled = 0;
+
+        latencies.reserve(KEY_COUNT);
+
+        for (unsigned int producer = 0; producer < floods; producer++) {
+            threads.emplace_back(flood, std::ref(queue), std::cref(running), producer);
+        }
+
+        std::thread typist(type, std::ref(queue));
+
+        while (latencies.size() < KEY_COUNT) {
+            std::size_t const count = queue.drain([&] (oogl::Event const & event) {
+                uint64_t const end = oogl::getEventTimestamp() + HANDLER_WORK;
+                while (oogl::getEventTimestamp() < end) {}    // work of the handler
+
+                if (event.type == oogl::EventType::KEY_DOWN) {
+                    latencies.push_back(oogl::getEventTimestamp() - event.timestamp);
+                }
+            });
+
+            if (count == 0) {
+                std::this_thread::yield();
+            }
+            handled += count;
+        }
+
+        typist.join();
+        running.store(false, std::memory_order_relaxed);
+
+        for (std::thread & thread : threads) {
+            thread.join();
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+
+        std::printf("%-10u %12.1f %12.1f %12.1f %12zu %12llu\n", floods,
+                    latencies[KEY_COUNT / 2] * 1e-3, latencies[KEY_COUNT * 99 / 100] * 1e-3,
+                    latencies.back() * 1e-3, handled,
+                    static_cast<unsigned long long>(queue.getCoalescedCount()));
+    }
+}
+
+
+//==================================================================================================
+// Run the consumer against one to four producers, for each lane then with merged runs, then the
+// latency runs.
+//==================================================================================================
+int main()
+{
+    std::printf("%-10s %-10s %14s %12s %12s %12s\n", "producers", "stream", "Mevent/s",
+                "overflows", "handed", "merged");
+
+    for (unsigned int producers = 1; producers <= 4; producers++) {
+        measureThroughput(producers, Stream::DISCRETE, "discrete");
+        measureThroughput(producers, Stream::BULK, "bulk");
+    }
+
+    std::printf("\n");
+
+    for (unsigned int producers = 1; producers <= 4; producers++) {
+        measureThroughput(producers, Stream::RUNS, "runs");
+    }
+
+    std::printf("\n%-10s %12s %12s %12s %12s %12s\n", "floods", "p50 us", "p99 us", "max us",
+                "handled", "merged");
+
+    for (unsigned int floods = 1; floods <= 3; floods++) {
+        measureLatency(floods);
+    }
+
+    return 0;
+}
@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     EventReplayBenchmark.cpp
+///! \brief    This file contains the benchmark of the path from the events to the rendering,
+///!           driven by a recorded session. Without a log, a session of 10 minutes is synthesized
+///!           (pointer motions at 1 kHz, key presses, clicks, window drags and a frame timer at
+///!           60 Hz) and recorded through an event queue, the recording cost and the size of the
+///!           log being reported. The log is then decoded alone, and replayed through the whole
+///!           path : each event is pushed into an event queue, drained, routed through the spatial
+///!           index of a window tree and drawn, and each frame tick composes the tree and presents
+///!           it. The replay runs as fast as possible, and its speedup over the recorded time is
+///!           reported ; the benchmark suite times the same replay, to track it across runs.
+///!
+///!           Usage :   EventReplayBenchmark [--real-time] [<session log>]
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::EventRecorder
+///! \see      oogl::EventReplayer
+///! \see      oogl::EventQueue
+///! \see      oogl::WindowIndex
+///! \see      oogl::Compositor
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+// Include list
+#include "BenchmarkSupport.hpp"
+#include "EventRecorder.hpp"
+#include "EventReplayer.hpp"
+#include "OOGLHandlerFactory.hpp"
+#include "ReplayScene.hpp"
+
+
+
+//==================================================================================================
+// Benchmark parameters.
+//==================================================================================================
+namespace
+{
+    uint64_t const     SESSION_LENGTH = 600000;     // Milliseconds of the synthesized session
+    unsigned int const DECODE_PASSES  = 5;          // Decoding runs, the best one being kept
+
+    using oogl::bench::s_sink;
+
+    // Synthesize a session, and report the recording cost and the size of the log.
+    void synthesize(std::string const & path)
+    {
+        oogl::EventRecorder recorder(path);
+        std::size_t         handled = 0;
+
+        double const elapsed = oogl::bench::measure([&] () {
+            handled = oogl::bench::synthesizeSession(recorder, SESSION_LENGTH);
+            recorder.close();
+        });
+
+        std::printf("%-12s %12s %12s %12s %12s\n", "record", "events", "handled", "bytes/event",
+                    "ns/event");
+        std::printf("%-12s %12llu %12zu %12.2f %12.1f\n\n", "synthesized",
+                    static_cast<unsigned long long>(recorder.getEventCount()), handled,
+                    static_cast<double>(recorder.getByteCount()) / recorder.getEventCount(),
+                    elapsed / recorder.getEventCount());
+    }
+
+    // Decode the whole log, without handling the events.
+    void decode(oogl::EventReplayer & replayer)
+    {
+        double      best  = 1e300;
+        std::size_t count = 0;
+
+        for (unsigned int pass = 0; pass < DECODE_PASSES; pass++) {
+            best = std::min(best, oogl::bench::measure([&] () {
+                replayer.rewind();
+                count = replayer.replay([] (oogl::Event const & event) {
+                    s_sink = s_sink + event.timestamp;
+                }, oogl::ReplaySpeed::MAXIMUM);
+            }) * 1e-9);
+        }
+
+        std::printf("%-12s %12s %12s %12s %12s\n", "decode", "events", "MB", "Mevent/s", "GB/s");
+        std::printf("%-12s %12zu %12.1f %12.1f %12.2f %s\n\n", "maximum", count,
+                    replayer.getSize() * 1e-6, count / best * 1e-6,
+                    replayer.getSize() / best * 1e-9, replayer.isAtEnd() ? "" : "(truncated log)");
+    }
+
+    // Replay the log through the queue, the index and the compositor.
+    void render(oogl::EventReplayer & replayer, oogl::ReplaySpeed speed)
+    {
+        oogl::bench::ReplayScene scene;
+
+        // Recorded times of the first and the last events, to tell the length of the session
+        oogl::Event first = oogl::Event();
+        oogl::Event last  = oogl::Event();
+
+        replayer.rewind();
+        replayer.next(first);
+        last = first;
+        while (replayer.next(last)) {}
+
+        std::size_t  count   = 0;
+        double const elapsed = oogl::bench::measure([&] () {
+            count = scene.replay(replayer, speed);
+        }) * 1e-9;
+        double const length  = (last.timestamp - first.timestamp) * 1e-9;
+
+        std::printf("%-12s %12s %12s %12s %12s %12s\n", "replay", "events", "frames", "session s",
+                    "replay s", "speedup");
+        std::printf("%-12s %12zu %12zu %12.1f %12.2f %12.1f\n",
+                    speed == oogl::ReplaySpeed::MAXIMUM ? "maximum" : "real time", count,
+                    scene.getFrameCount(), length, elapsed, length / elapsed);
+    }
+}
+
+
+//==================================================================================================
+// Record a session unless one is given, then decode and replay it.
+//==================================================================================================
+int main(int argc, char ** argv)
+{
+    oogl::ReplaySpeed speed = oogl::ReplaySpeed::MAXIMUM;
+    std::string       path;
+
+    for (int index = 1; index < argc; index++) {
+        if (std::strcmp(argv[index], "--real-time") == 0) {
+            speed = oogl::ReplaySpeed::REAL_TIME;
+        } else if (path.empty() && argv[index][0] != '-') {
+            path = argv[index];
+        } else {
+            std::fprintf(stderr, "Usage : %s [--real-time] [<session log>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    bool const synthesized = path.empty();
+
+    if (synthesized) {
+        path = "EventReplayBenchmark.log";
+        synthesize(path);
+    }
+
+    oogl::OOGLHandlerFactory factory;
+    factory.createGraphicLibraryHandler(oogl::GraphicLibrary::SOFTWARE);
+
+    {
+        oogl::EventReplayer replayer(path);
+
+        decode(replayer);
+        render(replayer, speed);
+    }
+
+    factory.destroyGraphicLibraryHandler();
+
+    if (synthesized) {
+        std::remove(path.c_str());
+    }
+
+    return 0;
+}
@@ -0,0 +1,342 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     ReplayScene.hpp
+///! \brief    This file contains the recorded session shared by the replay benchmarks : its
+///!           synthesis (pointer motions at 1 kHz, key presses, clicks, window drags and a frame
+///!           timer at 60 Hz), and the scene replaying it through the whole path from the events
+///!           to the rendering. Each replayed event is pushed into an event queue, drained, routed
+///!           through the spatial index of a window tree and drawn, and each frame tick composes
+///!           the tree and presents it.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::EventRecorder
+///! \see      oogl::EventReplayer
+///! \see      oogl::EventQueue
+///! \see      oogl::WindowIndex
+///! \see      oogl::Compositor
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                   // Non standard include guard
+
+#ifndef OOGL_REPLAYSCENE_HPP_INCLUDED          // Standard include guard
+#define OOGL_REPLAYSCENE_HPP_INCLUDED
+
+
+// Standard include list
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Project include list
+#include "Compositor.hpp"
+#include "EventQueue.hpp"
+#include "EventRecorder.hpp"
+#include "EventReplayer.hpp"
+#include "Framebuffer.hpp"
+#include "Window.hpp"
+#include "WindowIndex.hpp"
+#include "WorkerPool.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl ReplayScene.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  bench ReplayScene.hpp
+///! \brief      The namespace oogl::bench contains the helpers shared by the benchmarks.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace bench
+{
+
+
+    uint64_t const     FRAME_PERIOD  = 16;     ///!< Milliseconds between two frame ticks.
+    unsigned int const SCREEN_WIDTH  = 640;    ///!< Width of the root window.
+    unsigned int const SCREEN_HEIGHT = 360;    ///!< Height of the root window.
+    unsigned int const PANEL_COUNT   = 6;      ///!< Panels of 200 x 160, in a grid of 3 x 2.
+    unsigned int const WIDGET_COUNT  = 20;     ///!< Widgets of 32 x 32 per panel, 5 x 4.
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \brief             Synthesize a session through a queue recording the events it hands :
+    ///!                    every millisecond the pointer moves, and now and then a key gets typed,
+    ///!                    a button clicked or a panel dragged. The session is always the same.
+    ///! \param recorder    Recorder the events are written to.
+    ///! \param length      Length of the session, in milliseconds.
+    ///! \return            The number of events handled from the queue.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    inline std::size_t synthesizeSession(oogl::EventRecorder & recorder, uint64_t length)
+    {
+        // Pseudo random generator, and step of the pointer along an axis, from -4 to 4 pixels
+        uint32_t   seed   = 1;
+        auto const random = [&seed] (uint32_t range) {
+            seed = seed * 1664525u + 1013904223u;
+            return (seed >> 8) % range;
+        };
+        auto const step   = [&random] () { return static_cast<int32_t>(random(9)) - 4; };
+
+        oogl::EventQueue queue;
+        oogl::Event      event   = oogl::Event();
+        int32_t          x       = SCREEN_WIDTH / 2;
+        int32_t          y       = SCREEN_HEIGHT / 2;
+        uint32_t         dragged = 0;
+        std::size_t      handled = 0;
+
+        queue.setRecorder(&recorder);
+
+        for (uint64_t time = 0; time < length; time++) {
+            event           = oogl::Event();
+            event.timestamp = time * 1000000;
+
+            x = std::min<int32_t>(SCREEN_WIDTH - 1, std::max<int32_t>(0, x + step()));
+            y = std::min<int32_t>(SCREEN_HEIGHT - 1, std::max<int32_t>(0, y + step()));
+
+            event.type    = oogl::EventType::MOUSE_MOTION;
+            event.mouse.x = x;
+            event.mouse.y = y;
+            queue.push(event);
+
+            if (time % FRAME_PERIOD == 0) {           // frame tick
+                event          = oogl::Event();
+                event.type     = oogl::EventType::TIMER;
+                event.timer.id = time / FRAME_PERIOD;
+                queue.push(event);
+            }
+
+            if (time % 200 == 0 || time % 200 == 80) {    // typing, 5 keys per second
+                event          = oogl::Event();
+                event.type     = time % 200 == 0 ? oogl::EventType::KEY_DOWN
+                                                 : oogl::EventType::KEY_UP;
+                event.key.code = 'a' + static_cast<uint32_t>(time / 200 % 26);
+                queue.push(event);
+            }
+
+            if (time % 1000 == 500 || time % 1000 == 600) {    // a click per second
+                event                = oogl::Event();
+                event.type           = time % 1000 == 500 ? oogl::EventType::MOUSE_BUTTON_DOWN
+                                                          : oogl::EventType::MOUSE_BUTTON_UP;
+                event.mouse.x        = x;
+                event.mouse.y        = y;
+                event.mouse.button   = 1;
+                queue.push(event);
+            }
+
+            if (time % 30000 < 500) {                 // a panel dragged for 500 ms every 30 s
+                dragged = dragged != 0 && time % 30000 != 0 ? dragged : 1 + random(PANEL_COUNT);
+
+                event             = oogl::Event();
+                event.type        = oogl::EventType::WINDOW_MOVED;
+                event.window      = dragged;
+                event.area.x      = static_cast<int32_t>(time % 30000 / 10 + 20);
+                event.area.y      = static_cast<int32_t>((dragged - 1) / 3 * 180 + 10);
+                event.area.width  = 200;
+                event.area.height = 160;
+                queue.push(event);
+            }
+
+            handled += queue.drain([] (oogl::Event const &) {});
+        }
+
+        return handled;
+    }
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    ReplayScene ReplayScene.hpp
+    ///! \brief    Window tree of panels of widgets over a root window, with its spatial index,
+    ///!           its event queue and its compositor, replaying a session : the pointer hovers and
+    ///!           focuses the widgets, the keys get typed into the focused one, the panels get
+    ///!           dragged and each frame tick presents the damage of the tree. The scene needs a
+    ///!           graphic library handler to initialize its windows.
+    ///! \version  1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class ReplayScene
+    {
+        public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Build the window tree and its index, and start the workers of the
+        ///!           compositor.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ReplayScene()
+        : m_windows(buildWindows()), m_index(m_windows[0]), m_queue(), m_pool(),
+          m_compositor(m_pool), m_frame(), m_screen(), m_hovered(nullptr), m_focused(nullptr),
+          m_frames(0), m_damaged(false)
+        {
+            m_screen.allocate(SCREEN_WIDTH, SCREEN_HEIGHT);
+            m_pool.start();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Stop the workers, and free the windows.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ~ReplayScene() noexcept
+        {
+            m_pool.stop();
+
+            for (oogl::Window & window : m_windows) {
+                window.free();
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief             Replay a whole log through the scene, from its start.
+        ///! \param replayer    Log to replay.
+        ///! \param speed       Pace of the replay.
+        ///! \return            The number of events replayed.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        std::size_t replay(oogl::EventReplayer & replayer, oogl::ReplaySpeed speed)
+        {
+            auto const handler = [this] (oogl::Event const & event) { handle(event); };
+
+            replayer.rewind();
+
+            std::size_t const count = replayer.replay([&] (oogl::Event const & event) {
+                while (! m_queue.push(event)) {    // full : handle the queued events first
+                    m_queue.drain(handler);
+                }
+                if (event.type == oogl::EventType::TIMER) {
+                    m_queue.drain(handler);
+                }
+            }, speed);
+
+            m_queue.drain(handler);
+            return count;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the number of frame ticks handled so far.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline std::size_t getFrameCount() const noexcept    { return m_frames; }
+
+        // Delete the copy : the index and the compositor refer to the members
+        ReplayScene(ReplayScene const &) = delete;
+        ReplayScene & operator=(ReplayScene const &) = delete;
+
+        private:
+
+        // Panels of widgets over the root, linked before the index gets built over them.
+        static std::vector<oogl::Window> buildWindows()
+        {
+            std::vector<oogl::Window> windows(1 + PANEL_COUNT * (1 + WIDGET_COUNT));
+            std::size_t               next = 1;
+
+            windows[0].setDimensions({ 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT });
+
+            for (unsigned int panel = 0; panel < PANEL_COUNT; panel++) {
+                oogl::Window & panelWindow = windows[next++];
+                panelWindow.setDimensions({ panel % 3 * 210 + 10, panel / 3 * 180 + 10, 200,
+                                            160 });
+                panelWindow.linkToParent(windows[0]);
+
+                for (unsigned int widget = 0; widget < WIDGET_COUNT; widget++) {
+                    oogl::Window & widgetWindow = windows[next++];
+                    widgetWindow.setDimensions({ widget % 5 * 38 + 6, widget / 5 * 38 + 6, 32,
+                                                 32 });
+                    widgetWindow.linkToParent(panelWindow);
+                }
+            }
+
+            for (oogl::Window & window : windows) {
+                window.init();
+                window.activateOption(oogl::WindowOption::OPAQUE);
+                window.fill({ 0, 0, window.getDimensions().width,
+                              window.getDimensions().height }, 0xFF202020);
+            }
+
+            return windows;
+        }
+
+        // Handle an event popped from the queue.
+        void handle(oogl::Event const & popped)
+        {
+            oogl::Event event = popped;
+
+            switch (event.type) {
+                case oogl::EventType::MOUSE_MOTION:
+                case oogl::EventType::MOUSE_BUTTON_DOWN: {
+                    oogl::Window * const hit = m_index.route(event);
+
+                    if (hit != m_hovered) {               // hover highlight
+                        if (m_hovered != nullptr) {
+                            m_hovered->fill({ 0, 0, 32, 32 }, 0xFF202020);
+                        }
+                        if (hit != nullptr && hit->getFirstChild() == nullptr) {
+                            hit->fill({ 0, 0, 32, 32 }, 0xFF404040);
+                        }
+                        m_hovered = hit != nullptr && hit->getFirstChild() == nullptr ? hit
+                                                                                      : nullptr;
+                        m_damaged = true;
+                    }
+
+                    if (event.type == oogl::EventType::MOUSE_BUTTON_DOWN) {
+                        m_focused = m_hovered;
+                    }
+                    break;
+                }
+
+                case oogl::EventType::KEY_DOWN:
+                    if (m_focused != nullptr) {           // typing into the focused widget
+                        m_focused->fill({ 4, 4, 24, 24 }, 0xFF000000 | event.key.code * 0x010101);
+                        m_damaged = true;
+                    }
+                    break;
+
+                case oogl::EventType::WINDOW_MOVED:
+                    if (event.window >= 1 && event.window <= PANEL_COUNT) {
+                        m_windows[(event.window - 1) * (1 + WIDGET_COUNT) + 1].setDimensions({
+                            static_cast<unsigned int>(event.area.x),
+                            static_cast<unsigned int>(event.area.y),
+                            event.area.width, event.area.height });
+                        m_damaged = true;
+                    }
+                    break;
+
+                case oogl::EventType::TIMER:              // frame tick
+                    if (m_damaged) {
+                        for (oogl::Rectangle const & rectangle :
+                             m_compositor.compose(m_windows[0], m_frame).getRectangles()) {
+                            m_screen.copy(m_frame, rectangle.xPosition, rectangle.yPosition,
+                                          rectangle.width, rectangle.height, rectangle.xPosition,
+                                          rectangle.yPosition);
+                        }
+                        m_damaged = false;
+                    }
+                    m_frames++;
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        std::vector<oogl::Window>    m_windows;       ///!< Root, then each panel and its widgets.
+        oogl::WindowIndex            m_index;         ///!< Index routing the pointer events.
+        oogl::EventQueue             m_queue;         ///!< Queue the replayed events go through.
+        oogl::WorkerPool             m_pool;          ///!< Workers of the compositor.
+        oogl::Compositor             m_compositor;    ///!< Compositor of the window tree.
+        oogl::Framebuffer            m_frame;         ///!< Frame composed from the tree.
+        oogl::Framebuffer            m_screen;        ///!< Screen the damage gets presented to.
+        oogl::Window *               m_hovered;       ///!< Widget under the pointer, if any.
+        oogl::Window *               m_focused;       ///!< Widget typed into, if any.
+        std::size_t                  m_frames;        ///!< Frame ticks handled.
+        bool                         m_damaged;       ///!< Whether the tree needs a new frame.
+    };
+
+}
+
+}
+
+
+
+#endif    // OOGL_REPLAYSCENE_HPP_INCLUDED
@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     TimerWheelBenchmark.cpp
+///! \brief    This file contains a micro-benchmark of the class oogl::TimerWheel, compared to an
+///!           ordered std::multimap of deadlines. For each timer count, the timers are scheduled
+///!           with random delays up to one minute, a quarter of them get cancelled, and the time
+///!           runs until the others have fired ; the time per operation is reported.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::TimerWheel
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <cstdio>
+#include <map>
+#include <random>
+#include <vector>
+
+// Include list
+#include "BenchmarkSupport.hpp"
+#include "TimerWheel.hpp"
+
+
+
+//==================================================================================================
+// Benchmark helpers.
+//==================================================================================================
+namespace
+{
+    uint64_t const TICK      = 1000000;         // 1 ms ticks
+    uint64_t const MAX_DELAY = 60000 * TICK;    // One minute
+    uint64_t const FRAME     = 16 * TICK;       // Time advanced per update
+
+    using oogl::bench::measure;
+    using oogl::bench::s_sink;
+
+    void onTimer(oogl::TimerHandle, uint64_t data) { s_sink = s_sink + data; }
+}
+
+
+//==================================================================================================
+// Compare the wheel to the ordered map for 10k to 1M timers.
+//==================================================================================================
+int main()
+{
+    std::printf("%-9s %-9s %12s %12s %12s\n", "timers", "service", "schedule ns", "cancel ns",
+                "fire ns");
+
+    for (std::size_t count = 10000; count <= 1000000; count *= 10) {
+        std::mt19937_64       random(count);
+        std::vector<uint64_t> delays(count);
+
+        for (uint64_t & delay : delays) {
+            delay = random() % MAX_DELAY;
+        }
+
+        // Ordered map of deadlines, the usual priority queue allowing cancellations
+        {
+            std::multimap<uint64_t, uint64_t>                          timers;
+            std::vector<std::multimap<uint64_t, uint64_t>::iterator>   handles(count);
+            uint64_t                                                   now = 0;
+
+            double const schedule = measure([&] () {
+                for (std::size_t index = 0; index < count; index++) {
+                    handles[index] = timers.emplace(now + delays[index], index);
+                }
+            });
+            double const cancel = measure([&] () {
+                for (std::size_t index = 0; index < count; index += 4) {
+                    timers.erase(handles[index]);
+                }
+            });
+            double const fire = measure([&] () {
+                while (! timers.empty()) {
+                    now += FRAME;
+                    while (! timers.empty() && timers.begin()->first <= now) {
+                        onTimer(oogl::INVALID_SLOT_HANDLE, timers.begin()->second);
+                        timers.erase(timers.begin());
+                    }
+                }
+            });
+
+            std::printf("%-9zu %-9s %12.2f %12.2f %12.2f\n", count, "multimap", schedule / count,
+                        cancel / (count / 4), fire / (count - count / 4));
+        }
+
+        // Timing wheel
+        {
+            oogl::TimerWheel               wheel(TICK);
+            std::vector<oogl::TimerHandle> handles(count);
+
+            double const schedule = measure([&] () {
+                for (std::size_t index = 0; index < count; index++) {
+                    handles[index] = wheel.schedule(delays[index], onTimer, index);
+                }
+            });
+            double const cancel = measure([&] () {
+                for (std::size_t index = 0; index < count; index += 4) {
+                    wheel.cancel(handles[index]);
+                }
+            });
+            double const fire = measure([&] () {
+                while (wheel.getTimerCount() > 0) {
+                    wheel.advance(FRAME / TICK);
+                }
+            });
+
+            std::printf("%-9zu %-9s %12.2f %12.2f %12.2f\n", count, "wheel", schedule / count,
+                        cancel / (count / 4), fire / (count - count / 4));
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     TrackerBenchmark.cpp
+///! \brief    This file contains a micro-benchmark comparing the tracker of the graphic library
+///!           handler, a oogl::SlotMap of trackable object pointers, to the std::set it replaced.
+///!           For each object count, the objects are tracked, churned (half of them get untracked
+///!           and tracked again) and walked, and the time per operation is reported.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::SlotMap
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <cstdio>
+#include <set>
+#include <vector>
+
+// Include list
+#include "BenchmarkSupport.hpp"
+#include "ITrackableObject.hpp"
+#include "SlotMap.hpp"
+
+
+
+//==================================================================================================
+// Benchmark helpers.
+//==================================================================================================
+namespace
+{
+    // Trackable object doing nothing.
+    class Dummy : public oogl::ITrackableObject
+    {
+        public:
+        virtual void init() override {}
+        virtual void free() override {}
+    };
+
+    using oogl::bench::measure;
+    using oogl::bench::s_sink;
+}
+
+
+//==================================================================================================
+// Compare the containers for 1k to 1M objects.
+//==================================================================================================
+int main()
+{
+    std::printf("%-9s %-9s %12s %12s %12s\n", "objects", "tracker", "track ns", "churn ns",
+                "walk ns");
+
+    for (std::size_t count = 1000; count <= 1000000; count *= 10) {
+        std::vector<Dummy> objects(count);
+
+        // Former tracker
+        {
+            std::set<oogl::ITrackableObject *> tracker;
+
+            double const track = measure([&] () {
+                for (Dummy & object : objects) { tracker.insert(&object); }
+            });
+            double const churn = measure([&] () {
+                for (std::size_t index = 0; index < count; index += 2) {
+                    tracker.erase(&objects[index]);
+                }
+                for (std::size_t index = 0; index < count; index += 2) {
+                    tracker.insert(&objects[index]);
+                }
+            });
+            double const walk = measure([&] () {
+                std::size_t live = 0;
+                for (oogl::ITrackableObject * object : tracker) { live += object != nullptr; }
+                s_sink = live;
+            });
+
+            std::printf("%-9zu %-9s %12.2f %12.2f %12.2f\n", count, "set", track / count,
+                        churn / count, walk / count);
+        }
+
+        // Slot map tracker : the handles are kept aside, as the objects keep theirs
+        {
+            oogl::SlotMap<oogl::ITrackableObject *> tracker;
+            std::vector<oogl::SlotHandle>           handles(count);
+
+            double const track = measure([&] () {
+                for (std::size_t index = 0; index < count; index++) {
+                    handles[index] = tracker.insert(&objects[index]);
+                }
+            });
+            double const churn = measure([&] () {
+                for (std::size_t index = 0; index < count; index += 2) {
+                    tracker.erase(handles[index]);
+                }
+                for (std::size_t index = 0; index < count; index += 2) {
+                    handles[index] = tracker.insert(&objects[index]);
+                }
+            });
+            double const walk = measure([&] () {
+                std::size_t live = 0;
+                for (oogl::ITrackableObject * object : tracker) { live += object != nullptr; }
+                s_sink = live;
+            });
+
+            std::printf("%-9zu %-9s %12.2f %12.2f %12.2f\n", count, "slotmap", track / count,
+                        churn / count, walk / count);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,230 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     AudioMixer.hpp
+///! \brief    This file contains the declaration of the class oogl::AudioMixer and its features.
+///!           The class oogl::AudioMixer is the mixing engine of the audio subsystem : it sums the
+///!           playing voices by blocks, through vectorized kernels, into a ring buffer drained by
+///!           the audio output.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                // Non standard include guard
+
+#ifndef OOGL_AUDIOMIXER_HPP_INCLUDED        // Standard include guard
+#define OOGL_AUDIOMIXER_HPP_INCLUDED
+
+
+// Standard include list
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Project include list
+#include "AudioRingBuffer.hpp"
+#include "Blitter.hpp"
+#include "IAudioSink.hpp"
+#include "SlotMap.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl AudioMixer.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    // Forward classes declaration
+    class WorkerPool;
+
+
+    // Handle of a playing voice : it gets stale once the voice is stopped or has ended.
+    typedef oogl::SlotHandle VoiceHandle;
+
+
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    AudioMixer AudioMixer.hpp
+    ///! \brief    Block-based stereo mixer. A voice plays a mono sample buffer, owned by the
+    ///!           caller, with a gain and a constant power pan. Each block, every voice gets
+    ///!           accumulated into planar left and right buffers by a kernel chosen for the
+    ///!           instruction sets of the processor ; the block is then interleaved into a
+    ///!           single-producer single-consumer ring. The mixing thread controls the voices
+    ///!           and calls <code>render()</code> ; the output thread calls <code>pull()</code>,
+    ///!           or <code>drain()</code> to feed a sink, without ever waiting for the mixer.
+    ///! \version  1.0.0
+    ///! \see      oogl::IAudioSink
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class AudioMixer
+    {
+        public:
+
+        static constexpr unsigned int DEFAULT_SAMPLE_RATE = 48000;    ///!< Frames per second.
+        static constexpr std::size_t  BLOCK_FRAMES        = 256;      ///!< Frames mixed at once.
+        static constexpr std::size_t  DEFAULT_RING_FRAMES = 4096;     ///!< Frames of latency.
+        static constexpr std::size_t  SLICE_VOICES        = 128;      ///!< Voices per mixing task.
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief               Class constructor. The kernels of the best supported instruction
+        ///!                      set are selected.
+        ///! \param sampleRate    Frames per second.
+        ///! \param ringFrames    Frames the ring holds between the mixer and the output.
+        ///! \version             1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        explicit AudioMixer(unsigned int sampleRate = DEFAULT_SAMPLE_RATE,
+                            std::size_t ringFrames = DEFAULT_RING_FRAMES);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief             Start playing a mono sample buffer.
+        ///! \param samples     Samples, in [-1, 1] ; they must outlive the voice.
+        ///! \param length      Number of samples.
+        ///! \param gain        Linear gain.
+        ///! \param pan         Position, from -1 (left) to 1 (right).
+        ///! \param loop        Whether the voice restarts once the end is reached.
+        ///! \return            The handle of the voice.
+        ///! \version           1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        oogl::VoiceHandle play(float const * samples, std::size_t length, float gain = 1.f,
+                               float pan = 0.f, bool loop = false);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Stop a voice.
+        ///! \param voice      Handle of the voice.
+        ///! \return           true if the voice got stopped, false if the handle was stale.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        bool stop(oogl::VoiceHandle voice);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Change the gain and the pan of a voice.
+        ///! \param voice      Handle of the voice.
+        ///! \param gain       Linear gain.
+        ///! \param pan        Position, from -1 (left) to 1 (right).
+        ///! \return           true if the voice got changed, false if the handle was stale.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        bool setVoice(oogl::VoiceHandle voice, float gain, float pan) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                Mix blocks into the ring, while there is room for them.
+        ///! \param frameCount     Maximum number of frames to mix, rounded up to whole blocks.
+        ///! \return               The number of mixed frames.
+        ///! \version              1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        std::size_t render(std::size_t frameCount);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                Output callback : take mixed frames from the ring. Missing
+        ///!                       frames are filled with silence and counted as an underrun.
+        ///! \param output         Array receiving the interleaved stereo samples.
+        ///! \param frameCount     Number of frames to output.
+        ///! \version              1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void pull(float * output, std::size_t frameCount) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Output callback of the headless sinks : pull frames and
+        ///!                               write them to a sink, block by block.
+        ///! \param sink                   Sink receiving the frames.
+        ///! \param frameCount             Number of frames to output.
+        ///! \throw oogl::OOGLException    When the sink fails.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void drain(oogl::IAudioSink & sink, std::size_t frameCount);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Select the mixing kernel of an instruction set level, capped by the
+        ///!                   level the processor supports.
+        ///! \param level      Wanted level.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void setIsaLevel(oogl::IsaLevel level) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Set the pool the blocks of many voices get mixed on : the voices are
+        ///!                   split into slices of SLICE_VOICES, each mixed into its own buffers,
+        ///!                   and the slices are summed once done.
+        ///! \param pool       Worker pool, or nullptr to mix on the rendering thread.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline void setWorkerPool(oogl::WorkerPool * pool) noexcept     { m_workerPool = pool; }
+
+        // Getters
+        inline oogl::IsaLevel getIsaLevel() const noexcept      { return m_isaLevel; }
+        inline unsigned int getSampleRate() const noexcept      { return m_sampleRate; }
+        inline std::size_t getVoiceCount() const noexcept       { return m_voices.size(); }
+        inline uint64_t getUnderrunCount() const noexcept
+        { return m_underrunCount.load(std::memory_order_relaxed); }
+
+        // The ring is shared with the output : no copy
+        AudioMixer(AudioMixer const &) = delete;
+        AudioMixer & operator=(AudioMixer const &) = delete;
+
+
+
+        private:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Playing voice.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct Voice
+        {
+            float const *        samples;      ///!< Mono samples.
+            std::size_t          length;       ///!< Number of samples.
+            std::size_t          position;     ///!< Next sample to mix.
+            float                leftGain;     ///!< Gain of the left channel, pan included.
+            float                rightGain;    ///!< Gain of the right channel, pan included.
+            bool                 loop;         ///!< Restart at the end.
+            oogl::VoiceHandle    handle;       ///!< Handle of the voice, to erase it once ended.
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Buffers of a slice of voices mixed by a task of the worker pool.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct Slice
+        {
+            std::vector<float>                left;     ///!< Left channel of the slice.
+            std::vector<float>                right;    ///!< Right channel of the slice.
+            std::vector<oogl::VoiceHandle>    ended;    ///!< Voices of the slice which ended.
+        };
+
+        // Kernel accumulating count weighted samples into the left and right buffers.
+        typedef void (*MixKernel)(float * left, float * right, float const * samples,
+                                  std::size_t count, float leftGain, float rightGain);
+
+        // Mix one block into the ring.
+        void mixBlock();
+
+        // Accumulate a range of voices into planar buffers, listing the voices which ended.
+        void mixVoices(Voice * first, Voice * last, float * left, float * right,
+                       std::vector<oogl::VoiceHandle> & ended) const;
+
+
+        unsigned int                   m_sampleRate;       ///!< Frames per second.
+        oogl::SlotMap<Voice>           m_voices;           ///!< Playing voices.
+        std::vector<oogl::VoiceHandle> m_ended;            ///!< Voices ended by the block.
+        std::vector<float>             m_left;             ///!< Left channel of the block.
+        std::vector<float>             m_right;            ///!< Right channel of the block.
+        std::vector<float>             m_interleaved;      ///!< Block as stereo frames.
+        std::vector<Slice>             m_slices;           ///!< Buffers of the mixing tasks.
+        oogl::AudioRingBuffer          m_ring;             ///!< Frames waiting for the output.
+        std::atomic<uint64_t>          m_underrunCount;    ///!< Frames the output missed.
+        MixKernel                      m_kernel;           ///!< Mixing kernel in use.
+        oogl::IsaLevel                 m_isaLevel;         ///!< Level of the mixing kernel.
+        oogl::WorkerPool *             m_workerPool;       ///!< Pool mixing the slices.
+
+    };
+
+}
+
+
+
+#endif    // OOGL_AUDIOMIXER_HPP_INCLUDED
@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     AudioRingBuffer.hpp
+///! \brief    This file contains the declaration of the class oogl::AudioRingBuffer and its
+///!           features. The class oogl::AudioRingBuffer is the lock-free single-producer
+///!           single-consumer queue of samples between the audio mixer and the audio output.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                     // Non standard include guard
+
+#ifndef OOGL_AUDIORINGBUFFER_HPP_INCLUDED        // Standard include guard
+#define OOGL_AUDIORINGBUFFER_HPP_INCLUDED
+
+
+// Standard include list
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl AudioRingBuffer.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    AudioRingBuffer AudioRingBuffer.hpp
+    ///! \brief    Ring of samples written by one thread and read by another one, without lock.
+    ///!           Each side owns its position and only reads the position of the other side, so
+    ///!           that a real-time audio callback never waits for the producer.
+    ///! \version  1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class AudioRingBuffer
+    {
+        public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief             Class constructor.
+        ///! \param capacity    Maximum number of samples held, rounded up to a power of two.
+        ///! \version           1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        explicit AudioRingBuffer(std::size_t capacity);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Write samples, as many as there is room for. Producer side only.
+        ///! \param samples    Samples to write.
+        ///! \param count      Number of samples.
+        ///! \return           The number of written samples.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        std::size_t write(float const * samples, std::size_t count) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Read samples, as many as are available. Consumer side only.
+        ///! \param samples    Array receiving the samples.
+        ///! \param count      Size of the array.
+        ///! \return           The number of read samples.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        std::size_t read(float * samples, std::size_t count) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the number of samples which can be written.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        std::size_t getWritableCount() const noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the number of samples which can be read.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        std::size_t getReadableCount() const noexcept;
+
+        // Getter
+        inline std::size_t getCapacity() const noexcept    { return m_mask + 1; }
+
+        // The sides share the samples : no copy
+        AudioRingBuffer(AudioRingBuffer const &) = delete;
+        AudioRingBuffer & operator=(AudioRingBuffer const &) = delete;
+
+
+
+        private:
+
+        static constexpr std::size_t CACHE_LINE = 64;    ///!< Size of a cache line, in bytes.
+
+
+        std::unique_ptr<float[]>    m_samples;    ///!< Ring of samples.
+        std::size_t                 m_mask;       ///!< Capacity minus one, to wrap the positions.
+
+        alignas(CACHE_LINE) std::atomic<std::size_t>    m_writePosition;    ///!< Samples written.
+        alignas(CACHE_LINE) std::atomic<std::size_t>    m_readPosition;     ///!< Samples read.
+
+    };
+
+}
+
+
+
+#endif    // OOGL_AUDIORINGBUFFER_HPP_INCLUDED
@@ -0,0 +1,196 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     Blitter.hpp
+///! \brief    This file contains the declaration of the class oogl::Blitter and its features.
+///!           The class oogl::Blitter copies, stretches and blends pixels between framebuffers,
+///!           through kernels chosen at run time for the instruction sets the processor supports.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                             // Non standard include guard
+
+#ifndef OOGL_BLITTER_HPP_INCLUDED        // Standard include guard
+#define OOGL_BLITTER_HPP_INCLUDED
+
+
+// Standard include list
+#include <cstddef>
+#include <cstdint>
+
+// Project include list
+#include "DamageRegion.hpp"
+#include "Framebuffer.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl Blitter.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \enum     BlendMode Blitter.hpp
+    ///! \brief    Lists the Porter-Duff compositing operators, the source being drawn over the
+    ///!           destination. Pixels are expected with premultiplied alpha.
+    ///! \version  1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    enum class BlendMode
+    {
+        CLEAR,        ///!< Neither the source nor the destination is kept.
+        SOURCE,       ///!< Only the source is kept.
+        DESTINATION,  ///!< Only the destination is kept.
+        SOURCE_OVER,  ///!< Source over the destination.
+        DEST_OVER,    ///!< Destination over the source.
+        SOURCE_IN,    ///!< Source where the destination is.
+        DEST_IN,      ///!< Destination where the source is.
+        SOURCE_OUT,   ///!< Source where the destination is not.
+        DEST_OUT,     ///!< Destination where the source is not.
+        SOURCE_ATOP,  ///!< Source over the destination, where the destination is.
+        DEST_ATOP,    ///!< Destination over the source, where the source is.
+        XOR           ///!< Source where the destination is not, and the opposite.
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \enum     IsaLevel Blitter.hpp
+    ///! \brief    Lists the instruction set levels the blitter kernels are written for.
+    ///! \version  1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    enum class IsaLevel
+    {
+        SCALAR,       ///!< Portable C++ kernels.
+        SSE2,         ///!< 128 bits kernels.
+        AVX2,         ///!< 256 bits kernels.
+        AVX512        ///!< 512 bits kernels, requiring AVX-512 F and BW.
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    Blitter Blitter.hpp
+    ///! \brief    Static class gathering the pixel transfer operations. Each operation works on
+    ///!           spans through a kernel taken from a table ; the table is filled by
+    ///!           <code>Blitter::selectKernels()</code>, which the graphic library handler calls
+    ///!           at its initialization with the best level the processor supports. Until then,
+    ///!           the scalar kernels are used.
+    ///! \version  1.0.0
+    ///! \see      oogl::OOGLHandler::init
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class Blitter
+    {
+        public:
+
+        // Static class : no instances
+        Blitter() = delete;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the best instruction set level the processor supports.
+        ///! \return   The instruction set level, SCALAR on non x86 processors.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        static IsaLevel detectIsaLevel() noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief          Use the kernels of the given level. A level the processor does not
+        ///!                 support is lowered to the best supported one.
+        ///! \param level    Instruction set level of the kernels to use.
+        ///! \version        1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        static void selectKernels(IsaLevel level) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the instruction set level of the kernels in use.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        static IsaLevel getIsaLevel() noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                 Copy a rectangle of the source into the destination. The
+        ///!                        rectangle is clipped to both framebuffers.
+        ///! \param destination     Framebuffer the pixels get copied into.
+        ///! \param x               Abscissa of the copy in the destination.
+        ///! \param y               Ordinate of the copy in the destination.
+        ///! \param source          Framebuffer the pixels get copied from.
+        ///! \param area            Rectangle of the source to copy.
+        ///! \version               1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        static void blit(oogl::Framebuffer & destination, unsigned int x, unsigned int y,
+                         oogl::Framebuffer const & source, oogl::Rectangle const & area) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                 Copy a rectangle of the source into a rectangle of the
+        ///!                        destination, scaling it with the nearest neighbour filter.
+        ///!                        The destination rectangle is clipped to the destination.
+        ///! \param destination     Framebuffer the pixels get copied into.
+        ///! \param target          Rectangle of the destination to fill.
+        ///! \param source          Framebuffer the pixels get copied from.
+        ///! \param area            Rectangle of the source to copy, within the source.
+        ///! \version               1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        static void stretchBlit(oogl::Framebuffer & destination, oogl::Rectangle const & target,
+                                oogl::Framebuffer const & source,
+                                oogl::Rectangle const & area) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                 Blend a rectangle of the source into the destination. The
+        ///!                        rectangle is clipped to both framebuffers.
+        ///! \param destination     Framebuffer the pixels get blended into.
+        ///! \param x               Abscissa of the blending in the destination.
+        ///! \param y               Ordinate of the blending in the destination.
+        ///! \param source          Framebuffer the pixels get blended from.
+        ///! \param area            Rectangle of the source to blend.
+        ///! \param mode            Porter-Duff operator.
+        ///! \version               1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        static void blend(oogl::Framebuffer & destination, unsigned int x, unsigned int y,
+                          oogl::Framebuffer const & source, oogl::Rectangle const & area,
+                          BlendMode mode) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                 Copy a span of pixels.
+        ///! \param destination     First pixel to write.
+        ///! \param source          First pixel to read.
+        ///! \param length          Number of pixels.
+        ///! \version               1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        static void copySpan(uint32_t * destination, uint32_t const * source,
+                             std::size_t length) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                 Fill a span of pixels with the nearest source pixels : the
+        ///!                        pixel i reads the source pixel (start + i * step) >> 16.
+        ///! \param destination     First pixel to write.
+        ///! \param source          First pixel of the source row.
+        ///! \param length          Number of pixels to write.
+        ///! \param start           Position of the first pixel read, in 16.16 fixed point.
+        ///! \param step            Distance between two pixels read, in 16.16 fixed point.
+        ///! \version               1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        static void stretchSpan(uint32_t * destination, uint32_t const * source,
+                                std::size_t length, uint32_t start, uint32_t step) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                 Blend a span of pixels.
+        ///! \param destination     First pixel to blend into.
+        ///! \param source          First pixel to blend.
+        ///! \param length          Number of pixels.
+        ///! \param mode            Porter-Duff operator.
+        ///! \version               1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        static void blendSpan(uint32_t * destination, uint32_t const * source,
+                              std::size_t length, BlendMode mode) noexcept;
+
+    };
+
+}
+
+
+
+#endif    // OOGL_BLITTER_HPP_INCLUDED
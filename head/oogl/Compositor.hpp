@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     Compositor.hpp
+///! \brief    This file contains the declaration of the class oogl::Compositor and its features.
+///!           The class oogl::Compositor composes a window tree into a target framebuffer : the
+///!           content of the visible windows gets blended over the content of the root.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                // Non standard include guard
+
+#ifndef OOGL_COMPOSITOR_HPP_INCLUDED        // Standard include guard
+#define OOGL_COMPOSITOR_HPP_INCLUDED
+
+
+// Standard include list
+#include <unordered_map>
+#include <vector>
+
+// Project include list
+#include "DamageRegion.hpp"
+#include "Framebuffer.hpp"
+#include "Window.hpp"
+#include "WorkerPool.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl Compositor.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    Compositor Compositor.hpp
+    ///! \brief    Window tree compositor. The content of the root gets copied into a target
+    ///!           framebuffer, then the content of its visible descendants gets blended over it
+    ///!           with the SOURCE_OVER operator, pixels being premultiplied : each window is drawn
+    ///!           after its parent, the children from the bottom to the top of the stack, which is
+    ///!           the order of <code>Window::getChildren()</code>. The HIDDEN and MINIMIZED windows
+    ///!           are left out with their whole subtree, and each window is clipped to its
+    ///!           ancestors. The windows themselves are never written.
+    ///!           Only the damaged region of the target gets drawn again : the rectangles drawn in
+    ///!           the windows since the previous composition, and the areas the windows left or
+    ///!           entered by moving, resizing, showing, hiding or changing their place in the
+    ///!           stack. The parts of a window covered by an OPAQUE window drawn after it are
+    ///!           skipped. The damaged rows are split into bands composed by the worker pool.
+    ///! \version  1.0.0
+    ///! \see      oogl::Window
+    ///! \see      oogl::WorkerPool
+    ///!
+    ///! <p>A compositor keeps the placement of the windows it composed, to find the damage of the
+    ///! next composition : it must compose a given tree into a given target, which keeps its
+    ///! pixels between the compositions.</p>
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class Compositor
+    {
+        public:
+
+        static constexpr unsigned int BAND_HEIGHT = 64;    ///!< Rows composed by one task.
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief         Class constructor.
+        ///! \param pool    Workers the bands get composed on.
+        ///! \version       1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        explicit Compositor(oogl::WorkerPool & pool) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Compose the damaged region of a tree into a target. The
+        ///!                               damage of the composed windows is consumed.
+        ///! \param root                   Root of the window tree.
+        ///! \param target                 Framebuffer receiving the composition ; it gets sized
+        ///!                               as the root, and fully composed, when it is not yet.
+        ///! \return                       The region of the target composed, to be presented.
+        ///! \throw oogl::OOGLException    When the target cannot be allocated.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        oogl::DamageRegion const & compose(oogl::Window & root, oogl::Framebuffer & target);
+
+        // Getter
+        inline oogl::DamageRegion const & getDamage() const noexcept    { return m_damage; }
+
+
+
+        private:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Placement of a window in the target, compared from one composition to the
+        ///!         next one.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct Placement
+        {
+            unsigned int            x;        ///!< Abscissa of the window in the target.
+            unsigned int            y;        ///!< Ordinate of the window in the target.
+            oogl::Rectangle         clip;     ///!< Area of the target the window is drawn in.
+            oogl::Window const *    below;    ///!< Window drawn just before, nullptr for the root.
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Entry of the draw list : a window, its placement, and the rectangles of the
+        ///!         target it is visible in.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct DrawCall
+        {
+            oogl::Window *                  window;
+            Placement                       placement;
+            std::vector<oogl::Rectangle>    visible;
+        };
+
+        // Append a window and its visible descendants to the draw list, in drawing order.
+        void collect(oogl::Window & window, unsigned int x, unsigned int y,
+                     oogl::Rectangle const & bounds);
+
+        // Add the damage of the draw list to the region, and keep the placements for the next
+        // composition.
+        void collectDamage();
+
+        // Compute the visible rectangles of the draw calls touching the damage.
+        void cull();
+
+        // Compose the damage within a band of rows.
+        void composeBand(oogl::Framebuffer & target, unsigned int top,
+                         unsigned int bottom) const noexcept;
+
+
+        oogl::WorkerPool &                                          m_pool;          ///!< Workers.
+        oogl::DamageRegion                                          m_damage;        ///!< Composed.
+        std::vector<DrawCall>                                       m_drawList;      ///!< Windows.
+        std::unordered_map<oogl::Window const *, Placement>         m_placements;    ///!< Previous.
+        oogl::Framebuffer const *                                   m_target;        ///!< Previous.
+        oogl::Window const *                                        m_root;          ///!< Previous.
+
+    };
+
+}
+
+
+
+#endif    // OOGL_COMPOSITOR_HPP_INCLUDED
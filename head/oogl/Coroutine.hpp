@@ -0,0 +1,500 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     Coroutine.hpp
+///! \brief    This file contains the declaration of the class oogl::Task and of the awaitables of
+///!           the framework : the coroutines of the main loop wait for an event, a delay or the
+///!           load of a file with <code>co_await</code>, instead of chaining callbacks or blocking
+///!           a thread, and get resumed by the scheduler of their handler.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///!
+///! <p>The features of this file need the coroutines of C++20 : they are only declared when
+///! OOGL_HAS_COROUTINES is defined. The rest of the framework does not depend on them.</p>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                               // Non standard include guard
+
+#ifndef OOGL_COROUTINE_HPP_INCLUDED        // Standard include guard
+#define OOGL_COROUTINE_HPP_INCLUDED
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \brief    OOGL_HAS_COROUTINES is defined when the compiler and the standard library support
+///!           the coroutines of C++20.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define OOGL_HAS_COROUTINES
+#endif
+#endif
+
+
+
+#if defined(OOGL_HAS_COROUTINES)
+
+
+// Standard include list
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Project include list
+#include "Event.hpp"
+#include "OOGLHandler.hpp"
+#include "OOGLHandlerFactory.hpp"
+#include "Result.hpp"
+#include "Scheduler.hpp"
+#include "TimerWheel.hpp"
+#include "WorkerPool.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl Coroutine.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    // Scheduler of the handler the calling thread works for.
+    inline oogl::Scheduler & getCurrentScheduler()
+    {
+        return oogl::OOGLHandlerFactory().getGraphicLibraryHandler().getScheduler();
+    }
+
+    // Continuation resuming a suspended coroutine.
+    inline oogl::Continuation getContinuation(std::coroutine_handle<> coroutine) noexcept
+    {
+        return oogl::Continuation {
+            [] (void * address) { std::coroutine_handle<>::from_address(address).resume(); },
+            coroutine.address()
+        };
+    }
+
+
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    Task Coroutine.hpp
+    ///! \brief    Coroutine of the main loop, started when awaited or spawned. Awaiting a task
+    ///!           suspends the awaiting coroutine until the task is done, then resumes it right
+    ///!           away, throwing the exception which ended the task, if any. A spawned task runs
+    ///!           on its own, from the next run of the scheduler, and its frame gets released once
+    ///!           it is done.
+    ///!           The frames are allocated from the pool of the scheduler of the handler, so that
+    ///!           suspending and resuming a task allocates nothing.
+    ///! \version  1.0.0
+    ///! \see      oogl::Scheduler
+    ///!
+    ///! <p>A task must only be created, awaited and destroyed on the thread of the main loop, and
+    ///! must not be destroyed while suspended.</p>
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class Task
+    {
+        public:
+
+        struct promise_type;
+
+        // Handle of the coroutine of a task
+        typedef std::coroutine_handle<promise_type> Handle;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Last suspension of a task : the awaiting coroutine gets resumed, or the frame
+        ///!         of a spawned task released.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct FinalAwaiter
+        {
+            inline bool await_ready() const noexcept    { return false; }
+            std::coroutine_handle<> await_suspend(Handle coroutine) noexcept;
+            inline void await_resume() const noexcept   {}
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  State of a task, in its frame.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct promise_type
+        {
+            std::coroutine_handle<>    continuation;    ///!< Coroutine awaiting the task.
+            std::exception_ptr         failure;         ///!< Exception which ended the task.
+            oogl::Scheduler *          spawner;         ///!< Scheduler of a spawned task.
+
+            inline promise_type() noexcept :
+            continuation(), failure(), spawner(nullptr)
+            {}
+
+            inline Task get_return_object() noexcept
+            { return Task(Handle::from_promise(*this)); }
+
+            inline std::suspend_always initial_suspend() const noexcept    { return {}; }
+            inline FinalAwaiter final_suspend() const noexcept             { return {}; }
+            inline void return_void() const noexcept                       {}
+            void unhandled_exception() noexcept;
+
+            // The frames come from the pool of the scheduler
+            inline static void * operator new(std::size_t size)
+            { return oogl::getCurrentScheduler().allocateFrame(size); }
+
+            inline static void operator delete(void * frame, std::size_t size) noexcept
+            { oogl::Scheduler::releaseFrame(frame, size); }
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief              Move constructor.
+        ///! \param instance     Task moved into the new one, which is left empty.
+        ///! \version            1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline Task(Task && instance) noexcept :
+        m_coroutine(std::exchange(instance.m_coroutine, nullptr))
+        {}
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class destructor : the frame of the task is released.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline ~Task() noexcept
+        {
+            if (m_coroutine) { m_coroutine.destroy(); }
+        }
+
+        // The frame belongs to one task : no copy
+        Task(Task const &) = delete;
+        Task & operator=(Task const &) = delete;
+        Task & operator=(Task &&) = delete;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Tell whether the task is done, or empty.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline bool isDone() const noexcept    { return ! m_coroutine || m_coroutine.done(); }
+
+        // Awaiting a task runs it until it is done, then resumes the awaiting coroutine
+        inline bool await_ready() const noexcept    { return isDone(); }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept;
+        void await_resume() const;
+
+
+
+        private:
+
+        // Class constructor of the task of a coroutine.
+        inline explicit Task(Handle coroutine) noexcept :
+        m_coroutine(coroutine)
+        {}
+
+        // Spawning releases the coroutine from the task
+        friend void spawn(oogl::Task task);
+
+
+        Handle    m_coroutine;    ///!< Coroutine of the task, empty once moved or spawned.
+
+    };
+
+
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    EventAwaiter Coroutine.hpp
+    ///! \brief    Awaitable of the next event of a window : the coroutine is resumed by the run
+    ///!           following the dispatch of the event, and <code>co_await</code> gives the event.
+    ///! \version  1.0.0
+    ///! \see      oogl::nextEvent
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class EventAwaiter
+    {
+        public:
+
+        // Class constructor : wait for an event of a window, any window with 0.
+        inline explicit EventAwaiter(uint32_t window) :
+        m_scheduler(oogl::getCurrentScheduler()), m_window(window), m_event()
+        {}
+
+        inline bool await_ready() const noexcept    { return false; }
+
+        inline void await_suspend(std::coroutine_handle<> coroutine)
+        { m_scheduler.waitEvent(m_window, &m_event, oogl::getContinuation(coroutine)); }
+
+        inline oogl::Event await_resume() const noexcept    { return m_event; }
+
+
+
+        private:
+
+        oogl::Scheduler &    m_scheduler;    ///!< Scheduler the event gets dispatched to.
+        uint32_t             m_window;       ///!< Window of the event, 0 for any.
+        oogl::Event          m_event;        ///!< Event received.
+
+    };
+
+
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    SleepAwaiter Coroutine.hpp
+    ///! \brief    Awaitable of a delay : a timer of the timer subsystem posts the coroutine to the
+    ///!           scheduler when it fires, so that the delay is as precise as the updates of the
+    ///!           timer wheel.
+    ///! \version  1.0.0
+    ///! \see      oogl::sleepFor
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class SleepAwaiter
+    {
+        public:
+
+        // Class constructor : wait for a delay, in nanoseconds.
+        inline explicit SleepAwaiter(uint64_t delay) :
+        m_scheduler(oogl::getCurrentScheduler()),
+        m_timers(oogl::OOGLHandlerFactory().getGraphicLibraryHandler().getTimerWheel()),
+        m_delay(delay), m_coroutine()
+        {}
+
+        inline bool await_ready() const noexcept    { return m_delay == 0; }
+
+        inline void await_suspend(std::coroutine_handle<> coroutine)
+        {
+            m_coroutine = coroutine;
+            m_timers.schedule(m_delay, &SleepAwaiter::wake,
+                              static_cast<uint64_t>(reinterpret_cast<uintptr_t>(this)));
+        }
+
+        inline void await_resume() const noexcept    {}
+
+
+
+        private:
+
+        // Timer callback : post the coroutine, from the thread updating the timers.
+        static inline void wake(oogl::TimerHandle, uint64_t data)
+        {
+            SleepAwaiter * const awaiter = reinterpret_cast<SleepAwaiter *>(
+                static_cast<uintptr_t>(data));
+            awaiter->m_scheduler.post(oogl::getContinuation(awaiter->m_coroutine));
+        }
+
+
+        oogl::Scheduler &          m_scheduler;    ///!< Scheduler resuming the coroutine.
+        oogl::TimerWheel &         m_timers;       ///!< Timers of the handler.
+        uint64_t                   m_delay;        ///!< Delay, in nanoseconds.
+        std::coroutine_handle<>    m_coroutine;    ///!< Coroutine waiting for the delay.
+
+    };
+
+
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    LoadAwaiter Coroutine.hpp
+    ///! \brief    Awaitable of the content of a file : a task of the worker pool reads the file,
+    ///!           then posts the coroutine to the scheduler, and <code>co_await</code> gives the
+    ///!           bytes, or RESOURCE_LOAD_FAILED when the file cannot be read.
+    ///! \version  1.0.0
+    ///! \see      oogl::loadAsync
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class LoadAwaiter
+    {
+        public:
+
+        // Class constructor : load a file.
+        inline explicit LoadAwaiter(std::string path) :
+        m_scheduler(oogl::getCurrentScheduler()), m_path(std::move(path)),
+        m_result(oogl::ExceptionCode::RESOURCE_LOAD_FAILED), m_coroutine(),
+        m_group(oogl::OOGLHandlerFactory().getGraphicLibraryHandler().getWorkerPool())
+        {}
+
+        inline bool await_ready() const noexcept    { return false; }
+
+        inline void await_suspend(std::coroutine_handle<> coroutine)
+        {
+            m_coroutine = coroutine;
+            m_group.run([this] () {
+                m_result = read(m_path);
+                m_scheduler.post(oogl::getContinuation(m_coroutine));
+            });
+        }
+
+        inline oogl::Result<std::vector<char>> await_resume()    { return std::move(m_result); }
+
+
+
+        private:
+
+        // Read a whole file.
+        static oogl::Result<std::vector<char>> read(std::string const & path);
+
+
+        oogl::Scheduler &                   m_scheduler;    ///!< Scheduler resuming the coroutine.
+        std::string                         m_path;         ///!< Path of the file.
+        oogl::Result<std::vector<char>>     m_result;       ///!< Content of the file, or error.
+        std::coroutine_handle<>             m_coroutine;    ///!< Coroutine waiting for the file.
+        oogl::TaskGroup                     m_group;        ///!< Reading task, waited for when the
+                                                            ///!< awaiter gets destroyed.
+
+    };
+
+
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \brief            Spawn a task : it starts on the next run of the scheduler of the
+    ///!                   handler, and its exception, if any, is thrown by the run it ends in.
+    ///! \param task       Task to spawn, left empty.
+    ///! \version          1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void spawn(oogl::Task task);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \brief            Wait for the next event of a window.
+    ///! \param window     Identifier of the window, 0 for the next event of any window.
+    ///! \return           The awaitable, giving the event.
+    ///! \version          1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    inline oogl::EventAwaiter nextEvent(uint32_t window = 0)
+    {
+        return oogl::EventAwaiter(window);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \brief                        Wait for a delay, through the timer subsystem.
+    ///! \param duration               Delay, rounded up to a tick of the timer wheel.
+    ///! \return                       The awaitable.
+    ///! \throw oogl::OOGLException    When the timer subsystem has not been initialized.
+    ///! \version                      1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename Rep, typename Period>
+    inline oogl::SleepAwaiter sleepFor(std::chrono::duration<Rep, Period> duration)
+    {
+        return oogl::SleepAwaiter(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \brief            Load the content of a file on the worker pool.
+    ///! \param path       Path of the file.
+    ///! \return           The awaitable, giving the bytes of the file, or the error.
+    ///! \version          1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    inline oogl::LoadAwaiter loadAsync(std::string path)
+    {
+        return oogl::LoadAwaiter(std::move(path));
+    }
+
+}
+
+
+
+//==================================================================================================
+// End of a task : symmetric transfer to the awaiting coroutine, so that a chain of tasks does not
+// grow the stack. A spawned task hands its exception to the scheduler and releases its frame.
+//==================================================================================================
+inline std::coroutine_handle<> oogl::Task::FinalAwaiter::await_suspend(Handle coroutine) noexcept
+{
+    promise_type & promise = coroutine.promise();
+
+    if (promise.continuation) {
+        return promise.continuation;
+    }
+
+    if (promise.spawner != nullptr) {
+        if (promise.failure) {
+            promise.spawner->fail(promise.failure);
+        }
+
+        coroutine.destroy();
+    }
+
+    return std::noop_coroutine();
+}
+
+
+//==================================================================================================
+// Keep the exception ending a task, for its awaiting coroutine or its scheduler.
+//==================================================================================================
+inline void oogl::Task::promise_type::unhandled_exception() noexcept
+{
+#if defined(OOGL_NO_EXCEPTIONS)
+    std::terminate();
+#else
+    failure = std::current_exception();
+#endif
+}
+
+
+//==================================================================================================
+// Start the task, resuming the awaiting coroutine once it is done.
+//==================================================================================================
+inline std::coroutine_handle<> oogl::Task::await_suspend(std::coroutine_handle<> awaiting) noexcept
+{
+    m_coroutine.promise().continuation = awaiting;
+    return m_coroutine;
+}
+
+
+//==================================================================================================
+// Throw the exception which ended the task, if any.
+//==================================================================================================
+inline void oogl::Task::await_resume() const
+{
+#if ! defined(OOGL_NO_EXCEPTIONS)
+    if (m_coroutine && m_coroutine.promise().failure) {
+        std::rethrow_exception(m_coroutine.promise().failure);
+    }
+#endif
+}
+
+
+//==================================================================================================
+// Spawn a task : the scheduler takes its coroutine.
+//==================================================================================================
+inline void oogl::spawn(oogl::Task task)
+{
+    if (task.isDone()) {    // nothing to run
+        return;
+    }
+
+    oogl::Scheduler &  scheduler = oogl::getCurrentScheduler();
+    oogl::Task::Handle coroutine = std::exchange(task.m_coroutine, nullptr);
+
+    coroutine.promise().spawner = &scheduler;
+    scheduler.post(oogl::getContinuation(coroutine));
+}
+
+
+//==================================================================================================
+// Read a file whole, on a worker.
+//==================================================================================================
+inline oogl::Result<std::vector<char>> oogl::LoadAwaiter::read(std::string const & path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+    if (! file) {    // the file cannot be opened
+        return oogl::ExceptionCode::RESOURCE_LOAD_FAILED;
+    }
+
+    std::vector<char> content(static_cast<std::size_t>(file.tellg()));
+
+    file.seekg(0);
+    file.read(content.data(), static_cast<std::streamsize>(content.size()));
+
+    if (! file) {    // the file cannot be read whole
+        return oogl::ExceptionCode::RESOURCE_LOAD_FAILED;
+    }
+
+    return content;
+}
+
+
+
+#endif    // OOGL_HAS_COROUTINES
+
+#endif    // OOGL_COROUTINE_HPP_INCLUDED
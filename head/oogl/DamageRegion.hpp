@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     DamageRegion.hpp
+///! \brief    This file contains the declaration of the class oogl::DamageRegion and its features.
+///!           The class oogl::DamageRegion accumulates the rectangles of a surface that have been
+///!           drawn since its last presentation, so that only those get presented.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                  // Non standard include guard
+
+#ifndef OOGL_DAMAGEREGION_HPP_INCLUDED        // Standard include guard
+#define OOGL_DAMAGEREGION_HPP_INCLUDED
+
+
+// Standard include list
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl DamageRegion.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    #ifndef OOGL_RECTANGLE_STRUCT_DEFINED        // Guarantee the structure is only defined once
+    #define OOGL_RECTANGLE_STRUCT_DEFINED
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \struct   Rectangle DamageRegion.hpp
+    ///! \brief    Describe a rectangle shape through the position of its top left corner, its
+    ///!           width and its height.
+    ///! \version  1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    struct Rectangle
+    {
+        unsigned int xPosition;
+        unsigned int yPosition;
+        unsigned int width;
+        unsigned int height;
+    };
+
+    // Typedef to remove the struct keyword from the type
+    typedef struct Rectangle Rectangle;
+
+    #endif    // OOGL_RECTANGLE_STRUCT_DEFINED
+
+
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    DamageRegion DamageRegion.hpp
+    ///! \brief    Set of at most MAX_RECTANGLES rectangles covering the damaged pixels of a
+    ///!           surface. A rectangle overlapping or touching a damaged one gets merged into it
+    ///!           when their bounding box wastes few pixels ; once the limit is reached, the new
+    ///!           rectangle is merged into the one whose bounding box grows the least.
+    ///! \version  1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class DamageRegion
+    {
+        public:
+
+        static constexpr std::size_t MAX_RECTANGLES = 16;    ///!< Rectangles kept at most.
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class constructor : nothing is damaged.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        DamageRegion();
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief              Mark a rectangle as damaged. Empty rectangles are ignored.
+        ///! \param rectangle    The damaged rectangle.
+        ///! \version            1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void add(oogl::Rectangle const & rectangle);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief           Restrict the region to the given bounds, typically those of the
+        ///!                  surface after a resize.
+        ///! \param width     Width of the bounds, whose top left corner is the origin.
+        ///! \param height    Height of the bounds.
+        ///! \version         1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void clip(unsigned int width, unsigned int height) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Forget every damaged rectangle.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline void clear() noexcept                    { m_rectangles.clear(); }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Tell whether nothing is damaged.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline bool isEmpty() const noexcept            { return m_rectangles.empty(); }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the damaged rectangles ; they may overlap each other.
+        ///! \return   A constant reference to the rectangles.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline std::vector<oogl::Rectangle> const & getRectangles() const noexcept
+        {
+            return m_rectangles;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the bounding box of the damaged rectangles.
+        ///! \return   The bounding box, empty when nothing is damaged.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        oogl::Rectangle getBounds() const noexcept;
+
+
+
+        private:
+
+        std::vector<oogl::Rectangle>    m_rectangles;    ///!< The damaged rectangles.
+
+    };
+
+}
+
+
+
+#endif    // OOGL_DAMAGEREGION_HPP_INCLUDED
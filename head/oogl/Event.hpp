@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     Event.hpp
+///! \brief    This file contains the declaration of the P.O.D. structure oogl::Event and its
+///!           features. The structure oogl::Event is the fixed-size record carried by the events
+///!           subsystem, from the producers (input, timers, window state) to the main loop.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                           // Non standard include guard
+
+#ifndef OOGL_EVENT_HPP_INCLUDED        // Standard include guard
+#define OOGL_EVENT_HPP_INCLUDED
+
+
+// Standard include list
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl Event.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \enum     EventType Event.hpp
+    ///! \brief    Lists the kinds of events, each one selecting the payload of oogl::Event.
+    ///! \version  1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    enum class EventType : uint32_t
+    {
+        NONE,               ///!< Empty event.
+        QUIT,               ///!< The application is requested to stop.
+        KEY_DOWN,           ///!< A key got pressed ; payload : key.
+        KEY_UP,             ///!< A key got released ; payload : key.
+        MOUSE_MOTION,       ///!< The pointer moved ; payload : mouse.
+        MOUSE_BUTTON_DOWN,  ///!< A mouse button got pressed ; payload : mouse.
+        MOUSE_BUTTON_UP,    ///!< A mouse button got released ; payload : mouse.
+        MOUSE_WHEEL,        ///!< The wheel got scrolled ; payload : mouse.
+        WINDOW_RESIZED,     ///!< A window got resized ; payload : area.
+        WINDOW_MOVED,       ///!< A window got moved ; payload : area.
+        WINDOW_SHOWN,       ///!< A window got shown.
+        WINDOW_HIDDEN,      ///!< A window got hidden.
+        TIMER,              ///!< A timer expired ; payload : timer.
+        USER                ///!< Event defined by the application ; payload : user.
+    };
+
+
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \struct   Event Event.hpp
+    ///! \brief    Event record of 32 bytes : the type, the identifier of the window it targets,
+    ///!           its timestamp and a payload depending on the type. It is trivially copyable so
+    ///!           that the event queue moves it without allocation.
+    ///! \version  1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    struct Event
+    {
+        EventType    type;         ///!< Kind of event, selecting the payload.
+        uint32_t     window;       ///!< Identifier of the targeted window, 0 when none.
+        uint64_t     timestamp;    ///!< Time of the event, in nanoseconds of the steady clock.
+
+        union
+        {
+            struct
+            {
+                uint32_t code;          ///!< Key code.
+                uint32_t modifiers;     ///!< Modifier keys held.
+                uint32_t repeat;        ///!< Non zero when the key is held down.
+            } key;
+
+            struct
+            {
+                int32_t  x;             ///!< Pointer abscissa, or horizontal wheel scroll.
+                int32_t  y;             ///!< Pointer ordinate, or vertical wheel scroll.
+                uint32_t button;        ///!< Button involved, 0 for a motion.
+                uint32_t buttons;       ///!< Mask of the buttons held.
+            } mouse;
+
+            struct
+            {
+                int32_t  x;             ///!< New window abscissa.
+                int32_t  y;             ///!< New window ordinate.
+                uint32_t width;         ///!< New window width.
+                uint32_t height;        ///!< New window height.
+            } area;
+
+            struct
+            {
+                uint64_t id;            ///!< Identifier of the expired timer.
+                uint64_t data;          ///!< Data given when scheduling the timer.
+            } timer;
+
+            uint64_t user[2];           ///!< Data of an application event.
+        };
+    };
+
+    // Typedef to remove the struct keyword from the type
+    typedef struct Event Event;
+
+    static_assert(std::is_trivially_copyable<Event>::value, "Events must be trivially copyable.");
+    static_assert(sizeof(Event) == 32, "Events must fit in 32 bytes.");
+
+
+    // Timestamp of an event happening now, in nanoseconds of the steady clock.
+    inline uint64_t getEventTimestamp() noexcept
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+}
+
+
+
+#endif    // OOGL_EVENT_HPP_INCLUDED
@@ -0,0 +1,279 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     EventQueue.hpp
+///! \brief    This file contains the declaration of the class oogl::EventQueue and its features.
+///!           The class oogl::EventQueue is the bounded lock-free queue of the events subsystem :
+///!           any thread can push events, and the main loop drains them by batches.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                // Non standard include guard
+
+#ifndef OOGL_EVENTQUEUE_HPP_INCLUDED        // Standard include guard
+#define OOGL_EVENTQUEUE_HPP_INCLUDED
+
+
+// Standard include list
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Project include list
+#include "Event.hpp"
+#include "EventRecorder.hpp"
+#include "InputState.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl EventQueue.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    EventQueue EventQueue.hpp
+    ///! \brief    Bounded multi-producer single-consumer queue of events, without lock nor
+    ///!           allocation once built. The events go through two lanes : the bulk lane holds the
+    ///!           pointer motions and the window moves and resizes, the discrete lane holds every
+    ///!           other event. The consumer always takes the discrete events first, so that a key
+    ///!           press or a click never waits behind a flood of bulk events, and merges each run
+    ///!           of bulk events of the same type and window into the last one, which holds the
+    ///!           current state.
+    ///!           Each lane is a ring whose cells carry a sequence number telling whether they are
+    ///!           free for the producer of a given position, or hold the event the consumer
+    ///!           expects : producers only compete for the push position, and the consumer never
+    ///!           writes anything the producers compete for. When a lane is full, the pushed event
+    ///!           is dropped and counted as an overflow.
+    ///! \version  1.0.0
+    ///!
+    ///! <p>The events of a lane are handled in their order ; a discrete event can be handled
+    ///! before a bulk event pushed earlier. When a recorder is set, every popped event gets
+    ///! recorded, the bulk ones before being merged, so that replaying the log pushes the events
+    ///! the queue received. When an input state is set, every handed event gets applied to it,
+    ///! and it is published once at the end of each poll.</p>
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class EventQueue
+    {
+        public:
+
+        static constexpr std::size_t DEFAULT_CAPACITY = 1 << 16;    ///!< Default event count.
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief             Class constructor.
+        ///! \param capacity    Maximum number of events held by each lane, rounded up to a power
+        ///!                    of two.
+        ///! \version           1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        explicit EventQueue(std::size_t capacity = DEFAULT_CAPACITY);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Push an event into its lane. Can be called from any thread.
+        ///! \param event      Event to push.
+        ///! \return           true if the event got queued, false if its lane was full and the
+        ///!                   event got dropped.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        bool push(oogl::Event const & event) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Pop the queued events, the discrete ones first, up to a maximum
+        ///!                   count ; the runs of bulk events are merged. Must only be called from
+        ///!                   the consumer thread.
+        ///! \param events     Array receiving the events.
+        ///! \param maxCount   Size of the array.
+        ///! \return           The number of popped events, zero when the queue is empty.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        std::size_t poll(oogl::Event * events, std::size_t maxCount) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Pop every queued event and hand each one to a function. The discrete
+        ///!                   events are handed without copying them out of the ring, and are
+        ///!                   looked for again before each bulk event. Must only be called from
+        ///!                   the consumer thread.
+        ///! \param handler    Function called with each event.
+        ///! \return           The number of handled events.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        template <typename Handler>
+        std::size_t drain(Handler && handler);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief         Tell whether the events of a type go through the bulk lane, where the
+        ///!                consecutive ones of a window get merged.
+        ///! \param type    Type of the events.
+        ///! \return        true for the pointer motions and the window moves and resizes.
+        ///! \version       1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        static inline bool isBulk(oogl::EventType type) noexcept
+        {
+            return type == oogl::EventType::MOUSE_MOTION || type == oogl::EventType::WINDOW_MOVED
+                   || type == oogl::EventType::WINDOW_RESIZED;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the number of events dropped because their lane was full.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline uint64_t getOverflowCount() const noexcept
+        { return m_overflowCount.load(std::memory_order_relaxed); }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Reset the number of dropped events.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline void resetOverflowCount() noexcept
+        { m_overflowCount.store(0, std::memory_order_relaxed); }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the number of bulk events merged into a later one, and not handed.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline uint64_t getCoalescedCount() const noexcept
+        { return m_coalescedCount.load(std::memory_order_relaxed); }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief             Set the log recording the popped events, in the order they get
+        ///!                    popped. Must only be called from the consumer thread.
+        ///! \param recorder    Event log, or nullptr to stop recording.
+        ///! \version           1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline void setRecorder(oogl::EventRecorder * recorder) noexcept  { m_recorder = recorder; }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief             Set the input state following the handed events, published at the
+        ///!                    end of each poll. Must only be called from the consumer thread.
+        ///! \param state       Input state, or nullptr to stop following the events.
+        ///! \version           1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline void setInputState(oogl::InputState * state) noexcept    { m_inputState = state; }
+
+        // Getter
+        inline std::size_t getCapacity() const noexcept    { return m_discrete.mask + 1; }
+
+        // The cells are referenced by their sequence numbers : no copy
+        EventQueue(EventQueue const &) = delete;
+        EventQueue & operator=(EventQueue const &) = delete;
+
+
+
+        private:
+
+        static constexpr std::size_t CACHE_LINE = 64;    ///!< Size of a cache line, in bytes.
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Cell of a ring : it is free for the producer of position p when its sequence
+        ///!         is p, and holds the event of position p when its sequence is p + 1.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct Cell
+        {
+            std::atomic<std::size_t> sequence;
+            oogl::Event              event;
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Ring of cells of a lane, with its push and poll positions.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct Lane
+        {
+            explicit Lane(std::size_t capacity);
+
+            // Claim a free cell and publish the event into it ; false when the ring is full.
+            bool push(oogl::Event const & event) noexcept;
+
+            // Cell of the oldest event, nullptr when the lane is empty. Consumer only.
+            inline Cell * front() noexcept
+            {
+                Cell & cell = cells[pollPosition & mask];
+                return cell.sequence.load(std::memory_order_acquire) == pollPosition + 1
+                       ? &cell : nullptr;
+            }
+
+            // Give the cell of the oldest event back to the producers. Consumer only.
+            inline void release() noexcept
+            {
+                cells[pollPosition & mask].sequence.store(pollPosition + mask + 1,
+                                                          std::memory_order_release);
+                pollPosition++;
+            }
+
+            std::unique_ptr<Cell[]>    cells;    ///!< Ring of cells.
+            std::size_t                mask;     ///!< Capacity minus one, to wrap the positions.
+
+            alignas(CACHE_LINE) std::atomic<std::size_t>    pushPosition;    ///!< Next push.
+            alignas(CACHE_LINE) std::size_t                 pollPosition;    ///!< Next pop.
+        };
+
+        // Pop the oldest bulk event, merged with the next ones of the same type and window while
+        // no discrete event is waiting ; false when the bulk lane is empty.
+        bool popBulk(oogl::Event & event) noexcept;
+
+
+        Lane                                            m_discrete;          ///!< Discrete events.
+        Lane                                            m_bulk;              ///!< Bulk events.
+        oogl::EventRecorder *                           m_recorder;          ///!< Popped events.
+        oogl::InputState *                              m_inputState;        ///!< Handed events.
+        alignas(CACHE_LINE) std::atomic<uint64_t>       m_overflowCount;     ///!< Dropped events.
+        alignas(CACHE_LINE) std::atomic<uint64_t>       m_coalescedCount;    ///!< Merged events.
+
+    };
+
+}
+
+
+
+//==================================================================================================
+// Hand the queued events to a function : each discrete cell is given back to the producers once
+// its event has been recorded and handled, and the discrete lane is checked again before each bulk
+// event.
+//==================================================================================================
+template <typename Handler>
+std::size_t oogl::EventQueue::drain(Handler && handler)
+{
+    std::size_t count = 0;
+    oogl::Event bulk;
+
+    for (;;) {
+        Cell * const cell = m_discrete.front();
+
+        if (cell != nullptr) {
+            if (m_recorder != nullptr) {
+                m_recorder->record(cell->event);
+            }
+
+            if (m_inputState != nullptr) {
+                m_inputState->apply(cell->event);
+            }
+
+            handler(static_cast<oogl::Event const &>(cell->event));
+            m_discrete.release();
+        } else if (popBulk(bulk)) {
+            if (m_inputState != nullptr) {
+                m_inputState->apply(bulk);
+            }
+
+            handler(static_cast<oogl::Event const &>(bulk));
+        } else {    // empty
+            if (m_inputState != nullptr) {
+                m_inputState->publish();
+            }
+
+            return count;
+        }
+
+        count++;
+    }
+}
+
+
+
+#endif    // OOGL_EVENTQUEUE_HPP_INCLUDED
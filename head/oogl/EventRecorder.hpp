@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     EventRecorder.hpp
+///! \brief    This file contains the declaration of the class oogl::EventRecorder and its
+///!           features. The class oogl::EventRecorder appends the events handed by the event queue
+///!           to a compact binary log, so that a session can be replayed by oogl::EventReplayer.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                   // Non standard include guard
+
+#ifndef OOGL_EVENTRECORDER_HPP_INCLUDED        // Standard include guard
+#define OOGL_EVENTRECORDER_HPP_INCLUDED
+
+
+// Standard include list
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+
+// Project include list
+#include "Event.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl EventRecorder.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    EventRecorder EventRecorder.hpp
+    ///! \brief    Append-only binary log of events. The file starts with a header of 8 bytes, the
+    ///!           magic "OEVL" and the format version, followed by one record per event : the type
+    ///!           on a byte, the timestamp as the difference with the previous one, the window,
+    ///!           then the fields of the payload of the type, each integer as a variable-length
+    ///!           quantity of 7 bits per byte, the signed ones zigzag encoded. A pointer motion
+    ///!           takes about 12 bytes instead of the 32 of an event.
+    ///!           The records are gathered in a buffer, written when it gets full, when flushed
+    ///!           and when the log gets closed ; the log is only ever appended to, so that a
+    ///!           recording cut short remains readable up to its last complete record.
+    ///! \version  1.0.0
+    ///! \see      oogl::EventReplayer
+    ///! \see      oogl::EventQueue
+    ///!
+    ///! <p>Recording happens on the consumer thread of the queue, and cannot throw : a failure
+    ///! to write stops the recording, and is reported by the next flush.</p>
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class EventRecorder
+    {
+        public:
+
+        static constexpr uint32_t    MAGIC       = 0x4C56454F;    ///!< "OEVL", little endian.
+        static constexpr uint32_t    VERSION     = 1;             ///!< Format of the records.
+        static constexpr std::size_t HEADER_SIZE = 8;             ///!< Magic and version.
+        static constexpr std::size_t MAX_RECORD  = 64;            ///!< Largest record, in bytes.
+        static constexpr std::size_t BUFFER_SIZE = 1 << 16;       ///!< Records gathered.
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Class constructor : create the log and write its header.
+        ///! \param path                   Path of the file to create.
+        ///! \throw oogl::OOGLException    When the file cannot be created.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        explicit EventRecorder(std::string const & path);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class destructor : close the log if need be.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ~EventRecorder() noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief          Append an event to the log. Does nothing once the log is closed, or
+        ///!                 once a write failed.
+        ///! \param event    Event to record.
+        ///! \version        1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void record(oogl::Event const & event) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Write the gathered records into the file.
+        ///! \throw oogl::OOGLException    When the file cannot be written, or could not be since
+        ///!                               the last flush.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void flush();
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Write the gathered records and close the file. Does
+        ///!                               nothing when the file is already closed.
+        ///! \throw oogl::OOGLException    When the file cannot be written.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void close();
+
+        // Getters
+        inline uint64_t getEventCount() const noexcept    { return m_eventCount; }
+        inline uint64_t getByteCount() const noexcept     { return m_byteCount; }
+
+        // The file belongs to one recorder : no copy
+        EventRecorder(EventRecorder const &) = delete;
+        EventRecorder & operator=(EventRecorder const &) = delete;
+
+
+
+        private:
+
+        // Write the gathered records, remembering a failure instead of throwing.
+        void write() noexcept;
+
+
+        std::ofstream              m_file;             ///!< Output file.
+        std::unique_ptr<char[]>    m_buffer;           ///!< Records not written yet.
+        std::size_t                m_bufferSize;       ///!< Bytes used in the buffer.
+        uint64_t                   m_lastTimestamp;    ///!< Timestamp of the previous record.
+        uint64_t                   m_eventCount;       ///!< Events recorded so far.
+        uint64_t                   m_byteCount;        ///!< Size of the log so far.
+        bool                       m_failed;           ///!< A write failed.
+
+    };
+
+}
+
+
+
+#endif    // OOGL_EVENTRECORDER_HPP_INCLUDED
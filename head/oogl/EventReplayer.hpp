@@ -0,0 +1,182 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     EventReplayer.hpp
+///! \brief    This file contains the declaration of the class oogl::EventReplayer and its
+///!           features. The class oogl::EventReplayer reads back an event log written by
+///!           oogl::EventRecorder, to replay a recorded session at its pace or as fast as possible.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                   // Non standard include guard
+
+#ifndef OOGL_EVENTREPLAYER_HPP_INCLUDED        // Standard include guard
+#define OOGL_EVENTREPLAYER_HPP_INCLUDED
+
+
+// Standard include list
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+// Project include list
+#include "Event.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl EventReplayer.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \enum     ReplaySpeed EventReplayer.hpp
+    ///! \brief    Lists the paces a recorded session can be replayed at.
+    ///! \version  1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    enum class ReplaySpeed
+    {
+        REAL_TIME,    ///!< Each event is handed as long after the first one as it was recorded.
+        MAXIMUM       ///!< The events are handed as fast as they are decoded.
+    };
+
+
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    EventReplayer EventReplayer.hpp
+    ///! \brief    Reader of an event log. The log is mapped into memory, so that it is decoded
+    ///!           in place, record after record, without reading it through a buffer ; the
+    ///!           platforms without memory mapping read it whole at construction.
+    ///!           The events are handed with the type, window, timestamp and payload they were
+    ///!           recorded with, so that replaying a log twice hands the same events.
+    ///! \version  1.0.0
+    ///! \see      oogl::EventRecorder
+    ///!
+    ///! <p>Decoding stops at the end of the log, or at its first incomplete or invalid record,
+    ///! as left by a recording cut short : <code>isAtEnd()</code> tells them apart.</p>
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class EventReplayer
+    {
+        public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Class constructor : map the log and check its header.
+        ///! \param path                   Path of the log to replay.
+        ///! \throw oogl::OOGLException    When the file cannot be opened or mapped, or when it is
+        ///!                               not an event log of a known version.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        explicit EventReplayer(std::string const & path);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class destructor : unmap the log.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ~EventReplayer() noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief          Decode the next event of the log.
+        ///! \param event    Event receiving the decoded one.
+        ///! \return         true if an event got decoded, false at the end of the log or at an
+        ///!                 incomplete or invalid record, the event being left untouched.
+        ///! \version        1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        bool next(oogl::Event & event) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Go back to the first event of the log.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void rewind() noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Hand the events left in the log to a function, at a given pace.
+        ///!                   At real time, the pace is taken from the first event handed.
+        ///! \param handler    Function called with each event.
+        ///! \param speed      Pace of the replay.
+        ///! \return           The number of handled events.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        template <typename Handler>
+        std::size_t replay(Handler && handler, oogl::ReplaySpeed speed);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Tell whether every record of the log has been decoded. Once
+        ///!           <code>next()</code> returned false, false means that the log ends with an
+        ///!           incomplete or invalid record.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline bool isAtEnd() const noexcept    { return m_position == m_size; }
+
+        // Getters
+        inline std::size_t getSize() const noexcept        { return m_size; }
+        inline std::size_t getPosition() const noexcept    { return m_position; }
+
+        // The mapping belongs to one replayer : no copy
+        EventReplayer(EventReplayer const &) = delete;
+        EventReplayer & operator=(EventReplayer const &) = delete;
+
+
+
+        private:
+
+        // Unmap the log, or free its copy.
+        void release() noexcept;
+
+
+        unsigned char const *               m_data;             ///!< Bytes of the log.
+        std::size_t                         m_size;             ///!< Size of the log.
+        std::size_t                         m_position;         ///!< Offset of the next record.
+        uint64_t                            m_lastTimestamp;    ///!< Timestamp of the last event.
+        std::unique_ptr<unsigned char[]>    m_copy;             ///!< Log read without mapping.
+
+    };
+
+}
+
+
+
+//==================================================================================================
+// Hand the events to a function : at real time, wait until the event is as late after the first
+// one as it was when recorded.
+//==================================================================================================
+template <typename Handler>
+std::size_t oogl::EventReplayer::replay(Handler && handler, oogl::ReplaySpeed speed)
+{
+    std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+
+    std::size_t count = 0;
+    uint64_t    first = 0;
+    oogl::Event event;
+
+    while (next(event)) {
+        if (speed == oogl::ReplaySpeed::REAL_TIME) {
+            if (count == 0) {
+                first = event.timestamp;
+            }
+
+            std::this_thread::sleep_until(start + std::chrono::nanoseconds(
+                static_cast<int64_t>(event.timestamp - first)));
+        }
+
+        handler(static_cast<oogl::Event const &>(event));
+        count++;
+    }
+
+    return count;
+}
+
+
+
+#endif    // OOGL_EVENTREPLAYER_HPP_INCLUDED
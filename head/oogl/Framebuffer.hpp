@@ -0,0 +1,206 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     Framebuffer.hpp
+///! \brief    This file contains the declaration of the class oogl::Framebuffer and its features.
+///!           The class oogl::Framebuffer is an offscreen array of 32 bits pixels, that backs the
+///!           content of a window without requiring any display server.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                 // Non standard include guard
+
+#ifndef OOGL_FRAMEBUFFER_HPP_INCLUDED        // Standard include guard
+#define OOGL_FRAMEBUFFER_HPP_INCLUDED
+
+
+// Standard include list
+#include <cstddef>
+#include <cstdint>
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl Framebuffer.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    Framebuffer Framebuffer.hpp
+    ///! \brief    Array of 32 bits pixels, stored as 0xAARRGGBB, row by row. The memory block is
+    ///!           aligned on ALIGNMENT bytes and every row is padded to a multiple of ALIGNMENT
+    ///!           bytes, so that each row starts on an aligned address.
+    ///! \version  1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class Framebuffer
+    {
+        public:
+
+        static constexpr std::size_t ALIGNMENT = 64;    ///!< Alignment of every row, in bytes.
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class constructor. No memory is allocated before the call of
+        ///!           <code>Framebuffer::allocate()</code>.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        Framebuffer() noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Copy constructor : the pixels get copied.
+        ///! \param instance               Instance to copy.
+        ///! \throw oogl::OOGLException    When the memory cannot be allocated.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        Framebuffer(Framebuffer const & instance);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief              Move constructor : the pixels get moved into the new instance.
+        ///! \param instance     Instance to move ; it is left without pixels.
+        ///! \version            1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        Framebuffer(Framebuffer && instance) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class destructor. Releases the pixels.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ~Framebuffer() noexcept;
+
+        // No assignment : the pixels are owned by a unique instance.
+        Framebuffer & operator=(Framebuffer const &) = delete;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Size the framebuffer. The memory already allocated is
+        ///!                               kept when it is large enough for the new dimensions ;
+        ///!                               the pixel values are then left unspecified.
+        ///! \param width                  Number of pixels on a row.
+        ///! \param height                 Number of rows.
+        ///! \throw oogl::OOGLException    When the memory cannot be allocated.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void allocate(unsigned int width, unsigned int height);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Release the pixels memory.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void release() noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief          Set every pixel of the framebuffer to the given color.
+        ///! \param color    Color of the pixels, as 0xAARRGGBB.
+        ///! \version        1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void clear(uint32_t color) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief          Set the pixels of a rectangle to the given color. The rectangle is
+        ///!                 clipped to the framebuffer.
+        ///! \param x        Abscissa of the top left corner.
+        ///! \param y        Ordinate of the top left corner.
+        ///! \param width    Width of the rectangle.
+        ///! \param height   Height of the rectangle.
+        ///! \param color    Color of the pixels, as 0xAARRGGBB.
+        ///! \version        1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void fill(unsigned int x, unsigned int y, unsigned int width, unsigned int height,
+                  uint32_t color) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief              Copy a rectangle of pixels from another framebuffer. The rectangle
+        ///!                     is clipped to both framebuffers.
+        ///! \param source       Framebuffer the pixels get copied from.
+        ///! \param sourceX      Abscissa of the top left corner in the source.
+        ///! \param sourceY      Ordinate of the top left corner in the source.
+        ///! \param width        Width of the rectangle.
+        ///! \param height       Height of the rectangle.
+        ///! \param x            Abscissa of the top left corner in this framebuffer.
+        ///! \param y            Ordinate of the top left corner in this framebuffer.
+        ///! \version            1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void copy(Framebuffer const & source, unsigned int sourceX, unsigned int sourceY,
+                  unsigned int width, unsigned int height, unsigned int x,
+                  unsigned int y) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief      Get the pixels of a row.
+        ///! \param y    Index of the row, lower than the height.
+        ///! \return     A pointer to the first pixel of the row ; the row holds width pixels.
+        ///! \version    1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline uint32_t * getRow(unsigned int y) noexcept
+        {
+            return m_pixels + static_cast<std::size_t>(y) * m_pitch;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief      Get the pixels of a row.
+        ///! \param y    Index of the row, lower than the height.
+        ///! \return     A pointer to the first pixel of the row ; the row holds width pixels.
+        ///! \version    1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline uint32_t const * getRow(unsigned int y) const noexcept
+        {
+            return m_pixels + static_cast<std::size_t>(y) * m_pitch;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the first pixel of the framebuffer, nullptr when it is not allocated.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline uint32_t * getPixels() noexcept                { return m_pixels; }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the number of pixels between the starts of two consecutive rows.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline std::size_t getPitch() const noexcept          { return m_pitch; }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the number of pixels on a row.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline unsigned int getWidth() const noexcept         { return m_width; }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the number of rows.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline unsigned int getHeight() const noexcept        { return m_height; }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the size of the allocated memory block, in bytes.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline std::size_t getCapacity() const noexcept       { return m_capacity; }
+
+
+
+        private:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Set a span of pixels to the given color, using vector stores.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        static void fillSpan(uint32_t * span, std::size_t length, uint32_t color) noexcept;
+
+
+        uint32_t *      m_pixels;      ///!< First pixel of the aligned memory block.
+        std::size_t     m_pitch;       ///!< Pixels between two consecutive rows.
+        std::size_t     m_capacity;    ///!< Size of the memory block, in bytes.
+        unsigned int    m_width;       ///!< Pixels on a row.
+        unsigned int    m_height;      ///!< Number of rows.
+
+    };
+
+}
+
+
+
+#endif    // OOGL_FRAMEBUFFER_HPP_INCLUDED
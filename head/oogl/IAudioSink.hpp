@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     IAudioSink.hpp
+///! \brief    This file contains the declaration of the class oogl::IAudioSink and its features.
+///!           The class oogl::IAudioSink is an interface describing the outputs the audio mixer
+///!           hands its frames to.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                // Non standard include guard
+
+#ifndef OOGL_IAUDIOSINK_HPP_INCLUDED        // Standard include guard
+#define OOGL_IAUDIOSINK_HPP_INCLUDED
+
+
+// Standard include list
+#include <cstddef>
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl IAudioSink.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    IAudioSink IAudioSink.hpp
+    ///! \brief    The interface class IAudioSink describes any output of the audio mixer : a
+    ///!           device, a file, or nothing at all when running headless.
+    ///! \version  1.0.0
+    ///! \see      oogl::AudioMixer
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class IAudioSink
+    {
+        public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Virtual class destructor.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        virtual ~IAudioSink() noexcept = default;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Method, to be implemented in child classes, consuming
+        ///!                               mixed frames.
+        ///! \param samples                Interleaved stereo samples, in [-1, 1].
+        ///! \param frameCount             Number of frames, i.e. of sample pairs.
+        ///! \throw oogl::OOGLException    When the frames cannot be output.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        virtual void write(float const * samples, std::size_t frameCount) = 0;
+
+    };
+
+}
+
+
+
+#endif    // OOGL_IAUDIOSINK_HPP_INCLUDED
@@ -15,7 +15,8 @@
 #define OOGL_ITRACKABLEOBJECT_HPP_INCLUDED
 
 
-// No required includes
+// Project include list
+#include "SlotMap.hpp"
 
 
 
@@ -42,6 +43,25 @@ namespace oogl
     {
         public:
 
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class constructor : the object is not tracked.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ITrackableObject() noexcept = default;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Copy constructor. A copy is a different object : it is not tracked.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ITrackableObject(ITrackableObject const &) noexcept : m_trackingHandle(INVALID_SLOT_HANDLE)
+        {}
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Assignment operator. The tracking handle belongs to the object : it is kept.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ITrackableObject & operator=(ITrackableObject const &) noexcept    { return *this; }
+
         ////////////////////////////////////////////////////////////////////////////////////////////
         ///! \brief    Virtual class desctructor.
         ///! \version  1.0.0
@@ -58,12 +78,40 @@ namespace oogl
 
         ////////////////////////////////////////////////////////////////////////////////////////////
         ///! \brief                        Method, to be implemented in child classes, for an object
-        ///!                               to get properly free without memory leak.
+        ///!                               to get properly free without memory leak. During the
+        ///!                               library exit, it gets called from the worker threads.
         ///! \throw oogl::OOGLException    When there is a failure during the liberation process.
         ///! \version                      1.0.0
         ////////////////////////////////////////////////////////////////////////////////////////////
         virtual void free() = 0;
 
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the object this one depends on : the library exit frees an object before
+        ///!           its owner, and the objects without dependency between them concurrently, on
+        ///!           the worker pool.
+        ///! \return   The owner, or nullptr when the object depends on none.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        virtual ITrackableObject * getOwner() const noexcept    { return nullptr; }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the handle of the object in the tracker of the graphic library handler.
+        ///! \return   The handle, stale or invalid when the object is not tracked.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline SlotHandle getTrackingHandle() const noexcept    { return m_trackingHandle; }
+
+
+
+        private:
+
+        /*!< Handle of the object in the tracker, set by the graphic library handler which makes
+         *   untracking a constant time operation.                                            */
+        SlotHandle    m_trackingHandle = INVALID_SLOT_HANDLE;
+
+        // Friend class : the handler sets the tracking handle
+        friend class OOGLHandler;
+
     };
 
 }
@@ -0,0 +1,210 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     InputState.hpp
+///! \brief    This file contains the declaration of the class oogl::InputState and its features.
+///!           The class oogl::InputState holds the state of the input devices (keys held down,
+///!           pointer, joystick axes and buttons), published once per poll of the events, so that
+///!           any thread reads a consistent snapshot of it without lock.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                // Non standard include guard
+
+#ifndef OOGL_INPUTSTATE_HPP_INCLUDED        // Standard include guard
+#define OOGL_INPUTSTATE_HPP_INCLUDED
+
+
+// Standard include list
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+// Project include list
+#include "Event.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl InputState.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \struct   InputSnapshot InputState.hpp
+    ///! \brief    State of the input devices at a publication : a bit per key code, the pointer
+    ///!           and the joystick. It is trivially copyable so that it gets copied word by word.
+    ///! \version  1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    struct InputSnapshot
+    {
+        static constexpr std::size_t KEY_COUNT  = 512;                ///!< Key codes tracked.
+        static constexpr std::size_t KEY_WORDS  = KEY_COUNT / 64;     ///!< Words of key bits.
+        static constexpr std::size_t AXIS_COUNT = 8;                  ///!< Joystick axes.
+
+        uint64_t    sequence;                ///!< Number of the publication, 0 before the first.
+        uint64_t    timestamp;               ///!< Timestamp of the last applied event.
+        uint64_t    keys[KEY_WORDS];         ///!< Bit of each key code held down.
+        uint32_t    modifiers;               ///!< Modifier keys held.
+        uint32_t    mouseButtons;            ///!< Mask of the mouse buttons held.
+        int32_t     mouseX;                  ///!< Pointer abscissa.
+        int32_t     mouseY;                  ///!< Pointer ordinate.
+        uint32_t    mouseWindow;             ///!< Window of the last pointer event, 0 when none.
+        uint32_t    joystickButtons;         ///!< Mask of the joystick buttons held.
+        int16_t     axes[AXIS_COUNT];        ///!< Joystick axes, from -32768 to 32767.
+
+        // Tell whether a key is held down ; false for the codes out of range.
+        inline bool isKeyDown(uint32_t code) const noexcept
+        { return code < KEY_COUNT && (keys[code / 64] >> (code % 64) & 1) != 0; }
+    };
+
+    // Typedef to remove the struct keyword from the type
+    typedef struct InputSnapshot InputSnapshot;
+
+    static_assert(std::is_trivially_copyable<InputSnapshot>::value,
+                  "Input snapshots must be trivially copyable.");
+    static_assert(sizeof(InputSnapshot) % sizeof(uint64_t) == 0,
+                  "Input snapshots must be made of whole words.");
+
+
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    InputState InputState.hpp
+    ///! \brief    State of the input devices, written by one thread and read by any thread. The
+    ///!           writer applies the events it polls and the joystick readings to a pending
+    ///!           state, then publishes it once per poll ; the readers copy the published state
+    ///!           without lock nor write, in a few nanoseconds.
+    ///!           The publication is a sequence lock : the writer makes the sequence odd, writes
+    ///!           the words of the state, then makes it even again ; a reader copies the words
+    ///!           between two reads of the sequence, and copies them again when the sequence was
+    ///!           odd or changed meanwhile. The words are atomic, so that a torn copy is only ever
+    ///!           thrown away, never a data race.
+    ///! \version  1.0.0
+    ///! \see      oogl::EventQueue
+    ///!
+    ///! <p>The event queue applies the events it hands and publishes the state at the end of each
+    ///! poll. The joystick readings must be set from the thread polling the events, before the
+    ///! poll which publishes them.</p>
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class InputState
+    {
+        public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class constructor : no key nor button held, every axis centered.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        InputState() noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Apply an event to the pending state. Writer side only.
+        ///! \param event      Key or mouse event ; the other types are ignored.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void apply(oogl::Event const & event) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Set a joystick axis in the pending state. Writer side only.
+        ///! \param axis       Index of the axis ; the indexes out of range are ignored.
+        ///! \param value      Position of the axis.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void setAxis(std::size_t axis, int16_t value) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Set the joystick buttons held in the pending state. Writer side only.
+        ///! \param buttons    Mask of the buttons held.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void setJoystickButtons(uint32_t buttons) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Publish the pending state, when it changed since the last publication.
+        ///!           Writer side only.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void publish() noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Copy the last published state. Can be called from any thread.
+        ///! \return   The snapshot of the state.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        oogl::InputSnapshot read() const noexcept;
+
+        // Getter
+        inline uint64_t getPublishedCount() const noexcept
+        { return m_sequence.load(std::memory_order_relaxed) / 2; }
+
+        // The readers reference the published words : no copy
+        InputState(InputState const &) = delete;
+        InputState & operator=(InputState const &) = delete;
+
+
+
+        private:
+
+        static constexpr std::size_t CACHE_LINE = 64;    ///!< Size of a cache line, in bytes.
+        static constexpr std::size_t WORD_COUNT = sizeof(oogl::InputSnapshot) / sizeof(uint64_t);
+
+
+        oogl::InputSnapshot    m_pending;    ///!< State being updated by the writer.
+        bool                   m_changed;    ///!< The pending state changed since publication.
+
+        alignas(CACHE_LINE) std::atomic<uint64_t>    m_sequence;                ///!< Odd : writing.
+        std::atomic<uint64_t>                        m_published[WORD_COUNT];    ///!< Words.
+
+    };
+
+}
+
+
+
+//==================================================================================================
+// Copy the published words between two reads of the sequence, until it was even and did not change
+// meanwhile ; the writer holding the sequence odd only for the copy of the words, the reader yields
+// to it.
+//==================================================================================================
+inline oogl::InputSnapshot oogl::InputState::read() const noexcept
+{
+    uint64_t words[WORD_COUNT];
+
+    for (;;) {
+        uint64_t const sequence = m_sequence.load(std::memory_order_acquire);
+
+        if ((sequence & 1) != 0) {    // being published
+            std::this_thread::yield();
+            continue;
+        }
+
+        for (std::size_t index = 0; index < WORD_COUNT; index++) {
+            words[index] = m_published[index].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (m_sequence.load(std::memory_order_relaxed) == sequence) {    // consistent copy
+            break;
+        }
+    }
+
+    oogl::InputSnapshot snapshot;
+    std::memcpy(&snapshot, words, sizeof(snapshot));
+
+    return snapshot;
+}
+
+
+
+#endif    // OOGL_INPUTSTATE_HPP_INCLUDED
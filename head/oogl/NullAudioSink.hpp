@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     NullAudioSink.hpp
+///! \brief    This file contains the declaration of the class oogl::NullAudioSink and its
+///!           features. The class oogl::NullAudioSink is the audio output discarding the frames,
+///!           to run the audio subsystem headless.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                   // Non standard include guard
+
+#ifndef OOGL_NULLAUDIOSINK_HPP_INCLUDED        // Standard include guard
+#define OOGL_NULLAUDIOSINK_HPP_INCLUDED
+
+
+// Standard include list
+#include <cstdint>
+
+// Project include list
+#include "IAudioSink.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl NullAudioSink.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    NullAudioSink NullAudioSink.hpp
+    ///! \brief    Audio output discarding the frames it receives. It only counts them, and keeps
+    ///!           the peak amplitude, so that the mixing can be checked without any device.
+    ///! \version  1.0.0
+    ///! \see      oogl::IAudioSink
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class NullAudioSink : public oogl::IAudioSink
+    {
+        public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class constructor.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        NullAudioSink() noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief               Discard frames.
+        ///! \param samples       Interleaved stereo samples.
+        ///! \param frameCount    Number of frames.
+        ///! \version             1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        virtual void write(float const * samples, std::size_t frameCount) override;
+
+        // Getters
+        inline uint64_t getFrameCount() const noexcept    { return m_frameCount; }
+        inline float getPeak() const noexcept             { return m_peak; }
+
+
+
+        private:
+
+        uint64_t    m_frameCount;    ///!< Frames received so far.
+        float       m_peak;          ///!< Highest absolute sample received so far.
+
+    };
+
+}
+
+
+
+#endif    // OOGL_NULLAUDIOSINK_HPP_INCLUDED
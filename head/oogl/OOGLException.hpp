@@ -16,13 +16,31 @@
 
 // Standard include list
 #include <functional>
-#include <map>
+#include <string>
 
 // Project include list
 #include "MessagedException.hpp"
 
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \brief    OOGL_THROW(code) reports an error of the framework : it throws an
+///!           oogl::OOGLException or, when the exceptions are disabled (-fno-exceptions, or
+///!           OOGL_NO_EXCEPTIONS defined), it prints the message and aborts. The non-throwing
+///!           paths return an oogl::Result.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#if ! defined(OOGL_NO_EXCEPTIONS) && ! defined(__cpp_exceptions) && ! defined(__EXCEPTIONS)
+#define OOGL_NO_EXCEPTIONS
+#endif
+
+#if defined(OOGL_NO_EXCEPTIONS)
+#define OOGL_THROW(code)    oogl::OOGLException::fail(code)
+#else
+#define OOGL_THROW(code)    throw oogl::OOGLException(code)
+#endif
+
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ///! \namespace  oogl OOGLException.hpp
 ///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
@@ -49,11 +67,24 @@ namespace oogl
         NO_EXCEPTION,                     ///!< No exception.
         OOGL_HANDLER_ALREADY_CREATED,     ///!< Trying to create a second graphic library handler.
         OOGL_HANDLER_NOT_CREATED,         ///!< Trying to destroy or access a non-created handler.
+        UNKNOWN_GRAPHIC_LIBRARY,          ///!< Trying to create a handler for no known library.
         LIB_ALREADY_INIT,                 ///!< Trying to initialize several times a library.
         LIB_NOT_INIT,                     ///!< Trying to exit an uninitialized library.
         OOGLHANDLER_NULL_OBJ_TRACK,       ///!< Trying to track an object pointed by nullptr.
         WIN_ALREADY_CREATED,              ///!< Trying to create an already created window.
-        WIN_NOT_CREATED                   ///!< Trying to destroy a non created window.
+        WIN_NOT_CREATED,                  ///!< Trying to destroy a non created window.
+        FRAMEBUFFER_ALLOCATION_FAILED,    ///!< Not enough memory for the pixels of a framebuffer.
+        EVENTS_NOT_INIT,                  ///!< Accessing the events of an uninitialized subsystem.
+        TIMER_NOT_INIT,                   ///!< Accessing the timers of an uninitialized subsystem.
+        AUDIO_NOT_INIT,                   ///!< Accessing the mixer of an uninitialized subsystem.
+        AUDIO_SINK_FAILED,                ///!< An audio output cannot be opened or written.
+        PROFILER_EXPORT_FAILED,           ///!< A profiler trace cannot be written.
+        HANDLER_BACKEND_MISMATCH,         ///!< The handler is not of the statically chosen backend.
+        PLUGIN_LOAD_FAILED,               ///!< A library plugin cannot be loaded.
+        EVENT_LOG_FAILED,                 ///!< An event log cannot be written or read.
+        RESOURCE_LOAD_FAILED,             ///!< A resource file cannot be read.
+        TRACKER_ALLOCATION_FAILED,        ///!< Not enough memory to track one more object.
+        RESULT_WITHOUT_VALUE              ///!< A result built from NO_EXCEPTION, without value.
     };
 
 
@@ -108,11 +139,11 @@ namespace oogl
         virtual ~OOGLException() noexcept = default;
 
         ////////////////////////////////////////////////////////////////////////////////////////////
-        ///! \brief     Get the exception message.
-        ///! \return    The exception message as a C-like string.
+        ///! \brief     Get the exception code.
+        ///! \return    The code the exception got created with.
         ///! \version   1.0.0
         ////////////////////////////////////////////////////////////////////////////////////////////
-        virtual const char * what() const throw();
+        inline oogl::ExceptionCode getCode() const noexcept    { return m_code; }
 
         ////////////////////////////////////////////////////////////////////////////////////////////
         ///! \brief             Set the external method that is called to get a more detailed error
@@ -125,14 +156,20 @@ namespace oogl
         static void setExternalErrorFunction(std::function<std::string(void)> getError);
 
         ////////////////////////////////////////////////////////////////////////////////////////////
-        ///! \brief             Set the external method that is called to get a more detailed error
-        ///!                    message.
-        ///! \param getError    Function of the external graphic library that makes it possible to
-        ///!                    get a precise description of the error encountered by the graphic
-        ///!                    library.
-        ///! \version           1.0.0
+        ///! \brief         Get the message associated to an exception code, without allocation.
+        ///! \param code    Exception code.
+        ///! \return        The message, as a static C-like string.
+        ///! \version       1.0.0
         ////////////////////////////////////////////////////////////////////////////////////////////
-        static std::string getMessageFromCode(oogl::ExceptionCode code) noexcept;
+        static char const * getMessageFromCode(oogl::ExceptionCode code) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief         Print the message associated to an exception code, and abort. Used by
+        ///!                OOGL_THROW when the exceptions are disabled.
+        ///! \param code    Exception code.
+        ///! \version       1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        [[noreturn]] static void fail(oogl::ExceptionCode code) noexcept;
 
 
 
@@ -145,9 +182,12 @@ namespace oogl
         static std::function<std::string(void)>   s_getExternalExceptionMessage;
 
         ////////////////////////////////////////////////////////////////////////////////////////////
-        ///! \brief  Map associating the exception codes to the exception messages.
+        ///! \brief  Table of the exception messages, indexed by the exception codes.
         ////////////////////////////////////////////////////////////////////////////////////////////
-        static std::map<ExceptionCode, std::string>    s_mapExceptionCodeMessage;
+        static char const * const    s_exceptionMessages[];
+
+        // Build the message of an exception : the message of the code, then the external one.
+        static std::string buildMessage(oogl::ExceptionCode code);
 
 
         ExceptionCode   m_code;    ///!< Code related to the exception
@@ -16,10 +16,24 @@
 
 
 // Standard include list
-#include <set>
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <new>
 
 // Project include list
+#include "AudioMixer.hpp"
+#include "EventQueue.hpp"
 #include "ITrackableObject.hpp"
+#include "InputState.hpp"
+#include "Profiler.hpp"
+#include "Result.hpp"
+#include "Scheduler.hpp"
+#include "SlotMap.hpp"
+#include "TimerWheel.hpp"
+#include "WorkerPool.hpp"
 //#include "OOGLHandlerFactory.hpp"
 //#include "OOGLException.hpp"
 
@@ -50,10 +64,10 @@ namespace oogl
     ///! \enum     MediaSystem OOGLHandler.hpp
     ///! \brief    Lists the different subsystems handled by this framework.
     ///!           Please, note the flags associated with this subsystem can be combined through the
-    ///!           use of the | and & and ! operators that are overloadded.
+    ///!           use of the | and & and ~ operators that are overloadded.
     ///! \version  1.0.0
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    enum MediaSystem : uint32_t
+    enum class MediaSystem : uint32_t
     {
         ALL             = 1 << 0,    ///!< Flag to use to deal with all the subsystems.
         AUDIO           = 1 << 1,    ///!< Flag to use to deal with the audio subsystem.
@@ -84,10 +98,10 @@ namespace oogl
         );
     }
 
-    // Overload the NOT '!' operator for the flags of the above enumeration.
-    inline MediaSystem operator!(MediaSystem sys)
+    // Overload the NOT '~' operator for the flags of the above enumeration.
+    inline MediaSystem operator~(MediaSystem sys)
     {
-        return static_cast<MediaSystem>(! static_cast<uint32_t>(sys));
+        return static_cast<MediaSystem>(~ static_cast<uint32_t>(sys));
     }
 
 
@@ -121,8 +135,11 @@ namespace oogl
         ///! \brief                        Stop the graphic library features and free allocated
         ///!                               memory space. Overriden method in child classes as
         ///!                               freeing the used memory space strongly depends on the
-        ///!                               library which is involved.
-        ///! \throw oogl::OOGLException    When the system has not been initialized.
+        ///!                               library which is involved. The tracked objects are freed
+        ///!                               level by level, every object before its owner, and the
+        ///!                               objects of a level concurrently on the worker pool.
+        ///! \throw oogl::OOGLException    When the system has not been initialized, or the first
+        ///!                               error of the tracked objects being freed.
         ///! \version                      1.0.0
         ////////////////////////////////////////////////////////////////////////////////////////////
         virtual void exit();
@@ -145,20 +162,163 @@ namespace oogl
         virtual OOGLHandler & deactivateSystem(MediaSystem system) noexcept;
 
         ////////////////////////////////////////////////////////////////////////////////////////////
-        ///! \brief           Give a new trackable object to keep trace on to the GL handler.
-        ///! \param object    Object to get tracked by the graphic library handler.
+        ///! \brief           Tell whether a system or combination of systems is activated.
+        ///! \param system    Flag associated with the system or combination of systems to test.
+        ///! \return          true if every given system is activated, false otherwise.
+        ///! \version         1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        bool isSystemActivated(MediaSystem system) const noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief           Defer the start of the given system or combination of systems : the
+        ///!                  initialization of the library skips them, and each one starts on the
+        ///!                  first access to its service, if activated.
+        ///! \param system    Flag associated with the system or combination of systems to defer.
+        ///! \return          A reference to the calling instance.
+        ///! \version         1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        OOGLHandler & deferSystem(MediaSystem system) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief           Start the given system or combination of systems with the library
+        ///!                  initialization again.
+        ///! \param system    Flag associated with the system or combination of systems to start
+        ///!                  at the initialization.
         ///! \return          A reference to the calling instance.
         ///! \version         1.0.0
         ////////////////////////////////////////////////////////////////////////////////////////////
-        virtual OOGLHandler & track(ITrackableObject * object) noexcept;
+        OOGLHandler & undeferSystem(MediaSystem system) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief           Tell whether the start of a system or combination of systems is
+        ///!                  deferred to its first use.
+        ///! \param system    Flag associated with the system or combination of systems to test.
+        ///! \return          true if every given system is deferred, false otherwise.
+        ///! \version         1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        bool isSystemDeferred(MediaSystem system) const noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Get the queue of the events subsystem. It is created by
+        ///!                               the initialization of the library when the events
+        ///!                               subsystem is activated, or on the first call when the
+        ///!                               subsystem is deferred, and destroyed by its exit.
+        ///! \return                       A reference to the event queue.
+        ///! \throw oogl::OOGLException    When the events subsystem has not been initialized.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        oogl::EventQueue & getEventQueue();
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Get the input state of the events subsystem, created and
+        ///!                               destroyed along with the event queue, which publishes it
+        ///!                               at the end of each poll. Any thread can read it ; the
+        ///!                               joystick readings are set from the thread polling the
+        ///!                               events, and published by its next poll.
+        ///! \return                       A reference to the input state.
+        ///! \throw oogl::OOGLException    When the events subsystem has not been initialized.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        oogl::InputState & getInputState();
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Get the timer service of the timer subsystem. It is
+        ///!                               created by the initialization of the library when the
+        ///!                               timer subsystem is activated, or on the first call when
+        ///!                               the subsystem is deferred, and destroyed by its exit.
+        ///!                               The timers without callback are pushed to the event
+        ///!                               queue, if any. The application advances it through
+        ///!                               <code>TimerWheel::update()</code>, usually once a frame.
+        ///! \return                       A reference to the timer wheel.
+        ///! \throw oogl::OOGLException    When the timer subsystem has not been initialized.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        oogl::TimerWheel & getTimerWheel();
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Get the mixer of the audio subsystem. It is created by
+        ///!                               the initialization of the library when the audio
+        ///!                               subsystem is activated, or on the first call when the
+        ///!                               subsystem is deferred, and destroyed by its exit.
+        ///! \return                       A reference to the audio mixer.
+        ///! \throw oogl::OOGLException    When the audio subsystem has not been initialized.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        oogl::AudioMixer & getAudioMixer();
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the job system of the library, shared by the rendering, the audio mixing,
+        ///!           the timers and the teardown. Its worker threads are started by the
+        ///!           initialization of the library and joined by its exit ; meanwhile, the tasks
+        ///!           submitted to it run on the calling thread.
+        ///! \return   A reference to the worker pool.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline oogl::WorkerPool & getWorkerPool() noexcept    { return m_workerPool; }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the scheduler resuming the coroutines of the handler, and pooling their
+        ///!           frames. The main loop hands it the drained events, and runs it once a frame.
+        ///! \return   A reference to the scheduler.
+        ///! \version  1.0.0
+        ///! \see      oogl::Task
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline oogl::Scheduler & getScheduler() noexcept      { return m_scheduler; }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief           Get the time a system took to start, at the initialization of the
+        ///!                  library or at its first use when deferred.
+        ///! \param system    Flag of one system, or MediaSystem::ALL for the whole initialization.
+        ///! \return          The duration, in nanoseconds, or 0 when the system has not started.
+        ///! \version         1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        uint64_t getStartupDuration(MediaSystem system) const noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Write the startup time of the library and of each activated system,
+        ///!                   one per line.
+        ///! \param stream     Stream receiving the report.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void writeStartupReport(std::ostream & stream) const;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief           Give a new trackable object to keep trace on to the GL handler.
+        ///!                  Tracking an already tracked object does nothing.
+        ///! \param object                Object to get tracked by the graphic library handler.
+        ///! \return                       A reference to the calling instance.
+        ///! \throw oogl::OOGLException    When the object is pointed by nullptr.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        virtual OOGLHandler & track(ITrackableObject * object);
 
         ////////////////////////////////////////////////////////////////////////////////////////////
         ///! \brief           Delete a trackable object from the track list of the GL handler.
+        ///!                  Untracking an object which is not tracked does nothing.
+        ///! \param object                Object to get untracked by the graphic library handler.
+        ///! \return                       A reference to the calling instance.
+        ///! \throw oogl::OOGLException    When the object is pointed by nullptr.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        virtual OOGLHandler & untrack(ITrackableObject * object);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief           Non-throwing version of track(), for the hot paths.
+        ///! \param object    Object to get tracked by the graphic library handler.
+        ///! \return          The error code OOGLHANDLER_NULL_OBJ_TRACK when the object is pointed
+        ///!                  by nullptr, a success otherwise.
+        ///! \version         1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        oogl::Result<void> tryTrack(ITrackableObject * object) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief           Non-throwing version of untrack(), for the hot paths.
         ///! \param object    Object to get untracked by the graphic library handler.
-        ///! \return          A reference to the calling instance.
+        ///! \return          The error code OOGLHANDLER_NULL_OBJ_TRACK when the object is pointed
+        ///!                  by nullptr, a success otherwise.
         ///! \version         1.0.0
         ////////////////////////////////////////////////////////////////////////////////////////////
-        virtual OOGLHandler & untrack(ITrackableObject * object) noexcept;
+        oogl::Result<void> tryUntrack(ITrackableObject * object) noexcept;
 
 
 
@@ -176,11 +336,12 @@ namespace oogl
 
         ////////////////////////////////////////////////////////////////////////////////////////////
         ///! \brief    Class destructor. For the same reason than for the constructor, it is
-        ///!           declared protected.
+        ///!           declared protected. It is virtual as the factory destroys the child
+        ///!           handlers through a pointer to this class.
         ///! \version  1.0.0
         ///! \see      oogl::OOGLHandlerFactory
         ////////////////////////////////////////////////////////////////////////////////////////////
-        ~OOGLHandler() = default;
+        virtual ~OOGLHandler() = default;
 
         ////////////////////////////////////////////////////////////////////////////////////////////
         ///! \brief    Get the combination of flags furnishing the activated systems. Accessible
@@ -203,11 +364,50 @@ namespace oogl
 
         private:
 
+        static constexpr unsigned int SYSTEM_COUNT = 7;    ///!< Systems behind the flags.
+
+        // Free the tracked objects, owned objects first, then empty the tracker.
+        void freeTrackedObjects();
+
+        // Start the service of one system, unless already started, and time it.
+        bool startSystem(MediaSystem system);
+
+        // Start a deferred system on its first use, then connect and publish its service.
+        void startOnFirstUse(MediaSystem system);
+
+        // Connect the services of the given systems, just started, to the other services.
+        void connectSystems(MediaSystem started) noexcept;
+
+        // Publish the started services to the getters, or withdraw them all.
+        void publishSystems() noexcept;
+        void withdrawSystems() noexcept;
+
+
         bool           m_isInitialized;    ///!< Indicates whether the library has been initilized.
         MediaSystem    m_systems;          ///!< Flag associated to the tracked systems.
+        MediaSystem    m_deferred;         ///!< Systems started on their first use.
+
+        uint64_t       m_initDuration;                         ///!< Time of the initialization.
+        uint64_t       m_startupDurations[SYSTEM_COUNT];       ///!< Time each system took to start.
 
-        std::set<oogl::ITrackableObject *>    m_tracker;    /*!< Set in charge of the trackable
-                                                             *   objects pointers storage.   */
+        oogl::SlotMap<oogl::ITrackableObject *>    m_tracker;    /*!< Slot map in charge of the
+                                                                  *   trackable objects pointers
+                                                                  *   storage.               */
+
+        bool                m_isTearingDown;    ///!< The tracked objects are being freed.
+        oogl::WorkerPool    m_workerPool;       ///!< Job system shared by the whole library.
+        oogl::Scheduler     m_scheduler;        ///!< Scheduler of the coroutines.
+
+        std::unique_ptr<oogl::EventQueue>    m_eventQueue;    ///!< Queue of the events subsystem.
+        std::unique_ptr<oogl::InputState>    m_inputState;    ///!< Input state of the events.
+        std::unique_ptr<oogl::TimerWheel>    m_timerWheel;    ///!< Timers of the timer subsystem.
+        std::unique_ptr<oogl::AudioMixer>    m_audioMixer;    ///!< Mixer of the audio subsystem.
+
+        // The getters may be called from any thread : the services are published once connected
+        std::mutex                           m_startMutex;          ///!< Starts on first use.
+        std::atomic<oogl::EventQueue *>      m_publishedQueue;      ///!< With the input state.
+        std::atomic<oogl::TimerWheel *>      m_publishedTimers;     ///!< Started timer wheel.
+        std::atomic<oogl::AudioMixer *>      m_publishedMixer;      ///!< Started audio mixer.
 
     };
 
@@ -215,4 +415,92 @@ namespace oogl
 
 
 
+//==================================================================================================
+// Method which registers a new trackable object.
+//==================================================================================================
+inline oogl::OOGLHandler & oogl::OOGLHandler::track(ITrackableObject * object)
+{
+    oogl::Result<void> const result = tryTrack(object);
+
+    if (! result) {
+        OOGL_THROW(result.getCode());
+    }
+
+    return *this;
+}
+
+
+//==================================================================================================
+// Method which unregisters a given trackable object.
+//==================================================================================================
+inline oogl::OOGLHandler & oogl::OOGLHandler::untrack(ITrackableObject * object)
+{
+    oogl::Result<void> const result = tryUntrack(object);
+
+    if (! result) {
+        OOGL_THROW(result.getCode());
+    }
+
+    return *this;
+}
+
+
+//==================================================================================================
+// Method which registers a new trackable object, reporting the errors through the result.
+//==================================================================================================
+inline oogl::Result<void> oogl::OOGLHandler::tryTrack(ITrackableObject * object) noexcept
+{
+    OOGL_PROFILE_ZONE("OOGLHandler::tryTrack");
+
+    if (object == nullptr) {    // the pointer does not point to an actual object
+        return oogl::ExceptionCode::OOGLHANDLER_NULL_OBJ_TRACK;
+    }
+
+    oogl::ITrackableObject ** const tracked = m_tracker.get(object->m_trackingHandle);
+
+    if (tracked == nullptr || *tracked != object) {    // not tracked yet : add it to the tracker
+#if defined(OOGL_NO_EXCEPTIONS)
+        object->m_trackingHandle = m_tracker.insert(object);
+#else
+        try {
+            object->m_trackingHandle = m_tracker.insert(object);
+        } catch (std::bad_alloc const &) {    // the slots could not grow
+            return oogl::ExceptionCode::TRACKER_ALLOCATION_FAILED;
+        }
+#endif
+    }
+
+    return oogl::Result<void>();
+}
+
+
+//==================================================================================================
+// Method which unregisters a given trackable object, reporting the errors through the result.
+//==================================================================================================
+inline oogl::Result<void> oogl::OOGLHandler::tryUntrack(ITrackableObject * object) noexcept
+{
+    OOGL_PROFILE_ZONE("OOGLHandler::tryUntrack");
+
+    if (object == nullptr) {    // the pointer does not point to an actual object
+        return oogl::ExceptionCode::OOGLHANDLER_NULL_OBJ_TRACK;
+    }
+
+    if (m_isTearingDown) {    // the tracker is emptied at once by the exit, read concurrently
+        object->m_trackingHandle = oogl::INVALID_SLOT_HANDLE;
+        return oogl::Result<void>();
+    }
+
+    oogl::ITrackableObject ** const tracked = m_tracker.get(object->m_trackingHandle);
+
+    if (tracked != nullptr && *tracked == object) {    // tracked : remove it from the tracker
+        m_tracker.erase(object->m_trackingHandle);
+        object->m_trackingHandle = oogl::INVALID_SLOT_HANDLE;
+    }
+
+    return oogl::Result<void>();
+}
+
+
+
+
 #endif    // OOGL_OOGLHANDLER_HPP_INLUDED
@@ -14,7 +14,15 @@
 ///! others.</p>
 ///! <p>A class implementing a graphic library handler inherits from oogl::OOGLHandler, which make
 ///! it not possible to be implemented as a singleton. The class developped in this file creates
-///! and stores a unique graphic library handler that then can be accessed.
+///! and stores a unique graphic library handler that then can be accessed.</p>
+///! <p>Processes driving several isolated contexts, one per request or per core for instance,
+///! create as many isolated handlers, each with its own tracker, subsystems and worker pool. A
+///! thread selects the handler it works for as its current one ; the workers of a handler have it
+///! as current handler.</p>
+///! <p>The libraries are listed in a registry. A library built as a plugin, a shared object
+///! defining its entry points through OOGL_PLUGIN (see OOGLPlugin.hpp), is only loaded when a
+///! handler of it gets created, and unloaded once its last handler is destroyed : a deployment
+///! using one library out of several does not pay for the others.</p>
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -24,7 +32,11 @@
 #define OOGL_OOGLHANDLERFACTORY_HPP_INCLUDED
 
 
-// No includes : simple forward class declaration
+// Standard include list
+#include <string>
+
+// Project include list
+#include "Result.hpp"
 
 
 
@@ -49,9 +61,11 @@ namespace oogl
     ///! \brief    Enumerate the different accessible graphic library of the framework.
     ///! \version  1.0.0
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    enum GraphicLibrary                // TO DO !
+    enum GraphicLibrary
     {
-        UNDEFINED                      ///!< No library specified.
+        UNDEFINED,                     ///!< No library specified.
+        SOFTWARE,                      ///!< CPU rendering library, no display server required.
+        NULL_LIBRARY                   ///!< Library doing nothing, for the tests. Plugin only.
     };
 
 
@@ -59,6 +73,9 @@ namespace oogl
     ///! \class    OOGLHandlerFactory OOGLHandlerFactory.hpp
     ///! \brief    Special factory class designed to create and store a unique graphic library
     ///!           handler, that can then be accessed by other classes through OOGLHandlerFactory.
+    ///!           It also creates isolated handlers, which the threads select as their current
+    ///!           handler : the accesses through the factory then give the current handler of the
+    ///!           calling thread, and the unique one for the threads without.
     ///! \version  1.0.0
     ////////////////////////////////////////////////////////////////////////////////////////////////
     class OOGLHandlerFactory
@@ -83,7 +100,8 @@ namespace oogl
         ///! \param library                Label associated to the library to use, the library
         ///!                               handler will get created according to the chosen library.
         ///! \throw oogl::OOGLException    When the factory is asked to create a new graphic
-        ///!                               library handler instance while there already is one.
+        ///!                               library handler instance while there already is one,
+        ///!                               or when the library is not a supported one.
         ///! \version                      1.0.0
         ////////////////////////////////////////////////////////////////////////////////////////////
         void createGraphicLibraryHandler(oogl::GraphicLibrary library);
@@ -97,17 +115,114 @@ namespace oogl
         void destroyGraphicLibraryHandler();
 
         ////////////////////////////////////////////////////////////////////////////////////////////
-        ///! \brief                        Get a reference to the unique graphic library handler.
+        ///! \brief            Register the plugin of a library : the shared object is loaded when
+        ///!                   the first handler of the library gets created. By default, the
+        ///!                   software library is built in, unless OOGL_NO_BUILTIN_SOFTWARE is
+        ///!                   defined when building, and is then the plugin liboogl-software.so ;
+        ///!                   the null library is the plugin liboogl-null.so.
+        ///! \param library    Label associated to the library.
+        ///! \param path       Path of the shared object, searched as dlopen does when it has no
+        ///!                   slash ; an empty path makes a library built in again.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void registerGraphicLibrary(oogl::GraphicLibrary library, std::string const & path);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Tell whether the plugin of a library is currently loaded.
+        ///! \param library    Label associated to the library.
+        ///! \return           true if the shared object of the library is loaded, false if it is
+        ///!                   not, or if the library is built in.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        bool isGraphicLibraryLoaded(oogl::GraphicLibrary library) const noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Create a graphic library handler isolated from the
+        ///!                               others : it is not stored by the factory, and is only
+        ///!                               given to the threads which select it as their current
+        ///!                               handler, and to its own worker threads.
+        ///! \param library                Label associated to the library to use.
+        ///! \return                       A reference to the new handler.
+        ///! \throw oogl::OOGLException    When the library is not a supported one.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        oogl::OOGLHandler & createIsolatedHandler(oogl::GraphicLibrary library);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Destroy an isolated graphic library handler. It stops being the
+        ///!                   current handler of the calling thread ; the other threads must have
+        ///!                   selected another one before.
+        ///! \param handler    Handler created by <code>createIsolatedHandler()</code>.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void destroyIsolatedHandler(oogl::OOGLHandler & handler) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Select the handler the calling thread works for.
+        ///! \param handler    Handler, or nullptr to use the unique graphic library handler again.
+        ///! \return           The former current handler of the thread, to restore it afterwards.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        oogl::OOGLHandler * setCurrentHandler(oogl::OOGLHandler * handler) const noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Get a reference to the current handler of the calling
+        ///!                               thread, or else to the unique graphic library handler.
         ///! \return                       A reference to the instanciated graphic library handler.
         ///! \throw oogl::OOGLException    When no graphic library handlers have been created.
         ///! \version                      1.0.0
         ////////////////////////////////////////////////////////////////////////////////////////////
         oogl::OOGLHandler & getGraphicLibraryHandler() const;
 
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief     Non-throwing version of getGraphicLibraryHandler(), for the hot paths.
+        ///! \return    A reference to the instanciated graphic library handler, or the error code
+        ///!            OOGL_HANDLER_NOT_CREATED when no graphic library handlers have been created.
+        ///! \version   1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        oogl::Result<oogl::OOGLHandler &> tryGetGraphicLibraryHandler() const noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Get the current handler as its actual backend type, so
+        ///!                               that its calls are bound at compile time. The check is
+        ///!                               done once here : keep the reference for the hot loops.
+        ///! \tparam Backend               Final handler class of the backend.
+        ///! \return                       A reference to the handler, as a Backend instance.
+        ///! \throw oogl::OOGLException    When no graphic library handlers have been created, or
+        ///!                               when the handler is not a Backend one.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        template <typename Backend>
+        inline Backend & getGraphicLibraryHandler() const
+        {
+            Backend * const handler = dynamic_cast<Backend *>(&getGraphicLibraryHandler());
+            if (handler == nullptr) { OOGL_THROW(oogl::ExceptionCode::HANDLER_BACKEND_MISMATCH); }
+            return *handler;
+        }
+
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief      Construct a handler for the entry point of a plugin ; to be used through
+        ///!             OOGL_PLUGIN only.
+        ///! \tparam     Handler    Handler class of the plugin, friend of the factory.
+        ///! \return     A pointer to the new handler.
+        ///! \version    1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        template <typename Handler>
+        static inline oogl::OOGLHandler * constructPluginHandler()    { return new Handler(); }
+
 
 
         private:
 
+        // Create a handler of the given library, loading its plugin if need be.
+        static oogl::OOGLHandler * newHandler(oogl::GraphicLibrary library);
+
+        // Destroy a handler, unloading its plugin with its last handler.
+        static void deleteHandler(oogl::OOGLHandler * handler) noexcept;
+
+
         static oogl::OOGLHandler *   s_graphicLibraryHandler;  ///!< Instance of the unique handler
 
 
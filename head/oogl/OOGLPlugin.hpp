@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     OOGLPlugin.hpp
+///! \brief    This file contains the declaration of the entry points of the library plugins. A
+///!           plugin is a shared object implementing a graphic library handler : it defines its
+///!           entry points through OOGL_PLUGIN, and the factory loads it with the first handler
+///!           of its library.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::OOGLHandlerFactory
+///!
+///! <p>A plugin is built as position independent code, and its undefined symbols are the ones of
+///! the framework : the executable links the framework as a shared library, or exports its
+///! symbols (-rdynamic).</p>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                // Non standard include guard
+
+#ifndef OOGL_OOGLPLUGIN_HPP_INCLUDED        // Standard include guard
+#define OOGL_OOGLPLUGIN_HPP_INCLUDED
+
+
+// Project include list
+#include "OOGLHandler.hpp"
+#include "OOGLHandlerFactory.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \brief    OOGL_PLUGIN_ABI_VERSION is the version of the plugin interface : the factory does
+///!           not load the plugins built for another one. It changes along with the layout of
+///!           oogl::OOGLHandler.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#define OOGL_PLUGIN_ABI_VERSION    3u
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \brief    OOGL_PLUGIN_EXPORT makes an entry point visible, whichever the default visibility of
+///!           the plugin symbols.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#if defined(__GNUC__)
+#define OOGL_PLUGIN_EXPORT    __attribute__((visibility("default")))
+#else
+#define OOGL_PLUGIN_EXPORT
+#endif
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \brief    OOGL_PLUGIN(Handler) defines the entry points of a plugin whose handler class is
+///!           Handler. The class is a friend of oogl::OOGLHandlerFactory, as the built in ones.
+///!           To be used once, at global scope, in a source file of the plugin.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#define OOGL_PLUGIN(Handler)                                                                       \
+    extern "C" OOGL_PLUGIN_EXPORT unsigned int oogl_plugin_abi_version()                           \
+    {                                                                                              \
+        return OOGL_PLUGIN_ABI_VERSION;                                                            \
+    }                                                                                              \
+                                                                                                   \
+    extern "C" OOGL_PLUGIN_EXPORT oogl::OOGLHandler * oogl_plugin_create_handler()                 \
+    {                                                                                              \
+        return oogl::OOGLHandlerFactory::constructPluginHandler<Handler>();                        \
+    }
+
+
+
+#endif    // OOGL_OOGLPLUGIN_HPP_INCLUDED
@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     Profiler.hpp
+///! \brief    This file contains the declaration of the class oogl::Profiler and its features.
+///!           The class oogl::Profiler records the time spent in scoped zones into per-thread
+///!           rings, and exports them as a Chrome trace. The zones are declared through the
+///!           OOGL_PROFILE_ZONE macro, which expands to nothing unless OOGL_ENABLE_PROFILER is
+///!           defined when building : builds without profiler pay no cost at all.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                              // Non standard include guard
+
+#ifndef OOGL_PROFILER_HPP_INCLUDED        // Standard include guard
+#define OOGL_PROFILER_HPP_INCLUDED
+
+
+// Standard include list
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \brief    OOGL_PROFILE_ZONE(name) declares a profiling zone lasting until the end of the
+///!           enclosing scope ; the name must be a string literal, or live as long.
+///!           OOGL_PROFILE_THREAD(name) names the calling thread in the traces.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#if defined(OOGL_ENABLE_PROFILER)
+#define OOGL_PROFILE_CONCAT_(first, second)    first##second
+#define OOGL_PROFILE_CONCAT(first, second)     OOGL_PROFILE_CONCAT_(first, second)
+#define OOGL_PROFILE_ZONE(name)                                                                    \
+    oogl::ProfileZone const OOGL_PROFILE_CONCAT(oogl_profile_zone_, __LINE__)(name)
+#define OOGL_PROFILE_THREAD(name)              oogl::Profiler::setThreadName(name)
+#else
+#define OOGL_PROFILE_ZONE(name)
+#define OOGL_PROFILE_THREAD(name)
+#endif
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl Profiler.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    Profiler Profiler.hpp
+    ///! \brief    Static class gathering the profiling records. Each thread writes its zones into
+    ///!           its own ring, without lock nor allocation, the oldest records being overwritten
+    ///!           once the ring is full. The exporter reads the rings of every thread, including
+    ///!           the ended ones, and skips the records overwritten meanwhile.
+    ///! \version  1.0.0
+    ///! \see      oogl::ProfileZone
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class Profiler
+    {
+        public:
+
+        static constexpr std::size_t RING_CAPACITY = 1 << 14;    ///!< Records kept per thread.
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the current time of the profiler clock.
+        ///! \return   The time, in nanoseconds of the steady clock.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        static inline uint64_t now() noexcept
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Give the calling thread its ring, unless it already has one. This is the only
+        ///!           allocation of the profiler on the thread : the zones call it when entered.
+        ///! \return   True when the thread has a ring, false when it could not be allocated.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        static bool attachThread() noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Record a zone into the ring of the calling thread ; the zone is
+        ///!                   dropped when the thread has no ring.
+        ///! \param name       Name of the zone.
+        ///! \param start      Time the zone got entered.
+        ///! \param end        Time the zone got left.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        static void record(char const * name, uint64_t start, uint64_t end) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Name the calling thread in the exported traces.
+        ///! \param name       Name of the thread.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        static void setThreadName(std::string const & name);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Forget the records made so far, of every thread.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        static void clear() noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Write the records as a Chrome trace, to load in chrome://tracing or
+        ///!                   in Perfetto.
+        ///! \param stream     Stream receiving the JSON document.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        static void writeChromeTrace(std::ostream & stream);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Write the records as a Chrome trace file.
+        ///! \param path                   Path of the file to create.
+        ///! \throw oogl::OOGLException    When the file cannot be written.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        static void exportChromeTrace(std::string const & path);
+
+        // Static class : no instance
+        Profiler() = delete;
+
+    };
+
+
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    ProfileZone Profiler.hpp
+    ///! \brief    Scoped zone : it takes the time when built, and records the zone when destroyed.
+    ///!           Declared through the OOGL_PROFILE_ZONE macro.
+    ///! \version  1.0.0
+    ///! \see      oogl::Profiler
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class ProfileZone
+    {
+        public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief         Class constructor : enter the zone, once the thread has its ring.
+        ///! \param name    Name of the zone.
+        ///! \version       1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        explicit ProfileZone(char const * name) noexcept :
+        m_name(name), m_start(0)
+        {
+            oogl::Profiler::attachThread();
+            m_start = oogl::Profiler::now();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class destructor : leave the zone.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ~ProfileZone() noexcept
+        {
+            oogl::Profiler::record(m_name, m_start, oogl::Profiler::now());
+        }
+
+        // A zone is bound to its scope : no copy
+        ProfileZone(ProfileZone const &) = delete;
+        ProfileZone & operator=(ProfileZone const &) = delete;
+
+
+
+        private:
+
+        char const *    m_name;     ///!< Name of the zone.
+        uint64_t        m_start;    ///!< Time the zone got entered.
+
+    };
+
+}
+
+
+
+#endif    // OOGL_PROFILER_HPP_INCLUDED
@@ -0,0 +1,332 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     Result.hpp
+///! \brief    This file contains the declaration of the class template oogl::Result and its
+///!           features. The class oogl::Result is the non-throwing way of the framework to report
+///!           errors : it holds either a value, or the oogl::ExceptionCode of the error, without
+///!           any allocation, so that the hot paths check errors at the cost of a comparison.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                            // Non standard include guard
+
+#ifndef OOGL_RESULT_HPP_INCLUDED        // Standard include guard
+#define OOGL_RESULT_HPP_INCLUDED
+
+
+// Standard include list
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Project include list
+#include "OOGLException.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl Result.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    Result Result.hpp
+    ///! \brief    Value of type T, or code of the error which prevented to get it. The code is
+    ///!           oogl::ExceptionCode::NO_EXCEPTION when the result holds a value. Getting the
+    ///!           value of an error reports it through OOGL_THROW ; the dereference operators do
+    ///!           not check, and must only be used once the result has been tested.
+    ///!           References are held as pointers, and Result<void> only holds the code.
+    ///! \version  1.0.0
+    ///! \see      oogl::ExceptionCode
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    class Result
+    {
+        static_assert(! std::is_same<typename std::decay<T>::type, oogl::ExceptionCode>::value,
+                      "A result cannot hold an exception code as a value.");
+
+        public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief          Class constructor of a successful result.
+        ///! \param value    Value of the result.
+        ///! \version        1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        Result(T const & value) noexcept(std::is_nothrow_copy_constructible<T>::value) :
+        m_code(oogl::ExceptionCode::NO_EXCEPTION), m_value(value)
+        {}
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief          Class constructor of a successful result.
+        ///! \param value    Value of the result, moved into it.
+        ///! \version        1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        Result(T && value) noexcept(std::is_nothrow_move_constructible<T>::value) :
+        m_code(oogl::ExceptionCode::NO_EXCEPTION), m_value(std::move(value))
+        {}
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief         Class constructor of a failed result. NO_EXCEPTION gives no value : it
+        ///!                becomes oogl::ExceptionCode::RESULT_WITHOUT_VALUE.
+        ///! \param code    Code of the error.
+        ///! \version       1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        Result(oogl::ExceptionCode code) noexcept :
+        m_code(code == oogl::ExceptionCode::NO_EXCEPTION ? oogl::ExceptionCode::RESULT_WITHOUT_VALUE
+                                                         : code)
+        {}
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief              Copy constructor.
+        ///! \param instance     Instance to copy.
+        ///! \version            1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        Result(Result const & instance) noexcept(std::is_nothrow_copy_constructible<T>::value) :
+        m_code(instance.m_code)
+        {
+            if (hasValue()) { new (&m_value) T(instance.m_value); }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief              Move constructor.
+        ///! \param instance     Instance to move into the new one.
+        ///! \version            1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        Result(Result && instance) noexcept(std::is_nothrow_move_constructible<T>::value) :
+        m_code(instance.m_code)
+        {
+            if (hasValue()) { new (&m_value) T(std::move(instance.m_value)); }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class destructor.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ~Result() noexcept
+        {
+            if (hasValue()) { m_value.~T(); }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief              Copy assignment operator. The code only changes once the value
+        ///!                     is copied : when the copy throws, the result is left as it was,
+        ///!                     or failed.
+        ///! \param instance     Instance whose value or error gets copied.
+        ///! \return             A reference to the calling instance.
+        ///! \version            1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        Result & operator=(Result const & instance)
+            noexcept(std::is_nothrow_copy_constructible<T>::value
+                     && std::is_nothrow_copy_assignable<T>::value)
+        {
+            if (this == &instance) {
+                return *this;
+            }
+
+            if (instance.hasValue()) {
+                if (hasValue()) {    // value to value
+                    m_value = instance.m_value;
+                } else {
+                    new (&m_value) T(instance.m_value);
+                    m_code = oogl::ExceptionCode::NO_EXCEPTION;
+                }
+            } else {
+                if (hasValue()) { m_value.~T(); }
+                m_code = instance.m_code;
+            }
+
+            return *this;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief              Move assignment operator. The code only changes once the value
+        ///!                     is moved : when the move throws, the result is left as it was,
+        ///!                     or failed.
+        ///! \param instance     Instance whose value or error gets moved.
+        ///! \return             A reference to the calling instance.
+        ///! \version            1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        Result & operator=(Result && instance)
+            noexcept(std::is_nothrow_move_constructible<T>::value
+                     && std::is_nothrow_move_assignable<T>::value)
+        {
+            if (this == &instance) {
+                return *this;
+            }
+
+            if (instance.hasValue()) {
+                if (hasValue()) {    // value to value
+                    m_value = std::move(instance.m_value);
+                } else {
+                    new (&m_value) T(std::move(instance.m_value));
+                    m_code = oogl::ExceptionCode::NO_EXCEPTION;
+                }
+            } else {
+                if (hasValue()) { m_value.~T(); }
+                m_code = instance.m_code;
+            }
+
+            return *this;
+        }
+
+        // Getters
+        inline bool hasValue() const noexcept
+        { return m_code == oogl::ExceptionCode::NO_EXCEPTION; }
+        inline explicit operator bool() const noexcept             { return hasValue(); }
+        inline oogl::ExceptionCode getCode() const noexcept         { return m_code; }
+        inline char const * getMessage() const noexcept
+        { return oogl::OOGLException::getMessageFromCode(m_code); }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Get the value of a successful result.
+        ///! \return                       The value.
+        ///! \throw oogl::OOGLException    With the code of the error, when the result failed.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline T & getValue() &                { check(); return m_value; }
+        inline T const & getValue() const &    { check(); return m_value; }
+        inline T && getValue() &&              { check(); return std::move(m_value); }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief             Get the value of a successful result, or a fallback value.
+        ///! \param fallback    Value returned when the result failed.
+        ///! \return            The value or the fallback one.
+        ///! \version           1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        template <typename U>
+        inline T getValueOr(U && fallback) const &
+        { return hasValue() ? m_value : static_cast<T>(std::forward<U>(fallback)); }
+
+        // Unchecked access to the value of a successful result
+        inline T & operator*() noexcept                { return m_value; }
+        inline T const & operator*() const noexcept    { return m_value; }
+        inline T * operator->() noexcept               { return &m_value; }
+        inline T const * operator->() const noexcept   { return &m_value; }
+
+
+
+        private:
+
+        // Report the error of a failed result.
+        inline void check() const
+        {
+            if (! hasValue()) { OOGL_THROW(m_code); }
+        }
+
+
+        oogl::ExceptionCode    m_code;     ///!< Error code, NO_EXCEPTION when there is a value.
+
+        union
+        {
+            T                  m_value;    ///!< Value, only alive when there is no error.
+        };
+
+    };
+
+
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    Result Result.hpp
+    ///! \brief    Reference to an object, or code of the error which prevented to get it.
+    ///! \version  1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    class Result<T &>
+    {
+        public:
+
+        // Class constructors of a successful and of a failed result, NO_EXCEPTION giving no value
+        Result(T & value) noexcept :
+        m_code(oogl::ExceptionCode::NO_EXCEPTION), m_value(&value)
+        {}
+
+        Result(oogl::ExceptionCode code) noexcept :
+        m_code(code == oogl::ExceptionCode::NO_EXCEPTION ? oogl::ExceptionCode::RESULT_WITHOUT_VALUE
+                                                         : code),
+        m_value(nullptr)
+        {}
+
+        // Getters
+        inline bool hasValue() const noexcept
+        { return m_code == oogl::ExceptionCode::NO_EXCEPTION; }
+        inline explicit operator bool() const noexcept         { return hasValue(); }
+        inline oogl::ExceptionCode getCode() const noexcept     { return m_code; }
+        inline char const * getMessage() const noexcept
+        { return oogl::OOGLException::getMessageFromCode(m_code); }
+
+        // Checked and unchecked access to the referenced object
+        inline T & getValue() const
+        {
+            if (! hasValue()) { OOGL_THROW(m_code); }
+            return *m_value;
+        }
+        inline T & operator*() const noexcept     { return *m_value; }
+        inline T * operator->() const noexcept    { return m_value; }
+
+
+
+        private:
+
+        oogl::ExceptionCode    m_code;     ///!< Error code, NO_EXCEPTION when there is a reference.
+        T *                    m_value;    ///!< Referenced object, nullptr when there is an error.
+
+    };
+
+
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    Result Result.hpp
+    ///! \brief    Outcome of an operation without value : success, or code of the error.
+    ///! \version  1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    template <>
+    class Result<void>
+    {
+        public:
+
+        // Class constructors of a successful and of a failed result
+        Result() noexcept :
+        m_code(oogl::ExceptionCode::NO_EXCEPTION)
+        {}
+
+        Result(oogl::ExceptionCode code) noexcept :
+        m_code(code)
+        {}
+
+        // Getters
+        inline bool hasValue() const noexcept
+        { return m_code == oogl::ExceptionCode::NO_EXCEPTION; }
+        inline explicit operator bool() const noexcept         { return hasValue(); }
+        inline oogl::ExceptionCode getCode() const noexcept     { return m_code; }
+        inline char const * getMessage() const noexcept
+        { return oogl::OOGLException::getMessageFromCode(m_code); }
+
+        // Report the error of a failed result, if any
+        inline void getValue() const
+        {
+            if (! hasValue()) { OOGL_THROW(m_code); }
+        }
+
+
+
+        private:
+
+        oogl::ExceptionCode    m_code;     ///!< Error code, NO_EXCEPTION on success.
+
+    };
+
+}
+
+
+
+#endif    // OOGL_RESULT_HPP_INCLUDED
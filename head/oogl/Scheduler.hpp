@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     Scheduler.hpp
+///! \brief    This file contains the declaration of the class oogl::Scheduler and its features.
+///!           The class oogl::Scheduler resumes the work waiting for an event, a timer or a load
+///!           on the thread of the main loop, and pools the frames of the coroutines it resumes.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                               // Non standard include guard
+
+#ifndef OOGL_SCHEDULER_HPP_INCLUDED        // Standard include guard
+#define OOGL_SCHEDULER_HPP_INCLUDED
+
+
+// Standard include list
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Project include list
+#include "Event.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl Scheduler.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \struct   Continuation Scheduler.hpp
+    ///! \brief    Work the scheduler resumes : a function called with its context. A coroutine is
+    ///!           resumed through the address of its handle.
+    ///! \version  1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    struct Continuation
+    {
+        void (*function)(void * context);    ///!< Function resuming the work.
+        void *  context;                     ///!< Argument of the function.
+    };
+
+    // Typedef to remove the struct keyword from the type
+    typedef struct Continuation Continuation;
+
+
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    Scheduler Scheduler.hpp
+    ///! \brief    Scheduler of the continuations of the main loop. The continuations get ready
+    ///!           when posted, from any thread, or when the event they wait for gets dispatched,
+    ///!           and the main loop resumes the ready ones through <code>run()</code>, so that
+    ///!           they always run on its thread.
+    ///!           The scheduler also pools the frames of the coroutines : the frames up to 4 KB
+    ///!           are taken from free lists of seven size classes, carved out of chunks of 64 KB,
+    ///!           so that once the chunks are there, starting, suspending and resuming a coroutine
+    ///!           allocates nothing. The larger frames go to the heap.
+    ///! \version  1.0.0
+    ///! \see      oogl::Task
+    ///!
+    ///! <p>Apart from <code>post()</code>, the methods must only be called from the thread of the
+    ///! main loop, which allocates and releases the frames. The coroutines still suspended when
+    ///! the scheduler gets destroyed are dropped without being resumed ; the pool outlives the
+    ///! scheduler until its last frame is released, so that a task may still be destroyed.</p>
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class Scheduler
+    {
+        public:
+
+        static constexpr std::size_t FRAME_CLASSES = 7;          ///!< Pooled sizes, 64 B to 4 KB.
+        static constexpr std::size_t MIN_FRAME     = 64;         ///!< Size of the first class.
+        static constexpr std::size_t CHUNK_SIZE    = 1 << 16;    ///!< Memory carved into frames.
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class constructor.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        Scheduler();
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class destructor : the pool is freed, or left to its live frames.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ~Scheduler() noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                  Make a continuation ready. Can be called from any thread,
+        ///!                         a timer callback or a task of the worker pool.
+        ///! \param continuation     Work to resume on the next run.
+        ///! \version                1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void post(oogl::Continuation continuation);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                  Keep a continuation until an event of a window gets
+        ///!                         dispatched.
+        ///! \param window           Identifier of the window, 0 for the events of any window.
+        ///! \param event            Event receiving the dispatched one.
+        ///! \param continuation     Work to resume once the event is received.
+        ///! \version                1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void waitEvent(uint32_t window, oogl::Event * event, oogl::Continuation continuation);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief          Hand an event to the continuations waiting for it, which get ready.
+        ///!                 To be called by the main loop with each event it drains.
+        ///! \param event    Drained event.
+        ///! \return         The number of continuations the event got handed to.
+        ///! \version        1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        std::size_t dispatch(oogl::Event const & event);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Resume the continuations ready when called ; the ones
+        ///!                               they make ready wait for the next run.
+        ///! \return                       The number of resumed continuations.
+        ///! \throw std::exception         The exception which ended a spawned coroutine, once the
+        ///!                               other continuations have been resumed.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        std::size_t run();
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Keep the exception which ended a spawned coroutine, to be thrown by
+        ///!                   the current run.
+        ///! \param failure    Exception of the coroutine.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline void fail(std::exception_ptr failure) noexcept    { m_failure = failure; }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief          Allocate the frame of a coroutine, from the pool when it fits in a
+        ///!                 size class.
+        ///! \param size     Size of the frame.
+        ///! \return         The frame, aligned as by operator new.
+        ///! \version        1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void * allocateFrame(std::size_t size);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief          Release a frame allocated by a scheduler, even a destroyed one.
+        ///! \param frame    Frame to release.
+        ///! \param size     Size it was allocated with.
+        ///! \version        1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        static void releaseFrame(void * frame, std::size_t size) noexcept;
+
+        // Getters
+        inline std::size_t getWaitingCount() const noexcept    { return m_waiters.size(); }
+        inline std::size_t getFrameCount() const noexcept      { return m_pool->frameCount; }
+        inline std::size_t getPooledSize() const noexcept
+        { return m_pool->chunks.size() * CHUNK_SIZE; }
+
+        // The scheduler owns its pool : no copy
+        Scheduler(Scheduler const &) = delete;
+        Scheduler & operator=(Scheduler const &) = delete;
+
+
+
+        private:
+
+        static constexpr std::size_t FRAME_HEADER = 16;    ///!< Header keeping the pool.
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Continuation waiting for an event.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct Waiter
+        {
+            uint32_t              window;          ///!< Window of the event, 0 for any.
+            oogl::Event *         event;           ///!< Receiver of the event.
+            oogl::Continuation    continuation;    ///!< Work to resume.
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Released frame, linked into the free list of its class.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct FreeFrame
+        {
+            FreeFrame *    next;    ///!< Next free frame of the class.
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Pool of the frames, on the heap, so that it outlives the scheduler as long
+        ///!         as frames of it are alive.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct FramePool
+        {
+            FreeFrame *                             freeFrames[FRAME_CLASSES];  ///!< Free lists.
+            std::vector<std::unique_ptr<char[]>>    chunks;                     ///!< Memory.
+            std::size_t                             frameCount;                 ///!< Live frames.
+            bool                                    isOrphan;                   ///!< No scheduler.
+        };
+
+        // Size class of a frame, with its header ; FRAME_CLASSES for the larger ones.
+        static std::size_t getFrameClass(std::size_t size) noexcept;
+
+
+        std::vector<oogl::Continuation>         m_ready;                        ///!< To resume.
+        std::vector<oogl::Continuation>         m_running;                      ///!< Resumed.
+        std::mutex                              m_inboxMutex;                   ///!< Inbox lock.
+        std::vector<oogl::Continuation>         m_inbox;                        ///!< Posted.
+        std::atomic<bool>                       m_hasPosted;                    ///!< Inbox used.
+        std::vector<Waiter>                     m_waiters;                      ///!< Wait events.
+        std::exception_ptr                      m_failure;                      ///!< Of a spawn.
+        FramePool *                             m_pool;                         ///!< Frames.
+
+    };
+
+}
+
+
+
+#endif    // OOGL_SCHEDULER_HPP_INCLUDED
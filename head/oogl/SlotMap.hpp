@@ -0,0 +1,241 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     SlotMap.hpp
+///! \brief    This file contains the declaration and the definition of the class template
+///!           oogl::SlotMap and its features. The class template oogl::SlotMap stores values in a
+///!           contiguous array and hands out generational handles to reach them in constant time.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                             // Non standard include guard
+
+#ifndef OOGL_SLOTMAP_HPP_INCLUDED        // Standard include guard
+#define OOGL_SLOTMAP_HPP_INCLUDED
+
+
+// Standard include list
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl SlotMap.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    #ifndef OOGL_SLOTHANDLE_STRUCT_DEFINED        // Guarantee the structure is only defined once
+    #define OOGL_SLOTHANDLE_STRUCT_DEFINED
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \struct   SlotHandle SlotMap.hpp
+    ///! \brief    Handle of a value stored in a oogl::SlotMap : the index of its slot, and the
+    ///!           generation of the slot when the value got inserted. Once the value is erased,
+    ///!           the generation of the slot changes and the handle becomes stale.
+    ///! \version  1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    struct SlotHandle
+    {
+        uint32_t index;
+        uint32_t generation;
+    };
+
+    // Typedef to remove the struct keyword from the type
+    typedef struct SlotHandle SlotHandle;
+
+    // Handle never given by a slot map.
+    constexpr SlotHandle INVALID_SLOT_HANDLE = { UINT32_MAX, UINT32_MAX };
+
+    #endif    // OOGL_SLOTHANDLE_STRUCT_DEFINED
+
+
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    SlotMap SlotMap.hpp
+    ///! \brief    Container of values reached through generational handles. The values are kept
+    ///!           contiguous, so that iterating over them is a linear scan ; erasing moves the
+    ///!           last value into the hole. The slots indirect the handles to the values, and the
+    ///!           free slots are chained into a list to get reused. Insertion, erasure and access
+    ///!           are done in constant time, without allocation once the capacity is reached.
+    ///! \tparam   T    Type of the stored values.
+    ///! \version  1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    class SlotMap
+    {
+        public:
+
+        typedef typename std::vector<T>::iterator          iterator;
+        typedef typename std::vector<T>::const_iterator    const_iterator;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class constructor : the map is empty.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        SlotMap() :
+        m_slots(), m_values(), m_owners(), m_freeHead(NO_SLOT)
+        {}
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Store a value.
+        ///! \param value      Value to store.
+        ///! \return           The handle of the stored value.
+        ///! \throw            std::bad_alloc when the map cannot grow ; it is then left unchanged.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        SlotHandle insert(T value)
+        {
+            // Room is made before any change, so that a failed allocation changes nothing
+            if (m_freeHead == NO_SLOT) { makeRoom(m_slots); }
+            makeRoom(m_values);
+            makeRoom(m_owners);
+
+            uint32_t index = m_freeHead;
+
+            if (index == NO_SLOT) {                  // no free slot : add one
+                index = static_cast<uint32_t>(m_slots.size());
+                m_slots.push_back(Slot { 0, 0 });
+            } else {                                 // reuse the first free slot
+                m_freeHead = m_slots[index].target;
+            }
+
+            m_slots[index].target = static_cast<uint32_t>(m_values.size());
+            m_values.push_back(std::move(value));
+            m_owners.push_back(index);
+
+            return SlotHandle { index, m_slots[index].generation };
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Erase the value of a handle.
+        ///! \param handle     Handle of the value to erase.
+        ///! \return           true if the value got erased, false if the handle was stale.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        bool erase(SlotHandle handle)
+        {
+            if (! contains(handle)) {
+                return false;
+            }
+
+            Slot &         slot = m_slots[handle.index];
+            uint32_t const hole = slot.target;
+
+            // Fill the hole with the last value
+            m_values[hole] = std::move(m_values.back());
+            m_owners[hole] = m_owners.back();
+            m_slots[m_owners[hole]].target = hole;
+            m_values.pop_back();
+            m_owners.pop_back();
+
+            // Make the handles of the slot stale, and chain it to the free list
+            slot.generation++;
+            slot.target = m_freeHead;
+            m_freeHead  = handle.index;
+
+            return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Tell whether a handle refers to a stored value.
+        ///! \param handle     Handle to test.
+        ///! \return           true if the handle is valid, false if it is stale or invalid.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        bool contains(SlotHandle handle) const noexcept
+        {
+            return handle.index < m_slots.size()
+                && m_slots[handle.index].generation == handle.generation;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Get the value of a handle.
+        ///! \param handle     Handle of the value.
+        ///! \return           A pointer to the value, nullptr if the handle is stale.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        T * get(SlotHandle handle) noexcept
+        {
+            return contains(handle) ? &m_values[m_slots[handle.index].target] : nullptr;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Erase every value ; every handle given so far becomes stale.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void clear()
+        {
+            while (! m_owners.empty()) {
+                erase(SlotHandle { m_owners.back(), m_slots[m_owners.back()].generation });
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Reserve the memory for a number of values.
+        ///! \param count      Number of values.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void reserve(std::size_t count)
+        {
+            m_slots.reserve(count);
+            m_values.reserve(count);
+            m_owners.reserve(count);
+        }
+
+        // Dense access to the stored values, in no particular order.
+        inline std::size_t size() const noexcept       { return m_values.size(); }
+        inline bool empty() const noexcept             { return m_values.empty(); }
+        inline T & back() noexcept                     { return m_values.back(); }
+        inline iterator begin() noexcept               { return m_values.begin(); }
+        inline iterator end() noexcept                 { return m_values.end(); }
+        inline const_iterator begin() const noexcept   { return m_values.begin(); }
+        inline const_iterator end() const noexcept     { return m_values.end(); }
+
+
+
+        private:
+
+        static constexpr uint32_t NO_SLOT = UINT32_MAX;    ///!< End of the free slot list.
+
+        // Make room for one more element, growing the capacity geometrically.
+        template <typename U>
+        static void makeRoom(std::vector<U> & vector)
+        {
+            if (vector.size() == vector.capacity()) {
+                vector.reserve(vector.empty() ? 16 : vector.size() * 2);
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Slot : index of its value when used, index of the next free slot otherwise.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct Slot
+        {
+            uint32_t target;
+            uint32_t generation;
+        };
+
+
+        std::vector<Slot>        m_slots;       ///!< Slots, indexed by the handles.
+        std::vector<T>           m_values;      ///!< Contiguous stored values.
+        std::vector<uint32_t>    m_owners;      ///!< Slot of each value, to update on moves.
+        uint32_t                 m_freeHead;    ///!< First free slot.
+
+    };
+
+}
+
+
+
+#endif    // OOGL_SLOTMAP_HPP_INCLUDED
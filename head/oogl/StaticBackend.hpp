@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     StaticBackend.hpp
+///! \brief    This file contains the declaration and the definition of the class template
+///!           oogl::BackendWindow, and the selection of the backend at compile time. The windows
+///!           and the handler of a backend known at compile time are used through their final
+///!           classes : their calls are bound statically, and inlined, while the virtual
+///!           interface of oogl::Window and oogl::OOGLHandler remains for the plugins.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///!
+///! <p>The backend is the one of the software library, unless OOGL_STATIC_BACKEND is defined
+///! when building, as the final handler class of another backend, whose header is then included
+///! before this one.</p>
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                   // Non standard include guard
+
+#ifndef OOGL_STATICBACKEND_HPP_INCLUDED        // Standard include guard
+#define OOGL_STATICBACKEND_HPP_INCLUDED
+
+
+// Standard include list
+#include <type_traits>
+
+// Project include list
+#include "OOGLException.hpp"
+#include "OOGLHandler.hpp"
+#include "OOGLHandlerFactory.hpp"
+#include "Window.hpp"
+
+#if ! defined(OOGL_STATIC_BACKEND)
+#include "software/SoftwareHandler.hpp"
+#define OOGL_STATIC_BACKEND    oogl::software::SoftwareHandler
+#endif
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl StaticBackend.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    BackendWindow StaticBackend.hpp
+    ///! \brief    Window of a backend known at compile time. The class is final : the property,
+    ///!           drawing and damage calls made on a BackendWindow are bound statically to the
+    ///!           definitions of oogl::Window, and inlined. It is tracked by a handler of the
+    ///!           backend, which it gives back with its actual type.
+    ///! \tparam   Backend    Final handler class of the backend.
+    ///! \version  1.0.0
+    ///! \see      oogl::Window
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename Backend>
+    class BackendWindow final : public oogl::Window
+    {
+        static_assert(std::is_base_of<oogl::OOGLHandler, Backend>::value,
+                      "The backend must be a graphic library handler.");
+        static_assert(std::is_final<Backend>::value,
+                      "The backend must be final for its calls to be bound statically.");
+
+        public:
+
+        // Class constructors of oogl::Window
+        using oogl::Window::Window;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Initialize the window, as oogl::Window does, then check
+        ///!                               it is tracked by a handler of the backend.
+        ///! \throw oogl::OOGLException    When there is a failure in the initialization process,
+        ///!                               or when the handler of the thread is not a Backend one.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        virtual void init() override
+        {
+            oogl::Window::init();
+
+            if (dynamic_cast<Backend *>(getHandler()) == nullptr) {    // another backend
+                oogl::Window::free();
+                OOGL_THROW(oogl::ExceptionCode::HANDLER_BACKEND_MISMATCH);
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the handler tracking the window, as a Backend instance.
+        ///! \return   A reference to the handler ; the window must be initialized.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline Backend & getBackend() const noexcept
+        { return static_cast<Backend &>(*getHandler()); }
+
+    };
+
+
+    typedef OOGL_STATIC_BACKEND                        StaticHandler;   ///!< Selected backend.
+    typedef oogl::BackendWindow<oogl::StaticHandler>   StaticWindow;    ///!< Its windows.
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \brief                        Get the handler of the calling thread as a handler of the
+    ///!                               backend selected at compile time.
+    ///! \return                       A reference to the handler.
+    ///! \throw oogl::OOGLException    When no graphic library handlers have been created, or when
+    ///!                               the handler is not of the selected backend.
+    ///! \version                      1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    inline oogl::StaticHandler & getStaticHandler()
+    {
+        return oogl::OOGLHandlerFactory().getGraphicLibraryHandler<oogl::StaticHandler>();
+    }
+
+}
+
+
+
+#endif    // OOGL_STATICBACKEND_HPP_INCLUDED
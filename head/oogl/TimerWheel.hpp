@@ -0,0 +1,222 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     TimerWheel.hpp
+///! \brief    This file contains the declaration of the class oogl::TimerWheel and its features.
+///!           The class oogl::TimerWheel is the timer service of the timer subsystem : a
+///!           hierarchical timing wheel scheduling, cancelling and firing timers in constant time.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                // Non standard include guard
+
+#ifndef OOGL_TIMERWHEEL_HPP_INCLUDED        // Standard include guard
+#define OOGL_TIMERWHEEL_HPP_INCLUDED
+
+
+// Standard include list
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Project include list
+#include "Event.hpp"
+#include "SlotMap.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl TimerWheel.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    // Forward classes declaration
+    class EventQueue;
+    class WorkerPool;
+
+
+    // Handle of a scheduled timer : it gets stale once the timer is cancelled or has fired.
+    typedef oogl::SlotHandle TimerHandle;
+
+    // Function called when a timer fires, with the timer handle and the data given at scheduling.
+    typedef void (*TimerCallback)(oogl::TimerHandle timer, uint64_t data);
+
+
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    TimerWheel TimerWheel.hpp
+    ///! \brief    Hierarchical timing wheel. The time goes by ticks ; the timers are hashed into
+    ///!           four wheels of 256 slots, the first one holding the timers expiring within 256
+    ///!           ticks, and each next one covering 256 times as many ticks. When the first wheel
+    ///!           completes a turn, the next slot of the upper wheel gets cascaded down. The timers
+    ///!           live in a pool and are linked into the slots, so that scheduling and cancelling
+    ///!           are done in constant time without allocation once the pool has grown.
+    ///!           Each tick, the expired timers get collected into a batch, then dispatched : their
+    ///!           callbacks are run on the worker pool (or on the calling thread without pool), and
+    ///!           timers without callback are pushed as oogl::EventType::TIMER events.
+    ///! \version  1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class TimerWheel
+    {
+        public:
+
+        static constexpr uint64_t DEFAULT_TICK_DURATION = 1000000;    ///!< 1 ms, in nanoseconds.
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                 Class constructor. The wheel time starts now.
+        ///! \param tickDuration    Duration of a tick, in nanoseconds.
+        ///! \version               1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        explicit TimerWheel(uint64_t tickDuration = DEFAULT_TICK_DURATION);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief             Schedule a timer.
+        ///! \param delay       Time before the timer fires, in nanoseconds. It is rounded up to a
+        ///!                    whole number of ticks, at least one.
+        ///! \param callback    Function called when the timer fires ; when nullptr, the timer is
+        ///!                    pushed to the event queue instead.
+        ///! \param data        Data given to the callback, or carried by the event.
+        ///! \param period      Time between two firings of a repeating timer, in nanoseconds ;
+        ///!                    zero for a timer firing once.
+        ///! \return            The handle of the timer.
+        ///! \version           1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        oogl::TimerHandle schedule(uint64_t delay, oogl::TimerCallback callback, uint64_t data = 0,
+                                   uint64_t period = 0);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Cancel a timer.
+        ///! \param timer      Handle of the timer.
+        ///! \return           true if the timer got cancelled, false if the handle was stale.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        bool cancel(oogl::TimerHandle timer) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief              Advance the wheel up to a point in time, firing the timers expired
+        ///!                     meanwhile.
+        ///! \param timestamp    Point in time, in nanoseconds of the steady clock.
+        ///! \return             The number of fired timers.
+        ///! \version            1.0.0
+        ///! \see                oogl::getEventTimestamp
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        std::size_t update(uint64_t timestamp = oogl::getEventTimestamp());
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Advance the wheel by a number of ticks, firing the timers expired
+        ///!                   meanwhile.
+        ///! \param ticks      Number of ticks.
+        ///! \return           The number of fired timers.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        std::size_t advance(uint64_t ticks);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Set the queue receiving the timers without callback, even while the
+        ///!                   wheel gets advanced by another thread. The timer handle is carried
+        ///!                   by the event as <code>(index << 32) | generation</code>, in
+        ///!                   <code>timer.id</code>.
+        ///! \param queue      Event queue, or nullptr to drop those timers.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline void setEventQueue(oogl::EventQueue * queue) noexcept
+        { m_eventQueue.store(queue, std::memory_order_release); }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Set the pool running the timer callbacks. The callbacks then run
+        ///!                   concurrently and must not use the wheel.
+        ///! \param pool       Worker pool, or nullptr to run the callbacks on the updating thread.
+        ///! \version          1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline void setWorkerPool(oogl::WorkerPool * pool) noexcept     { m_workerPool = pool; }
+
+        // Getters
+        inline uint64_t getTickDuration() const noexcept     { return m_tickDuration; }
+        inline uint64_t getCurrentTick() const noexcept      { return m_currentTick; }
+        inline std::size_t getTimerCount() const noexcept    { return m_timerCount; }
+
+        // The timers are linked by indices into the wheel : no copy
+        TimerWheel(TimerWheel const &) = delete;
+        TimerWheel & operator=(TimerWheel const &) = delete;
+
+
+
+        private:
+
+        static constexpr unsigned int SLOT_BITS   = 8;                   ///!< Slots of a wheel.
+        static constexpr unsigned int SLOT_COUNT  = 1 << SLOT_BITS;
+        static constexpr unsigned int SLOT_MASK   = SLOT_COUNT - 1;
+        static constexpr unsigned int LEVEL_COUNT = 4;                   ///!< Wheels.
+        static constexpr uint64_t     MAX_DELTA   = (uint64_t(1) << (SLOT_BITS * LEVEL_COUNT)) - 1;
+        static constexpr uint32_t     NO_TIMER    = UINT32_MAX;          ///!< End of a list.
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Timer of the pool, linked into the list of a slot, or into the free list.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct Timer
+        {
+            uint64_t               deadline;      ///!< Tick of the next firing.
+            uint64_t               period;        ///!< Ticks between two firings, 0 when once.
+            uint64_t               data;          ///!< Data given at scheduling.
+            oogl::TimerCallback    callback;      ///!< Function to call, nullptr for an event.
+            uint32_t               previous;      ///!< Previous timer of the slot.
+            uint32_t               next;          ///!< Next timer of the slot, or free timer.
+            uint32_t               slot;          ///!< Slot holding the timer.
+            uint32_t               generation;    ///!< Generation of the handles of the timer.
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Fired timer, waiting in the batch of its tick.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct Expired
+        {
+            oogl::TimerHandle      timer;
+            oogl::TimerCallback    callback;
+            uint64_t               data;
+        };
+
+
+        // Link a timer into the slot matching its deadline.
+        void link(uint32_t index) noexcept;
+
+        // Unlink a timer from its slot.
+        void unlink(uint32_t index) noexcept;
+
+        // Move the timers of a slot of an upper wheel down to the lower wheels.
+        void cascade(unsigned int level) noexcept;
+
+        // Advance by one tick, and collect the expired timers into the batch.
+        void tick();
+
+        // Run the callbacks and push the events of the batch.
+        void dispatch();
+
+
+        uint64_t                   m_tickDuration;    ///!< Duration of a tick, in nanoseconds.
+        uint64_t                   m_origin;          ///!< Timestamp of the tick 0.
+        uint64_t                   m_currentTick;     ///!< Last processed tick.
+        std::size_t                m_timerCount;      ///!< Scheduled timers.
+        std::vector<Timer>         m_timers;          ///!< Pool of timers.
+        uint32_t                   m_freeHead;        ///!< First free timer of the pool.
+        std::vector<uint32_t>      m_slots;           ///!< First timer of each slot of each wheel.
+        std::size_t                m_levelCounts[LEVEL_COUNT];    ///!< Timers of each wheel.
+        std::vector<Expired>       m_batch;           ///!< Timers fired by the current update.
+        std::atomic<oogl::EventQueue *> m_eventQueue;      ///!< Receiver of the plain timers.
+        oogl::WorkerPool *         m_workerPool;      ///!< Runner of the callbacks.
+
+    };
+
+}
+
+
+
+#endif    // OOGL_TIMERWHEEL_HPP_INCLUDED
@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     WavFileSink.hpp
+///! \brief    This file contains the declaration of the class oogl::WavFileSink and its features.
+///!           The class oogl::WavFileSink is the audio output recording the frames into a WAV file,
+///!           to check the mixing headless.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                 // Non standard include guard
+
+#ifndef OOGL_WAVFILESINK_HPP_INCLUDED        // Standard include guard
+#define OOGL_WAVFILESINK_HPP_INCLUDED
+
+
+// Standard include list
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+// Project include list
+#include "IAudioSink.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl WavFileSink.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    WavFileSink WavFileSink.hpp
+    ///! \brief    Audio output writing the frames into a 16 bits stereo PCM WAV file. The sizes
+    ///!           of the header are written when the file gets closed.
+    ///! \version  1.0.0
+    ///! \see      oogl::IAudioSink
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class WavFileSink : public oogl::IAudioSink
+    {
+        public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Class constructor : create the file.
+        ///! \param path                   Path of the file to create.
+        ///! \param sampleRate             Frames per second.
+        ///! \throw oogl::OOGLException    When the file cannot be created.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        WavFileSink(std::string const & path, unsigned int sampleRate);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class destructor : close the file if need be.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        virtual ~WavFileSink() noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Append frames to the file, clamped to [-1, 1].
+        ///! \param samples                Interleaved stereo samples.
+        ///! \param frameCount             Number of frames.
+        ///! \throw oogl::OOGLException    When the file cannot be written.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        virtual void write(float const * samples, std::size_t frameCount) override;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Write the sizes into the header and close the file. Does
+        ///!                               nothing when the file is already closed.
+        ///! \throw oogl::OOGLException    When the file cannot be written.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void close();
+
+        // Getter
+        inline uint64_t getFrameCount() const noexcept    { return m_frameCount; }
+
+        // The file belongs to one sink : no copy
+        WavFileSink(WavFileSink const &) = delete;
+        WavFileSink & operator=(WavFileSink const &) = delete;
+
+
+
+        private:
+
+        // Write the header, with the sizes matching the frames written so far.
+        void writeHeader();
+
+
+        std::ofstream    m_file;          ///!< Output file.
+        unsigned int     m_sampleRate;    ///!< Frames per second.
+        uint64_t         m_frameCount;    ///!< Frames written so far.
+
+    };
+
+}
+
+
+
+#endif    // OOGL_WAVFILESINK_HPP_INCLUDED
@@ -15,10 +15,16 @@
 
 
 // Standard include list
-#include <set>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <string>
 
 // Project include list
+#include "DamageRegion.hpp"
+#include "Framebuffer.hpp"
 #include "ITrackableObject.hpp"
 #include "OOGLException.hpp"
 
@@ -36,6 +42,13 @@ namespace oogl
 {
 
 
+    // Forward classes declaration
+    class OOGLHandler;
+    class Window;
+    class WindowIndex;
+    class WindowTree;
+
+
     #ifndef OOGL_RECTANGLE_STRUCT_DEFINED        // Guarantee the structure is only defined once
     #define OOGL_RECTANGLE_STRUCT_DEFINED
 
@@ -69,10 +82,10 @@ namespace oogl
     ///! \brief    Lists the different options supported by a Window instance for its creation, i.e.
     ///!           its call for <code>Window::create();</code>.
     ///!           Please, note the flags associated with this options can be combined through the
-    ///!           use of the | and & and ! operators that are overloadded.
+    ///!           use of the | and & and ~ operators that are overloadded.
     ///! \version  1.0.0
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    enum WindowOption : uint32_t
+    enum class WindowOption : uint32_t
     {
         ALL                = 1 << 0,   ///!< Flag used to (de)activate all the options.
         FULLSCREEN         = 1 << 1,   ///!< Flag used to (de)activate the full screen mode.
@@ -85,6 +98,7 @@ namespace oogl
         GRABBED            = 1 << 8,   ///!< Flag used to give/take the grab to the window.
         INPUT_FOCUS        = 1 << 9,   ///!< Flag used to give/take input focus to the window.
         MOUSE_FOCUS        = 1 << 10,  ///!< Flag used to give/take mouse focus to the window.
+        OPAQUE             = 1 << 11,  ///!< Flag used to tell the content has no translucent pixel.
 
         NONE               = 0         ///!< Flag to use to deal with non of those subsystems.
     };
@@ -106,10 +120,10 @@ namespace oogl
         );
     }
 
-    // Overload the NOT '!' operator for the flags of the above enumeration.
-    inline WindowOption operator!(WindowOption opt)
+    // Overload the NOT '~' operator for the flags of the above enumeration.
+    inline WindowOption operator~(WindowOption opt)
     {
-        return static_cast<WindowOption>(! static_cast<uint32_t>(opt));
+        return static_cast<WindowOption>(~ static_cast<uint32_t>(opt));
     }
 
 
@@ -118,6 +132,69 @@ namespace oogl
 
 
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    WindowChildren Window.hpp
+    ///! \brief    Non-owning view of the children of a window, from the bottom to the top of the
+    ///!           stack. It follows the sibling links of the children : iterating allocates
+    ///!           nothing, and the view stays valid until the children get relinked.
+    ///! \version  1.0.0
+    ///! \see      oogl::Window
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class WindowChildren
+    {
+        public:
+
+        // Forward iterator over the children
+        class iterator
+        {
+            public:
+
+            typedef std::forward_iterator_tag    iterator_category;
+            typedef Window                       value_type;
+            typedef std::ptrdiff_t               difference_type;
+            typedef Window *                     pointer;
+            typedef Window &                     reference;
+
+            explicit iterator(Window * window) noexcept : m_window(window)    {}
+
+            inline Window & operator*() const noexcept                   { return *m_window; }
+            inline Window * operator->() const noexcept                  { return m_window; }
+            inline iterator & operator++() noexcept;
+            inline iterator operator++(int) noexcept
+            { iterator const former = *this; ++(*this); return former; }
+            inline bool operator==(iterator const & other) const noexcept
+            { return m_window == other.m_window; }
+            inline bool operator!=(iterator const & other) const noexcept
+            { return m_window != other.m_window; }
+
+            private:
+
+            Window *    m_window;    ///!< Current child, nullptr past the top of the stack.
+        };
+
+        // Class constructor, from the bottom child and the number of children
+        WindowChildren(Window * first, std::size_t size) noexcept :
+        m_first(first), m_size(size)
+        {}
+
+        // Getters
+        inline iterator begin() const noexcept       { return iterator(m_first); }
+        inline iterator end() const noexcept         { return iterator(nullptr); }
+        inline std::size_t size() const noexcept     { return m_size; }
+        inline bool empty() const noexcept           { return m_size == 0; }
+
+
+
+        private:
+
+        Window *       m_first;    ///!< Bottom child of the stack.
+        std::size_t    m_size;     ///!< Number of children.
+
+    };
+
+
+
+
     ////////////////////////////////////////////////////////////////////////////////////////////////
     ///! \class    Window Window.hpp
     ///! \brief    Primitive class defining the main features of the graphic library handlers, that
@@ -161,14 +238,20 @@ namespace oogl
         Window(Window && instance);
 
         ////////////////////////////////////////////////////////////////////////////////////////////
-        ///! \brief               Class destructor.
+        ///! \brief               Class destructor. The window leaves its parent, and its children
+        ///!                      are left without parent.
         ///! \version             1.0.0
         ////////////////////////////////////////////////////////////////////////////////////////////
         virtual ~Window() noexcept;
 
+        // The links of the tree cannot be shared : no assignment
+        Window & operator=(Window const &) = delete;
+        Window & operator=(Window &&) = delete;
+
         ////////////////////////////////////////////////////////////////////////////////////////////
         ///! \brief                        Method, to be fully implemented in child classes, for a
-        ///!                               window to get properly initialized.
+        ///!                               window to get properly initialized. The framebuffer gets
+        ///!                               allocated with the dimensions of the window.
         ///! \throw oogl::OOGLException    When there is a failure in the initialization process.
         ///! \version                      1.0.0
         ////////////////////////////////////////////////////////////////////////////////////////////
@@ -176,12 +259,20 @@ namespace oogl
 
         ////////////////////////////////////////////////////////////////////////////////////////////
         ///! \brief                        Method, to be fully implemented in child classes, for a
-        ///!                               window to get properly free.
+        ///!                               window to get properly free. The framebuffer gets
+        ///!                               released.
         ///! \throw oogl::OOGLException    When there is a failure during the liberation process.
         ///! \version                      1.0.0
         ////////////////////////////////////////////////////////////////////////////////////////////
         virtual void free();
 
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the object the window depends on : its parent, freed after it.
+        ///! \return   The parent window, or nullptr when the window has no parent.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        virtual ITrackableObject * getOwner() const noexcept;
+
         ////////////////////////////////////////////////////////////////////////////////////////////
         ///! \brief           Activate the given option or combination of options.
         ///! \param option    Flag associated with the option or combination of options to activate.
@@ -199,12 +290,23 @@ namespace oogl
         ////////////////////////////////////////////////////////////////////////////////////////////
         virtual Window & deactivateOption(WindowOption option) noexcept;
 
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief           Tell whether the given option, or one of the given combination of
+        ///!                  options, is activated.
+        ///! \param option    Flag associated with the option or combination of options to test.
+        ///! \return          true if the option is activated, false otherwise.
+        ///! \version         1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        virtual bool hasOption(WindowOption option) const noexcept;
+
         ////////////////////////////////////////////////////////////////////////////////////////////
         ///! \brief           Link the calling instance to another instance of the class. The
         ///!                  calling instance will become the child of the other one, and will
-        ///!                  consequently be slaved to it.
+        ///!                  consequently be slaved to it. It leaves its former parent first, and
+        ///!                  gets on the top of the stack of its new siblings.
         ///! \param window    Instance that becomes the master of the calling one.
         ///! \return          A reference to the calling instance.
+        ///! \throw std::bad_alloc    When the index of the hierarchy cannot grow.
         ///! \version         1.0.0
         ///!
         ///! <p>Link the calling instance to another instance of the class. The calling instance
@@ -214,10 +316,10 @@ namespace oogl
         ///! gets called, but the method <code>Window::destroy()</code> that makes an instance being
         ///! unable to get used, but free all dynamically allocated memory.
         ////////////////////////////////////////////////////////////////////////////////////////////
-        virtual Window & linkToParent(Window & window) noexcept;
+        virtual Window & linkToParent(Window & window);
 
         ////////////////////////////////////////////////////////////////////////////////////////////
-        ///! \brief    Loose the link between the calling instance and its parent.
+        ///! \brief    Loose the link between the calling instance and its parent, if any.
         ///! \return   A reference to the calling instance.
         ///! \version  1.0.0
         ////////////////////////////////////////////////////////////////////////////////////////////
@@ -233,11 +335,41 @@ namespace oogl
         virtual Window & getParent() const noexcept;
 
         ////////////////////////////////////////////////////////////////////////////////////////////
-        ///! \brief    Get the list of children Window instances.
-        ///! \return   The set of pointers of the children instances.
+        ///! \brief    Get the children Window instances, from the bottom to the top of the stack.
+        ///! \return   A view of the children, which allocates nothing.
         ///! \version  1.0.0
         ////////////////////////////////////////////////////////////////////////////////////////////
-        virtual std::set<Window *> getChildren() const noexcept;
+        virtual oogl::WindowChildren getChildren() const noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Put the window on the top of the stack of its siblings, in constant time.
+        ///! \return   A reference to the calling instance.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        virtual Window & raise() noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Put the window at the bottom of the stack of its siblings, in constant time.
+        ///! \return   A reference to the calling instance.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        virtual Window & lower() noexcept;
+
+        // Links of the tree : nullptr when there is no such window
+        inline Window * getFirstChild() const noexcept          { return m_firstChild; }
+        inline Window * getLastChild() const noexcept           { return m_lastChild; }
+        inline Window * getPreviousSibling() const noexcept     { return m_previousSibling; }
+        inline Window * getNextSibling() const noexcept         { return m_nextSibling; }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the revision of the subtree of the window, incremented by the changes of
+        ///!           its structure or stacking order, to know whether a tree flattened from the
+        ///!           window is outdated. Only the changes after the last flattening covering the
+        ///!           window are guaranteed to increment it.
+        ///! \return   The current revision.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline uint64_t getRevision() const noexcept    { return m_revision; }
 
         ////////////////////////////////////////////////////////////////////////////////////////////
         ///! \brief    Get the title attached to the Window instance.
@@ -261,22 +393,119 @@ namespace oogl
         virtual oogl::Rectangle getDimensions() const noexcept;
 
         ////////////////////////////////////////////////////////////////////////////////////////////
-        ///! \brief          Set the dimensions of the Window instance.
-        ///! \param title    A structure containing the dimensions to get set to this instance.
-        ///! \version        1.0.0
+        ///! \brief                        Set the dimensions of the Window instance. The
+        ///!                               framebuffer of an initialized window gets resized, its
+        ///!                               memory being reused when it is large enough, and the
+        ///!                               areas of its subtree get updated in the index of its
+        ///!                               hierarchy, if any.
+        ///! \param title                  A structure containing the dimensions to get set to this
+        ///!                               instance.
+        ///! \throw oogl::OOGLException    When the framebuffer memory cannot be allocated.
+        ///! \version                      1.0.0
         ////////////////////////////////////////////////////////////////////////////////////////////
-        virtual void setDimensions(oogl::Rectangle const & dimensions) noexcept;
+        virtual void setDimensions(oogl::Rectangle const & dimensions);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the offscreen framebuffer backing the content of the window. It holds
+        ///!           pixels only while the window is initialized.
+        ///! \return   A reference to the framebuffer.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline oogl::Framebuffer & getFramebuffer() noexcept              { return m_framebuffer; }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the offscreen framebuffer backing the content of the window.
+        ///! \return   A constant reference to the framebuffer.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline oogl::Framebuffer const & getFramebuffer() const noexcept  { return m_framebuffer; }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief              Fill a rectangle of the window with a color, and mark it as
+        ///!                     damaged.
+        ///! \param rectangle    Rectangle to fill, relative to the top left corner of the window.
+        ///! \param color        Color of the pixels, as 0xAARRGGBB.
+        ///! \version            1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        virtual void fill(oogl::Rectangle const & rectangle, uint32_t color);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief              Mark a rectangle of the window as damaged. To be called after
+        ///!                     drawing directly into the framebuffer.
+        ///! \param rectangle    Damaged rectangle, relative to the top left corner of the window.
+        ///! \version            1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        virtual void addDamage(oogl::Rectangle const & rectangle);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the region drawn since the last presentation.
+        ///! \return   A constant reference to the damage region.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline oogl::DamageRegion const & getDamage() const noexcept      { return m_damage; }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Forget the region drawn, once it has been presented or composed.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline void clearDamage() noexcept                                { m_damage.clear(); }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the handler tracking the window.
+        ///! \return   A pointer to the handler, nullptr while the window is not initialized.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline oogl::OOGLHandler * getHandler() const noexcept            { return m_handler; }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                Copy the damaged pixels of the window into a destination
+        ///!                       framebuffer, the window being placed at its position, then clear
+        ///!                       the damage region. The pixels which are not damaged are left
+        ///!                       untouched in the destination.
+        ///! \param destination    Framebuffer the window gets presented into.
+        ///! \version              1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        virtual void present(oogl::Framebuffer & destination);
 
 
 
         private:
 
-        std::string           m_title;         ///<! Title attached to the window.
-        oogl::Rectangle       m_dimensions;    ///!< Contains the position and size of the window.
-        Window *              m_parent;        ///!< Points to the parent window.
-        std::set<Window *>    m_children;      ///!< Contains the child/slaved windows.
-        WindowOption          m_option;        ///!< Options used for the creation of the window.
-        bool                  m_isInit;        ///!< Indicates whether the window is initialized.
+        // The index of the hierarchy follows its windows, the flattened trees their revisions
+        friend class oogl::WindowIndex;
+        friend class oogl::WindowTree;
+
+        // Increment the revision of the window and of its ancestors, after a change of its
+        // children.
+        void revise() noexcept;
+
+        // Remove the window from the children of its parent.
+        void unlink() noexcept;
+
+        // Add the window on the top or at the bottom of the children of its parent, with a
+        // stacking key above or below the ones of the siblings.
+        void linkOnTop() noexcept;
+        void linkAtBottom() noexcept;
+
+
+        std::string           m_title;            ///<! Title attached to the window.
+        oogl::Rectangle       m_dimensions;       ///!< Position and size of the window.
+        Window *              m_parent;           ///!< Points to the parent window.
+        Window *              m_firstChild;       ///!< Child at the bottom of the stack.
+        Window *              m_lastChild;        ///!< Child on the top of the stack.
+        Window *              m_previousSibling;  ///!< Sibling right below in the stack.
+        Window *              m_nextSibling;      ///!< Sibling right above in the stack.
+        std::size_t           m_childCount;       ///!< Number of children.
+        int64_t               m_stackKey;         ///!< Order among the siblings, higher on top.
+        uint64_t              m_revision;         ///!< Revision of the subtree of the window.
+        std::atomic<bool>     m_isRevised;        ///!< Revised since the last flattening.
+        WindowOption          m_option;           ///!< Options used for the creation of the window.
+        bool                  m_isInit;           ///!< Indicates whether the window is initialized.
+        oogl::Framebuffer     m_framebuffer;      ///!< Pixels of the window, allocated on init.
+        oogl::DamageRegion    m_damage;           ///!< Pixels drawn since the last presentation.
+        oogl::OOGLHandler *   m_handler;          ///!< Handler tracking the initialized window.
+        oogl::WindowIndex *   m_index;            ///!< Spatial index of the hierarchy, if any.
+        uint32_t              m_indexEntry;       ///!< Entry of the window in its index.
 
     };
 
@@ -284,4 +513,140 @@ namespace oogl
 
 
 
+//==================================================================================================
+// Move to the sibling above.
+//==================================================================================================
+inline oogl::WindowChildren::iterator & oogl::WindowChildren::iterator::operator++() noexcept
+{
+    m_window = m_window->getNextSibling();
+    return *this;
+}
+
+
+//==================================================================================================
+// The window depends on its parent.
+//==================================================================================================
+inline oogl::ITrackableObject * oogl::Window::getOwner() const noexcept
+{
+    return m_parent;
+}
+
+
+//==================================================================================================
+// Method which activate an option flag.
+//==================================================================================================
+inline oogl::Window & oogl::Window::activateOption(WindowOption option) noexcept
+{
+    if (option == oogl::WindowOption::NONE) {            // no option to activate : return
+        return *this;
+    }
+
+    if (option == oogl::WindowOption::ALL) {             // activate all the options using one flag
+        m_option = oogl::WindowOption::ALL;
+    } else if (m_option != oogl::WindowOption::ALL) {    // there are systems left to activate
+        m_option = m_option | option;
+    }
+
+    return *this;
+}
+
+
+//==================================================================================================
+// Method which deactivate an option of the creation.
+//==================================================================================================
+inline oogl::Window & oogl::Window::deactivateOption(WindowOption option) noexcept
+{
+    if (option == oogl::WindowOption::NONE) {            // no option to deactivate : return
+        return *this;
+    }
+
+    if (option == oogl::WindowOption::ALL) {             // deactivate every options using one flag
+        m_option = oogl::WindowOption::NONE;
+    } else if (m_option != oogl::WindowOption::NONE) {   // there are options left to deactivate
+        m_option = m_option & (~option);
+    }
+
+    return *this;
+}
+
+
+//==================================================================================================
+// Method which tells whether an option flag is activated.
+//==================================================================================================
+inline bool oogl::Window::hasOption(WindowOption option) const noexcept
+{
+    if (m_option == oogl::WindowOption::ALL) {           // every option is activated
+        return true;
+    }
+
+    return (m_option & option) != oogl::WindowOption::NONE;
+}
+
+
+//==================================================================================================
+// Returns a reference to the parent method.
+//==================================================================================================
+inline oogl::Window & oogl::Window::getParent() const noexcept
+{
+    return *m_parent;
+}
+
+
+//==================================================================================================
+// Title getter.
+//==================================================================================================
+inline std::string oogl::Window::getTitle() const noexcept
+{
+    return std::string(m_title);
+}
+
+
+//==================================================================================================
+// Title setter.
+//==================================================================================================
+inline void oogl::Window::setTitle(std::string const & title) noexcept
+{
+    m_title = std::string(title);
+}
+
+
+//==================================================================================================
+// Dimensions getter.
+//==================================================================================================
+inline oogl::Rectangle oogl::Window::getDimensions() const noexcept
+{
+    return oogl::Rectangle(m_dimensions);
+}
+
+
+//==================================================================================================
+// Fill a rectangle and accumulate it into the damage region.
+//==================================================================================================
+inline void oogl::Window::fill(oogl::Rectangle const & rectangle, uint32_t color)
+{
+    m_framebuffer.fill(rectangle.xPosition, rectangle.yPosition, rectangle.width,
+                       rectangle.height, color);
+    addDamage(rectangle);
+}
+
+
+//==================================================================================================
+// Accumulate a rectangle, clipped to the window, into the damage region.
+//==================================================================================================
+inline void oogl::Window::addDamage(oogl::Rectangle const & rectangle)
+{
+    if (rectangle.xPosition >= m_dimensions.width || rectangle.yPosition >= m_dimensions.height) {
+        return;    // out of the window
+    }
+
+    m_damage.add({
+        rectangle.xPosition, rectangle.yPosition,
+        std::min(rectangle.width,  m_dimensions.width  - rectangle.xPosition),
+        std::min(rectangle.height, m_dimensions.height - rectangle.yPosition)
+    });
+}
+
+
+
+
 #endif    // OOGL_WINDOW_HPP_INCLUDED
@@ -0,0 +1,209 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     WindowIndex.hpp
+///! \brief    This file contains the declaration of the class oogl::WindowIndex and its features.
+///!           The class oogl::WindowIndex is the spatial index of a window hierarchy : it finds
+///!           the topmost visible window under a point, to route the pointer events, without
+///!           walking every window.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                 // Non standard include guard
+
+#ifndef OOGL_WINDOWINDEX_HPP_INCLUDED        // Standard include guard
+#define OOGL_WINDOWINDEX_HPP_INCLUDED
+
+
+// Standard include list
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Project include list
+#include "Event.hpp"
+#include "Window.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl WindowIndex.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    WindowIndex WindowIndex.hpp
+    ///! \brief    Loose quadtree over the area of the windows of a hierarchy, in the coordinates of
+    ///!           the root : the area of a window is its rectangle placed at the sum of the
+    ///!           positions of its ancestors, clipped by the area of its parent, as composed. Each
+    ///!           area is kept in the deepest cell at least as large as it, the one holding its
+    ///!           center, so that a point is only looked for in the few cells whose loosened
+    ///!           bounds contain it, level by level.
+    ///!           The index follows the hierarchy : the windows linked into it get indexed, the
+    ///!           ones leaving it or destroyed leave the index, and the ones getting new dimensions
+    ///!           get their area, and the areas of their subtree, updated. Resizing the root builds
+    ///!           the whole index again.
+    ///! \version  1.0.0
+    ///! \see      oogl::Window
+    ///!
+    ///! <p>Among the windows under a point, a window is above its ancestors, and above the
+    ///! subtrees of the siblings of its ancestors lower in the stack. The windows hidden or
+    ///! minimized, or having such an ancestor, are skipped.</p>
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class WindowIndex
+    {
+        public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief         Class constructor : index the hierarchy of a window, which leaves its
+        ///!                former index, if any.
+        ///! \param root    Root of the hierarchy to index.
+        ///! \version       1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        explicit WindowIndex(oogl::Window & root);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class destructor : the windows are left without index.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ~WindowIndex() noexcept;
+
+        // The windows point to their index : no copy
+        WindowIndex(WindowIndex const &) = delete;
+        WindowIndex & operator=(WindowIndex const &) = delete;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief      Find the topmost visible window under a point.
+        ///! \param x    Abscissa of the point, in the coordinates of the root.
+        ///! \param y    Ordinate of the point, in the coordinates of the root.
+        ///! \return     The window, or nullptr when there is none under the point.
+        ///! \version    1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        oogl::Window * hitTest(int32_t x, int32_t y) const noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief          Route a pointer event to the topmost visible window under the pointer.
+        ///!                 The position of a motion or of a button event is made relative to the
+        ///!                 top left corner of the window ; a wheel event goes to the window under
+        ///!                 the last position routed.
+        ///! \param event    Event to route, in the coordinates of the root.
+        ///! \return         The window the event goes to, or nullptr when there is none, or when
+        ///!                 the event is not a pointer one.
+        ///! \version        1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        oogl::Window * route(oogl::Event & event) noexcept;
+
+        // Getters
+        inline oogl::Window * getRoot() const noexcept    { return m_root; }
+        inline std::size_t size() const noexcept          { return m_size; }
+
+
+
+        private:
+
+        // The windows keep their index up to date
+        friend class oogl::Window;
+
+        static constexpr uint32_t NONE      = UINT32_MAX;    ///!< Index of no entry, or no node.
+        static constexpr uint32_t MAX_DEPTH = 16;            ///!< Depth of the smallest cells.
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Indexed window, referenced by an item of the cell holding its area.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct Entry
+        {
+            oogl::Window *     window;      ///!< Indexed window.
+            oogl::Rectangle    area;        ///!< Composed area, empty when fully clipped.
+            unsigned int       xOrigin;     ///!< Abscissa of the top left corner of the window.
+            unsigned int       yOrigin;     ///!< Ordinate of the top left corner of the window.
+            uint32_t           node;        ///!< Cell holding the area, NONE when empty.
+            uint32_t           item;        ///!< Position of the area in the cell.
+            uint32_t           next;        ///!< Next free entry, once released.
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Area held by a cell, stored along with the others so that a cell is scanned
+        ///!         without following the entries.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct Item
+        {
+            oogl::Rectangle    area;        ///!< Composed area of the window.
+            uint32_t           entry;       ///!< Entry of the window.
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Cell of the quadtree, created with its first item. A released cell keeps the
+        ///!         capacity of its items for the next use.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct Node
+        {
+            uint32_t             children[4];    ///!< Quarters, left to right then top to bottom.
+            uint32_t             parent;         ///!< Enclosing cell, or next free cell.
+            uint32_t             count;          ///!< Items of the cell and of its quarters.
+            std::vector<Item>    items;          ///!< Areas held by the cell.
+        };
+
+        // Index the subtree of a window, its parent being indexed, or being the root.
+        void insert(oogl::Window & window);
+
+        // Remove the subtree of a window from the index ; removing the root empties it.
+        void remove(oogl::Window & window) noexcept;
+
+        // Compute the area of the windows of a subtree again, after it moved or got resized.
+        void update(oogl::Window & window);
+
+        // The window moved into a new instance.
+        void move(oogl::Window & from, oogl::Window & to) noexcept;
+
+        // Empty the quadtree, its root cell covering the root window.
+        void reset();
+
+        // Place every window again, after the root got resized.
+        void rebuild();
+
+        // Compute the area of an indexed window from its dimensions and its parent.
+        void compose(Entry & entry) const noexcept;
+
+        // Add an entry to the cell of its area, or remove it.
+        void place(uint32_t entry);
+        void unplace(uint32_t entry) noexcept;
+
+        // Allocate and release entries and nodes.
+        uint32_t allocateEntry(oogl::Window & window);
+        void releaseEntry(uint32_t entry) noexcept;
+        uint32_t allocateNode(uint32_t parent);
+        void releaseNodes(uint32_t node) noexcept;
+
+        // Tell whether a window is shown, as well as its ancestors.
+        bool isVisible(oogl::Window const & window) const noexcept;
+
+        // Tell whether a window is composed above another one.
+        static bool isAbove(oogl::Window const & window, oogl::Window const & other) noexcept;
+
+
+        oogl::Window *        m_root;         ///!< Root of the indexed hierarchy.
+        std::vector<Entry>    m_entries;      ///!< Entries, referenced by the windows.
+        std::vector<Node>     m_nodes;        ///!< Cells, the root one first.
+        uint32_t              m_freeEntry;    ///!< First released entry.
+        uint32_t              m_freeNode;     ///!< First released node.
+        std::size_t           m_size;         ///!< Number of indexed windows.
+        unsigned int          m_xWorld;       ///!< Abscissa of the root cell.
+        unsigned int          m_yWorld;       ///!< Ordinate of the root cell.
+        uint64_t              m_worldSize;    ///!< Side of the root cell, a power of two.
+        int32_t               m_xPointer;     ///!< Abscissa of the last pointer position routed.
+        int32_t               m_yPointer;     ///!< Ordinate of the last pointer position routed.
+
+    };
+
+}
+
+
+
+#endif    // OOGL_WINDOWINDEX_HPP_INCLUDED
@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     WindowTransaction.hpp
+///! \brief    This file contains the declaration of the class oogl::WindowTransaction and its
+///!           features. The class oogl::WindowTransaction collects the property changes of many
+///!           windows, and applies them at once, each window being updated a single time.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                       // Non standard include guard
+
+#ifndef OOGL_WINDOWTRANSACTION_HPP_INCLUDED        // Standard include guard
+#define OOGL_WINDOWTRANSACTION_HPP_INCLUDED
+
+
+// Standard include list
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Project include list
+#include "Window.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl WindowTransaction.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    WindowTransaction WindowTransaction.hpp
+    ///! \brief    Batch of window property changes, typically committed once per frame. The
+    ///!           changes of a window are coalesced as they get collected : the last title and
+    ///!           dimensions win, and the options end up as one deactivation and one activation.
+    ///!           On commit, each window gets its changes through its own setters, so once per
+    ///!           window and per property whatever the number of calls, then gets initialized if
+    ///!           it was opened in the transaction : its pixels are allocated with its final
+    ///!           dimensions. The windows must outlive the commit, or be discarded before.
+    ///! \version  1.0.0
+    ///! \see      oogl::Window
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class WindowTransaction
+    {
+        public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class constructor : the transaction is empty.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        WindowTransaction() noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief           Change the title of a window.
+        ///! \param window    Window to change.
+        ///! \param title     New title.
+        ///! \return          A reference to the calling instance.
+        ///! \version         1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        WindowTransaction & setTitle(oogl::Window & window, std::string const & title);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief               Change the dimensions of a window.
+        ///! \param window        Window to change.
+        ///! \param dimensions    New position and size.
+        ///! \return              A reference to the calling instance.
+        ///! \version             1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        WindowTransaction & setDimensions(oogl::Window & window,
+                                          oogl::Rectangle const & dimensions);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief           Activate an option or combination of options of a window.
+        ///! \param window    Window to change.
+        ///! \param option    Flag of the option or combination of options.
+        ///! \return          A reference to the calling instance.
+        ///! \version         1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        WindowTransaction & activateOption(oogl::Window & window, oogl::WindowOption option);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief           Deactivate an option or combination of options of a window.
+        ///! \param window    Window to change.
+        ///! \param option    Flag of the option or combination of options.
+        ///! \return          A reference to the calling instance.
+        ///! \version         1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        WindowTransaction & deactivateOption(oogl::Window & window, oogl::WindowOption option);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief           Open a window : initialize it once its other changes are applied.
+        ///! \param window    Window to initialize.
+        ///! \return          A reference to the calling instance.
+        ///! \version         1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        WindowTransaction & open(oogl::Window & window);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief           Forget the changes of a window, before it gets destroyed for instance.
+        ///! \param window    Window whose changes are dropped.
+        ///! \version         1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void discard(oogl::Window & window) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                        Apply the changes, window by window in the order they
+        ///!                               were first changed, and empty the transaction. A
+        ///!                               failure does not stop the other windows.
+        ///! \throw oogl::OOGLException    The first failure, once every window has been updated.
+        ///! \version                      1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void commit();
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Forget every change, keeping the memory for the next transaction.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void rollback() noexcept;
+
+        // Getters
+        inline std::size_t size() const noexcept     { return m_indices.size(); }
+        inline bool empty() const noexcept           { return m_indices.empty(); }
+
+
+
+        private:
+
+        // Properties of a change
+        static constexpr uint32_t TITLE      = 1 << 0;    ///!< The title changed.
+        static constexpr uint32_t DIMENSIONS = 1 << 1;    ///!< The dimensions changed.
+        static constexpr uint32_t OPEN       = 1 << 2;    ///!< The window gets initialized.
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Coalesced changes of a window.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct Change
+        {
+            oogl::Window *        window;         ///!< Changed window, nullptr once discarded.
+            uint32_t              properties;     ///!< Properties changed.
+            std::string           title;          ///!< Last title.
+            oogl::Rectangle       dimensions;     ///!< Last dimensions.
+            oogl::WindowOption    activated;      ///!< Options to activate.
+            oogl::WindowOption    deactivated;    ///!< Options to deactivate, before.
+        };
+
+        // Get the changes of a window, added if need be.
+        Change & getChange(oogl::Window & window);
+
+        // Apply the changes of a window.
+        static void apply(Change const & change);
+
+
+        std::vector<Change>                               m_changes;    ///!< Changes, in order.
+        std::unordered_map<oogl::Window *, std::size_t>   m_indices;    ///!< Change of a window.
+
+    };
+
+}
+
+
+
+#endif    // OOGL_WINDOWTRANSACTION_HPP_INCLUDED
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     WindowTree.hpp
+///! \brief    This file contains the declaration of the class oogl::WindowTree and its features.
+///!           The class oogl::WindowTree flattens a window hierarchy into contiguous arrays, in
+///!           depth-first order, so that traversing it is a linear scan without allocation.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                // Non standard include guard
+
+#ifndef OOGL_WINDOWTREE_HPP_INCLUDED        // Standard include guard
+#define OOGL_WINDOWTREE_HPP_INCLUDED
+
+
+// Standard include list
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Project include list
+#include "Window.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl WindowTree.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    WindowTree WindowTree.hpp
+    ///! \brief    Depth-first flattening of a window hierarchy : the windows are stored in
+    ///!           pre-order, each child after its parent and the children from the bottom to the
+    ///!           top of the stack, along with the index of their parent, their depth, and the end
+    ///!           of their subtree, so that a whole subtree gets skipped in one step. The arrays
+    ///!           keep their capacity from a flattening to the next. The tree is outdated once the
+    ///!           structure or the stacking order of the flattened hierarchy changes.
+    ///! \version  1.0.0
+    ///! \see      oogl::Window
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class WindowTree
+    {
+        public:
+
+        static constexpr uint32_t NO_PARENT = UINT32_MAX;    ///!< Parent index of the root.
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class constructor : the tree is empty.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        WindowTree() noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief         Flatten the hierarchy of a window. The sibling links are followed
+        ///!                without recursion nor stack.
+        ///! \param root    Root of the hierarchy, at index 0.
+        ///! \version       1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void build(oogl::Window & root);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief         Flatten the hierarchy of a window again, only when it is another root,
+        ///!                or when the tree is outdated.
+        ///! \param root    Root of the hierarchy, at index 0.
+        ///! \return        true if the tree got flattened again, false if it was up to date.
+        ///! \version       1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        bool update(oogl::Window & root);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Tell whether the hierarchy changed since the tree was flattened. The root
+        ///!           must still exist.
+        ///! \return   true if the tree must be flattened again before use.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline bool isOutdated() const noexcept
+        { return m_root == nullptr || m_revision != m_root->getRevision(); }
+
+        // Getters, by index in depth-first order
+        inline std::size_t size() const noexcept                       { return m_windows.size(); }
+        inline oogl::Window & getWindow(std::size_t index) const noexcept
+        { return *m_windows[index]; }
+        inline uint32_t getParent(std::size_t index) const noexcept     { return m_parents[index]; }
+        inline uint32_t getDepth(std::size_t index) const noexcept      { return m_depths[index]; }
+        inline uint32_t getSubtreeEnd(std::size_t index) const noexcept { return m_ends[index]; }
+
+        // Contiguous arrays, of size() items each
+        inline oogl::Window * const * getWindows() const noexcept   { return m_windows.data(); }
+        inline uint32_t const * getParents() const noexcept         { return m_parents.data(); }
+
+
+
+        private:
+
+        // Append a window of the hierarchy.
+        void push(oogl::Window * window, uint32_t parent, uint32_t depth);
+
+
+        std::vector<oogl::Window *>    m_windows;     ///!< Windows, in depth-first order.
+        std::vector<uint32_t>          m_parents;     ///!< Index of the parent of each window.
+        std::vector<uint32_t>          m_depths;      ///!< Depth of each window, 0 for the root.
+        std::vector<uint32_t>          m_ends;        ///!< Index past the subtree of each window.
+        oogl::Window *                 m_root;        ///!< Root of the flattened hierarchy.
+        uint64_t                       m_revision;    ///!< Revision of the root when flattened.
+
+    };
+
+}
+
+
+
+#endif    // OOGL_WINDOWTREE_HPP_INCLUDED
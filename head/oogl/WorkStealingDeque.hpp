@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     WorkStealingDeque.hpp
+///! \brief    This file contains the declaration and the definition of the class template
+///!           oogl::WorkStealingDeque and its features. The class template oogl::WorkStealingDeque
+///!           is the lock-free Chase-Lev deque each worker of the worker pool keeps its tasks in.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                       // Non standard include guard
+
+#ifndef OOGL_WORKSTEALINGDEQUE_HPP_INCLUDED        // Standard include guard
+#define OOGL_WORKSTEALINGDEQUE_HPP_INCLUDED
+
+
+// Standard include list
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl WorkStealingDeque.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    WorkStealingDeque WorkStealingDeque.hpp
+    ///! \brief    Chase-Lev deque, with the memory orders of Le, Pop, Cohen and Zappa Nardelli :
+    ///!           the owner thread pushes and pops at the bottom without lock, while any other
+    ///!           thread steals from the top, racing on a single compare-and-swap. The items live
+    ///!           in a circular array which the owner doubles when full ; the former arrays are
+    ///!           kept until the deque is destroyed, as thieves may still be reading them.
+    ///! \tparam   T    Type of the items, trivially copyable (usually a pointer).
+    ///! \version  1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    class WorkStealingDeque
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "Deque items must be trivially copyable.");
+
+        public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief             Class constructor.
+        ///! \param capacity    Initial number of items, rounded up to a power of two.
+        ///! \version           1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        explicit WorkStealingDeque(std::size_t capacity = 256) :
+        m_top(0), m_bottom(0), m_array(nullptr), m_arrays()
+        {
+            std::size_t size = 2;
+            while (size < capacity) {
+                size <<= 1;
+            }
+
+            m_arrays.emplace_back(new Array(size));
+            m_array.store(m_arrays.back().get(), std::memory_order_relaxed);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief          Push an item at the bottom. Owner thread only.
+        ///! \param item     Item to push.
+        ///! \version        1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void push(T item)
+        {
+            int64_t const bottom = m_bottom.load(std::memory_order_relaxed);
+            int64_t const top    = m_top.load(std::memory_order_acquire);
+            Array *       array  = m_array.load(std::memory_order_relaxed);
+
+            if (bottom - top > static_cast<int64_t>(array->mask)) {    // full : grow
+                array = grow(array, top, bottom);
+            }
+
+            array->put(bottom, item);
+            m_bottom.store(bottom + 1, std::memory_order_release);    // publishes the item
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief          Pop the item at the bottom, the last pushed one. Owner thread only.
+        ///! \param item     Receives the popped item.
+        ///! \return         true if an item got popped, false if the deque was empty.
+        ///! \version        1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        bool pop(T & item)
+        {
+            int64_t const bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            Array * const array  = m_array.load(std::memory_order_relaxed);
+
+            m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = m_top.load(std::memory_order_relaxed);
+
+            if (top > bottom) {     // empty
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return false;
+            }
+
+            item = array->get(bottom);
+
+            if (top == bottom) {    // last item : race the thieves for it
+                bool const won = m_top.compare_exchange_strong(top, top + 1,
+                                                               std::memory_order_seq_cst,
+                                                               std::memory_order_relaxed);
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return won;
+            }
+
+            return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief          Steal the item at the top, the first pushed one. Any thread.
+        ///! \param item     Receives the stolen item.
+        ///! \return         true if an item got stolen, false if the deque was empty or if another
+        ///!                 thread took the item first.
+        ///! \version        1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        bool steal(T & item)
+        {
+            int64_t top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t const bottom = m_bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom) {    // empty
+                return false;
+            }
+
+            item = m_array.load(std::memory_order_acquire)->get(top);
+
+            return m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                 std::memory_order_relaxed);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get an estimate of the number of items, exact for the owner thread.
+        ///! \return   The number of items.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline std::size_t size() const noexcept
+        {
+            int64_t const bottom = m_bottom.load(std::memory_order_relaxed);
+            int64_t const top    = m_top.load(std::memory_order_relaxed);
+            return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+        }
+
+        // The thieves keep reading the arrays : no copy
+        WorkStealingDeque(WorkStealingDeque const &) = delete;
+        WorkStealingDeque & operator=(WorkStealingDeque const &) = delete;
+
+
+
+        private:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Circular array of items, indexed by the unbounded positions of the deque.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct Array
+        {
+            explicit Array(std::size_t size) :
+            mask(size - 1), items(new std::atomic<T>[size])
+            {}
+
+            inline T get(int64_t position) const noexcept
+            { return items[position & mask].load(std::memory_order_relaxed); }
+
+            inline void put(int64_t position, T item) noexcept
+            { items[position & mask].store(item, std::memory_order_relaxed); }
+
+            std::size_t                        mask;     ///!< Size of the array, minus one.
+            std::unique_ptr<std::atomic<T>[]>  items;    ///!< Items.
+        };
+
+        // Double the array, copying the items between the top and the bottom.
+        Array * grow(Array * array, int64_t top, int64_t bottom)
+        {
+            m_arrays.emplace_back(new Array((array->mask + 1) * 2));
+            Array * const grown = m_arrays.back().get();
+
+            for (int64_t position = top; position < bottom; position++) {
+                grown->put(position, array->get(position));
+            }
+
+            m_array.store(grown, std::memory_order_release);
+            return grown;
+        }
+
+
+        alignas(64) std::atomic<int64_t>       m_top;       ///!< Position thieves steal from.
+        alignas(64) std::atomic<int64_t>       m_bottom;    ///!< Position the owner pushes to.
+        std::atomic<Array *>                   m_array;     ///!< Current array.
+        std::vector<std::unique_ptr<Array>>    m_arrays;    ///!< Current and former arrays.
+
+    };
+
+}
+
+
+
+#endif    // OOGL_WORKSTEALINGDEQUE_HPP_INCLUDED
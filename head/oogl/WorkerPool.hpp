@@ -0,0 +1,310 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     WorkerPool.hpp
+///! \brief    This file contains the declaration of the classes oogl::WorkerPool and
+///!           oogl::TaskGroup and their features. The class oogl::WorkerPool is the job system of
+///!           the library : a pool of worker threads, one per hardware core by default, which
+///!           balance the submitted tasks between themselves by work stealing. The class
+///!           oogl::TaskGroup gathers tasks to wait for, or to continue with once they are done.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                // Non standard include guard
+
+#ifndef OOGL_WORKERPOOL_HPP_INCLUDED        // Standard include guard
+#define OOGL_WORKERPOOL_HPP_INCLUDED
+
+
+// Standard include list
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Project include list
+#include "WorkStealingDeque.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl WorkerPool.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+
+    // Forward class declaration
+    class TaskGroup;
+
+
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    WorkerPool WorkerPool.hpp
+    ///! \brief    Pool of worker threads. Each worker owns a Chase-Lev deque : it pushes and pops
+    ///!           its own tasks at the bottom without lock, and steals the tasks of the other
+    ///!           workers from the top once its deque is empty. The threads outside the pool
+    ///!           submit their tasks to a shared queue, which the workers steal from as well.
+    ///!           A thread waiting for tasks to complete runs tasks meanwhile, so that waiting
+    ///!           from a task itself never blocks the pool. Tasks must not throw.
+    ///! \version  1.0.0
+    ///! \see      oogl::TaskGroup
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class WorkerPool
+    {
+        public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                Class constructor. The worker threads are not started before the
+        ///!                       call of <code>WorkerPool::start()</code>.
+        ///! \param workerCount    Number of worker threads. When zero, one worker is used per
+        ///!                       hardware thread.
+        ///! \version              1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        explicit WorkerPool(unsigned int workerCount = 0);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class destructor. Joins the worker threads if they are still running.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ~WorkerPool() noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Start the worker threads. Does nothing when they are already running.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void start();
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Wait for the worker threads to end. Tasks still queued are run before.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void stop() noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief          Set the function each worker thread calls when it starts, before
+        ///!                 running any task, to set its thread local state up. Only taken into
+        ///!                 account by the next call of <code>WorkerPool::start()</code>.
+        ///! \param hook     Function called with the index of the worker.
+        ///! \version        1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void setWorkerHook(std::function<void(unsigned int)> hook);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief          Pin the worker threads to processor cores, the i-th worker to the core
+        ///!                 <code>cores[i % cores.size()]</code>, so that several pools of a
+        ///!                 process do not share cores. Only taken into account by the next call
+        ///!                 of <code>WorkerPool::start()</code>, and ignored where the system does
+        ///!                 not support it.
+        ///! \param cores    Indices of the cores, or an empty list for no pinning.
+        ///! \version        1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void setAffinity(std::vector<unsigned int> cores);
+
+        // Getters
+        inline unsigned int getWorkerCount() const noexcept    { return m_workerCount; }
+        inline bool isRunning() const noexcept                 { return m_isRunning; }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief         Call the given function for every index in [0, count[, spreading the
+        ///!                indices between the workers. The calling thread takes part in the work
+        ///!                and only returns once every index has been processed, so that the method
+        ///!                can safely get called from a task itself.
+        ///! \param count   Number of indices to process.
+        ///! \param body    Function called with each index.
+        ///! \version       1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void parallelFor(std::size_t count, std::function<void(std::size_t)> const & body);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief         Cut [0, count[ into contiguous ranges, and call the given function once
+        ///!                per range, spreading the ranges between the workers : the body loops on
+        ///!                its range itself, without a call per index. The calling thread takes
+        ///!                part in the work and returns once every range has been processed.
+        ///! \param count   Number of indices to process.
+        ///! \param body    Function called with the first and past-the-last indices of a range.
+        ///! \version       1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void parallelForRange(std::size_t count,
+                              std::function<void(std::size_t, std::size_t)> const & body);
+
+
+
+        private:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Task queued in a worker deque or in the shared queue, with its group.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct Task
+        {
+            std::function<void()>    function;    ///!< Work to perform.
+            oogl::TaskGroup *        group;       ///!< Group notified once the task is done.
+            bool                     owned;       ///!< Deleted by the pool once run.
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief           Queue a task : on the deque of the calling worker, or on the shared
+        ///!                  queue for the threads outside the pool.
+        ///! \param task     Task to queue.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void submit(Task * task);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief           Run a task, notify its group and release it.
+        ///! \param task     Task to run.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void run(Task * task);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief           Run one task, popped from the own deque, taken from the shared queue,
+        ///!                  or stolen from another worker.
+        ///! \param self      Index of the worker calling, or the worker count for another thread.
+        ///! \return          true if a task has been run, false if there was no task to take.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        bool runOneTask(unsigned int self);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief           Run tasks until the given group is done.
+        ///! \param group     Group to wait for.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void wait(oogl::TaskGroup const & group);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief           Loop run by each worker thread until the pool gets stopped.
+        ///! \param index     Index of the worker, and of the deque it owns.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void workerLoop(unsigned int index);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Get the worker index of the calling thread, or the worker count for a thread
+        ///!         outside the pool.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        unsigned int getWorkerIndex() const noexcept;
+
+        // Friend class : groups submit their tasks, and wait for them, through the pool
+        friend class oogl::TaskGroup;
+
+
+        typedef oogl::WorkStealingDeque<Task *> Deque;
+
+        unsigned int                           m_workerCount;    ///!< Number of worker threads.
+        std::vector<std::unique_ptr<Deque>>    m_deques;         ///!< Deque of each worker.
+        std::mutex                             m_sharedMutex;    ///!< Protects the shared queue.
+        std::deque<Task *>                     m_shared;         ///!< Tasks of other threads.
+        std::vector<std::thread>               m_threads;        ///!< Worker threads.
+        std::atomic<bool>                      m_isRunning;      ///!< Workers keep on looping.
+        std::atomic<std::size_t>               m_queuedTasks;    ///!< Tasks waiting in queues.
+        std::atomic<unsigned int>              m_sleepers;       ///!< Workers waiting for tasks.
+        std::mutex                             m_sleepMutex;     ///!< Protects idle waits.
+        std::condition_variable                m_wakeUp;         ///!< Wakes up idle workers.
+        std::function<void(unsigned int)>      m_workerHook;     ///!< Called by starting workers.
+        std::vector<unsigned int>              m_affinity;       ///!< Cores of the workers.
+
+    };
+
+
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    TaskGroup WorkerPool.hpp
+    ///! \brief    Group of tasks run on a worker pool. The group can be waited for, the waiting
+    ///!           thread running tasks meanwhile, and continuations can be chained to it : they
+    ///!           get submitted as tasks of the group once it has no pending task left. When the
+    ///!           pool is not running, the tasks and the continuations are run on the spot.
+    ///!           A group waits for its tasks when destroyed.
+    ///! \version  1.0.0
+    ///! \see      oogl::WorkerPool
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class TaskGroup
+    {
+        public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief          Class constructor.
+        ///! \param pool     Pool running the tasks of the group.
+        ///! \version        1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        explicit TaskGroup(oogl::WorkerPool & pool) noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class destructor. Waits for the tasks of the group.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ~TaskGroup() noexcept;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief              Submit a task to the group.
+        ///! \param function     Work to perform.
+        ///! \version            1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void run(std::function<void()> function);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief                  Chain a continuation to the group : it gets submitted to the
+        ///!                         group once no task of the group is pending, right away if
+        ///!                         none is.
+        ///! \param continuation     Work to perform after the pending tasks.
+        ///! \version                1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void then(std::function<void()> continuation);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Wait until the tasks and the continuations of the group are done, running
+        ///!           tasks of the pool meanwhile.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void wait();
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Tell whether every task and continuation of the group is done.
+        ///! \return   true if the group is done, false otherwise.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        bool isDone() const noexcept;
+
+        // The pool holds pointers to the group : no copy
+        TaskGroup(TaskGroup const &) = delete;
+        TaskGroup & operator=(TaskGroup const &) = delete;
+
+
+
+        private:
+
+        // Bit of the pending count set while continuations are held back.
+        static constexpr std::size_t HOLD = ~(~std::size_t(0) >> 1);
+
+        // Account for a task of the group being done, and release the held continuations when
+        // only them are left.
+        void complete();
+
+        // Queue a task of the group, already counted as pending.
+        void dispatch(oogl::WorkerPool::Task * task);
+
+        // Friend class : the pool notifies the group of the tasks done
+        friend class oogl::WorkerPool;
+
+
+        oogl::WorkerPool &                    m_pool;             ///!< Pool running the tasks.
+        std::atomic<std::size_t>              m_pending;          ///!< Tasks not done, plus HOLD
+                                                                  ///!< while continuations wait.
+        std::mutex                            m_mutex;            ///!< Protects the continuations.
+        std::vector<std::function<void()>>    m_continuations;    ///!< Continuations held back.
+
+    };
+
+}
+
+
+
+#endif    // OOGL_WORKERPOOL_HPP_INCLUDED
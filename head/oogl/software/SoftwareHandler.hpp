@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     SoftwareHandler.hpp
+///! \brief    This file contains the declaration of the class oogl::software::SoftwareHandler and
+///!           its features. The class oogl::software::SoftwareHandler is the graphic library
+///!           handler of the software library, which renders on the CPU without any display server.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                           // Non standard include guard
+
+#ifndef OOGL_SOFTWARE_SOFTWAREHANDLER_HPP_INCLUDED     // Standard include guard
+#define OOGL_SOFTWARE_SOFTWAREHANDLER_HPP_INCLUDED
+
+
+// Project include list
+#include "Compositor.hpp"
+#include "OOGLHandler.hpp"
+#include "software/TileRasterizer.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl SoftwareHandler.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  software SoftwareHandler.hpp
+///! \brief      The namespace oogl::software contains the features of the software graphic
+///!             library, which renders everything on the CPU without any display server.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace software
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    SoftwareHandler SoftwareHandler.hpp
+    ///! \brief    Graphic library handler of the software library. It owns the tile rasterizer
+    ///!           and the compositor, which spread the rendering work on the worker pool of the
+    ///!           handler. The class is final, so that the calls made on a SoftwareHandler are
+    ///!           bound at compile time, and inlined.
+    ///! \version  1.0.0
+    ///! \see      oogl::OOGLHandler
+    ///! \see      oogl::software::TileRasterizer
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class SoftwareHandler final : public oogl::OOGLHandler
+    {
+        public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the rasterizer of the library.
+        ///! \return   A reference to the tile rasterizer.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline TileRasterizer & getRasterizer() noexcept      { return m_rasterizer; }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Get the window compositor of the library, running on its workers.
+        ///! \return   A reference to the compositor.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        inline oogl::Compositor & getCompositor() noexcept    { return m_compositor; }
+
+
+
+        protected:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class constructor. As for the parent class, it is protected so that only an
+        ///!           OOGLHandlerFactory instance can create the handler.
+        ///! \version  1.0.0
+        ///! \see      oogl::OOGLHandlerFactory
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        SoftwareHandler();
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Class destructor.
+        ///! \version  1.0.0
+        ///! \see      oogl::OOGLHandlerFactory
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        virtual ~SoftwareHandler() = default;
+
+        // Friend class : factory class which need to access constructor/destructor
+        friend class oogl::OOGLHandlerFactory;
+
+
+
+        private:
+
+        TileRasterizer      m_rasterizer;    ///!< Rasterizer binning the frames into tiles.
+        oogl::Compositor    m_compositor;    ///!< Compositor of the window trees.
+
+    };
+
+}
+
+}
+
+
+
+#endif    // OOGL_SOFTWARE_SOFTWAREHANDLER_HPP_INCLUDED
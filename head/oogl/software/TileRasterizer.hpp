@@ -0,0 +1,193 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     TileRasterizer.hpp
+///! \brief    This file contains the declaration of the class oogl::software::TileRasterizer and
+///!           its features. The class oogl::software::TileRasterizer draws primitives on the CPU :
+///!           the primitives of a frame are binned into screen tiles, and the tiles are rasterized
+///!           independently from each other by the workers of a oogl::WorkerPool.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once                                          // Non standard include guard
+
+#ifndef OOGL_SOFTWARE_TILERASTERIZER_HPP_INCLUDED     // Standard include guard
+#define OOGL_SOFTWARE_TILERASTERIZER_HPP_INCLUDED
+
+
+// Standard include list
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Project include list
+#include "WorkerPool.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl TileRasterizer.hpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  software TileRasterizer.hpp
+///! \brief      The namespace oogl::software contains the features of the software graphic
+///!             library, which renders everything on the CPU without any display server.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace software
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \struct   RenderTarget TileRasterizer.hpp
+    ///! \brief    Describe the 32 bits pixels a frame gets rasterized into : the first pixel, the
+    ///!           number of pixels between two consecutive rows, the width and the height.
+    ///! \version  1.0.0
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    struct RenderTarget
+    {
+        uint32_t *      pixels;
+        std::size_t     pitch;
+        unsigned int    width;
+        unsigned int    height;
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    TileRasterizer TileRasterizer.hpp
+    ///! \brief    Tile based rasterizer. The drawing calls made between <code>beginFrame</code>
+    ///!           and <code>endFrame</code> are only recorded ; <code>endFrame</code> bins them
+    ///!           into tiles of TILE_SIZE x TILE_SIZE pixels and rasterizes every tile in parallel.
+    ///!           Within a tile, the primitives are drawn in their submission order.
+    ///! \version  1.0.0
+    ///! \see      oogl::WorkerPool
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class TileRasterizer
+    {
+        public:
+
+        static constexpr unsigned int TILE_SIZE = 64;    ///!< Width and height of a tile.
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief         Class constructor.
+        ///! \param pool    Workers the tiles get spread on.
+        ///! \version       1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        explicit TileRasterizer(oogl::WorkerPool & pool);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief           Start recording the primitives of a new frame.
+        ///! \param target    Pixels the frame gets rasterized into.
+        ///! \version         1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void beginFrame(RenderTarget const & target);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief          Fill the whole target with a color.
+        ///! \param color    Color of the pixels, as 0xAARRGGBB.
+        ///! \version        1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void clear(uint32_t color);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief          Fill an axis aligned rectangle with a color.
+        ///! \param x        Abscissa of the top left corner.
+        ///! \param y        Ordinate of the top left corner.
+        ///! \param width    Width of the rectangle.
+        ///! \param height   Height of the rectangle.
+        ///! \param color    Color of the pixels, as 0xAARRGGBB.
+        ///! \version        1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void fillRectangle(int x, int y, int width, int height, uint32_t color);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief          Fill a triangle with a color. A pixel is covered when its center lies
+        ///!                 inside the triangle, or on its top or left edges.
+        ///! \param x0       Abscissa of the first vertex.
+        ///! \param y0       Ordinate of the first vertex.
+        ///! \param x1       Abscissa of the second vertex.
+        ///! \param y1       Ordinate of the second vertex.
+        ///! \param x2       Abscissa of the third vertex.
+        ///! \param y2       Ordinate of the third vertex.
+        ///! \param color    Color of the pixels, as 0xAARRGGBB.
+        ///! \version        1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void fillTriangle(float x0, float y0, float x1, float y1, float x2, float y2,
+                          uint32_t color);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief    Bin the recorded primitives and rasterize the tiles on the workers. Returns
+        ///!          once the whole frame is drawn.
+        ///! \version  1.0.0
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void endFrame();
+
+
+
+        private:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief  Primitive recorded during a frame, with its bounding box in pixels.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        struct Primitive
+        {
+            enum Kind { RECTANGLE, TRIANGLE };
+
+            Kind        kind;
+            float       x[3];
+            float       y[3];
+            int         minX, minY, maxX, maxY;    ///!< Covered pixels, bounds excluded for max.
+            uint32_t    color;
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Record a primitive whose bounding box is already set.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void record(Primitive & primitive);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Bin a slice of the recorded primitives.
+        ///! \param slice      Index of the slice, that owns its own bins.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void binSlice(std::size_t slice);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Rasterize every primitive binned into a tile.
+        ///! \param tile       Index of the tile, row by row.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void rasterizeTile(std::size_t tile);
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        ///! \brief            Rasterize a primitive clipped by the tile bounds.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        void rasterize(Primitive const & primitive, int tileX, int tileY, int tileMaxX,
+                       int tileMaxY);
+
+
+        oogl::WorkerPool &                          m_pool;         ///!< Rasterization workers.
+        RenderTarget                                m_target;       ///!< Current frame target.
+        unsigned int                                m_tilesX;       ///!< Tiles on a row.
+        unsigned int                                m_tilesY;       ///!< Tiles on a column.
+        std::vector<Primitive>                      m_primitives;   ///!< Recorded primitives.
+
+        /*!< Bins, per slice of primitives then per tile, of the primitive indices. Bins are kept
+         *   between frames so that their memory gets reused.                                 */
+        std::vector<std::vector<std::vector<uint32_t>>>    m_bins;
+
+    };
+
+}
+
+}
+
+
+
+#endif    // OOGL_SOFTWARE_TILERASTERIZER_HPP_INCLUDED
@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     NullPlugin.cpp
+///! \brief    This file contains the declaration and the definition of the class
+///!           oogl::null::NullHandler, and the entry points of the null library plugin,
+///!           liboogl-null.so. The null library renders nothing : its handler only has the
+///!           tracker, subsystems and worker pool of any handler, for the tests of the framework
+///!           and of the plugin loading.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::OOGLHandler
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Include list
+#include "OOGLHandler.hpp"
+#include "OOGLPlugin.hpp"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  oogl NullPlugin.cpp
+///! \brief      The namespace oogl contains the different features (classes, P.O.D. structures...)
+///!             generalizing the current object oriented graphic framework. Most of the classes are
+///!             inherited in other specific namespaces, where the methods implementation is adapted
+///!             to the given embedded graphic library.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace oogl
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \namespace  null NullPlugin.cpp
+///! \brief      The namespace oogl::null contains the features of the null graphic library, which
+///!             renders nothing.
+///! \version    1.0.0
+////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace null
+{
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ///! \class    NullHandler NullPlugin.cpp
+    ///! \brief    Graphic library handler of the null library : the features of oogl::OOGLHandler,
+    ///!           and no rendering.
+    ///! \version  1.0.0
+    ///! \see      oogl::OOGLHandler
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    class NullHandler final : public oogl::OOGLHandler
+    {
+        protected:
+
+        // Class constructor and destructor, for the factory only
+        NullHandler() = default;
+        virtual ~NullHandler() = default;
+
+        // Friend class : factory class which need to access constructor/destructor
+        friend class oogl::OOGLHandlerFactory;
+
+    };
+
+}
+
+}
+
+
+
+//==================================================================================================
+// Entry points of the plugin.
+//==================================================================================================
+OOGL_PLUGIN(oogl::null::NullHandler)
@@ -0,0 +1,22 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     SoftwarePlugin.cpp
+///! \brief    This file contains the entry points of the software library plugin,
+///!           liboogl-software.so, built with the sources of the oogl::software namespace. The
+///!           factory loads it when the software library is not built in the framework
+///!           (OOGL_NO_BUILTIN_SOFTWARE), or when it is registered as a plugin.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::software::SoftwareHandler
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Include list
+#include "OOGLPlugin.hpp"
+#include "software/SoftwareHandler.hpp"
+
+
+
+//==================================================================================================
+// Entry points of the plugin.
+//==================================================================================================
+OOGL_PLUGIN(oogl::software::SoftwareHandler)
@@ -0,0 +1,345 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     AudioMixer.cpp
+///! \brief    This file contains the definition of the class oogl::AudioMixer and its features.
+///!           The class oogl::AudioMixer is the mixing engine of the audio subsystem : it sums the
+///!           playing voices by blocks, through vectorized kernels, into a ring buffer drained by
+///!           the audio output.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::AudioMixer
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <algorithm>
+#include <cmath>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define OOGL_AUDIOMIXER_X86                        // x86 kernels, built with target attributes
+#define OOGL_TARGET(isa)    __attribute__((target(isa)))
+#include <immintrin.h>
+#endif
+
+// Include list
+#include "Profiler.hpp"
+#include "WorkerPool.hpp"
+
+#include "AudioMixer.hpp"    // Inclusion of the header file which declares the class and features
+                             // which get defined here.
+
+
+
+//==================================================================================================
+// Mixing kernels : left += samples * leftGain and right += samples * rightGain. The SSE2 and AVX2
+// kernels multiply then add, as the scalar one, and give the same results ; AVX-512 implies FMA,
+// whose fused multiply-add skips a rounding.
+//==================================================================================================
+namespace
+{
+    void mixScalar(float * left, float * right, float const * samples, std::size_t count,
+                   float leftGain, float rightGain)
+    {
+        for (std::size_t index = 0; index < count; index++) {
+            left[index]  += samples[index] * leftGain;
+            right[index] += samples[index] * rightGain;
+        }
+    }
+
+
+    #if defined(OOGL_AUDIOMIXER_X86)
+
+    OOGL_TARGET("sse2")
+    void mixSse2(float * left, float * right, float const * samples, std::size_t count,
+                 float leftGain, float rightGain)
+    {
+        __m128 const  leftGains  = _mm_set1_ps(leftGain);
+        __m128 const  rightGains = _mm_set1_ps(rightGain);
+        std::size_t   index      = 0;
+
+        for (; index + 4 <= count; index += 4) {
+            __m128 const input = _mm_loadu_ps(samples + index);
+            _mm_storeu_ps(left + index,
+                          _mm_add_ps(_mm_loadu_ps(left + index), _mm_mul_ps(input, leftGains)));
+            _mm_storeu_ps(right + index,
+                          _mm_add_ps(_mm_loadu_ps(right + index), _mm_mul_ps(input, rightGains)));
+        }
+
+        mixScalar(left + index, right + index, samples + index, count - index, leftGain,
+                  rightGain);
+    }
+
+
+    OOGL_TARGET("avx2")
+    void mixAvx2(float * left, float * right, float const * samples, std::size_t count,
+                 float leftGain, float rightGain)
+    {
+        __m256 const  leftGains  = _mm256_set1_ps(leftGain);
+        __m256 const  rightGains = _mm256_set1_ps(rightGain);
+        std::size_t   index      = 0;
+
+        for (; index + 8 <= count; index += 8) {
+            __m256 const input = _mm256_loadu_ps(samples + index);
+            _mm256_storeu_ps(left + index, _mm256_add_ps(_mm256_loadu_ps(left + index),
+                                                         _mm256_mul_ps(input, leftGains)));
+            _mm256_storeu_ps(right + index, _mm256_add_ps(_mm256_loadu_ps(right + index),
+                                                          _mm256_mul_ps(input, rightGains)));
+        }
+
+        for (; index < count; index++) {    // tail kept in this function : no AVX to SSE switch
+            left[index]  += samples[index] * leftGain;
+            right[index] += samples[index] * rightGain;
+        }
+    }
+
+
+    OOGL_TARGET("avx512f")
+    void mixAvx512(float * left, float * right, float const * samples, std::size_t count,
+                   float leftGain, float rightGain)
+    {
+        __m512 const  leftGains  = _mm512_set1_ps(leftGain);
+        __m512 const  rightGains = _mm512_set1_ps(rightGain);
+        std::size_t   index      = 0;
+
+        for (; index + 16 <= count; index += 16) {
+            __m512 const input = _mm512_loadu_ps(samples + index);
+            _mm512_storeu_ps(left + index,
+                             _mm512_fmadd_ps(input, leftGains, _mm512_loadu_ps(left + index)));
+            _mm512_storeu_ps(right + index,
+                             _mm512_fmadd_ps(input, rightGains, _mm512_loadu_ps(right + index)));
+        }
+
+        if (index < count) {    // masked tail
+            __mmask16 const mask  = static_cast<__mmask16>((1u << (count - index)) - 1);
+            __m512 const    input = _mm512_maskz_loadu_ps(mask, samples + index);
+            _mm512_mask_storeu_ps(left + index, mask,
+                                  _mm512_fmadd_ps(input, leftGains,
+                                                  _mm512_maskz_loadu_ps(mask, left + index)));
+            _mm512_mask_storeu_ps(right + index, mask,
+                                  _mm512_fmadd_ps(input, rightGains,
+                                                  _mm512_maskz_loadu_ps(mask, right + index)));
+        }
+    }
+
+    #endif    // OOGL_AUDIOMIXER_X86
+
+
+    // Constant power pan law : the gains follow a quarter of circle from left to right.
+    void computeGains(float gain, float pan, float & leftGain, float & rightGain)
+    {
+        float const angle = (std::fmax(-1.f, std::fmin(1.f, pan)) + 1.f) * 0.785398163f;
+
+        leftGain  = gain * std::cos(angle);
+        rightGain = gain * std::sin(angle);
+    }
+}
+
+
+//==================================================================================================
+// Class constructor.
+//==================================================================================================
+oogl::AudioMixer::AudioMixer(unsigned int sampleRate, std::size_t ringFrames) :
+m_sampleRate(sampleRate), m_voices(), m_ended(), m_left(BLOCK_FRAMES), m_right(BLOCK_FRAMES),
+m_interleaved(BLOCK_FRAMES * 2), m_slices(), m_ring(std::max(ringFrames, BLOCK_FRAMES) * 2),
+m_underrunCount(0), m_kernel(mixScalar), m_isaLevel(oogl::IsaLevel::SCALAR), m_workerPool(nullptr)
+{
+    setIsaLevel(oogl::Blitter::detectIsaLevel());
+}
+
+
+//==================================================================================================
+// Start a voice.
+//==================================================================================================
+oogl::VoiceHandle oogl::AudioMixer::play(float const * samples, std::size_t length, float gain,
+                                         float pan, bool loop)
+{
+    Voice voice = { samples, length, 0, 0.f, 0.f, loop, oogl::INVALID_SLOT_HANDLE };
+    computeGains(gain, pan, voice.leftGain, voice.rightGain);
+
+    oogl::VoiceHandle const handle = m_voices.insert(voice);
+    m_voices.get(handle)->handle   = handle;
+
+    return handle;
+}
+
+
+//==================================================================================================
+// Stop a voice.
+//==================================================================================================
+bool oogl::AudioMixer::stop(oogl::VoiceHandle voice)
+{
+    return m_voices.erase(voice);
+}
+
+
+//==================================================================================================
+// Change the gains of a voice.
+//==================================================================================================
+bool oogl::AudioMixer::setVoice(oogl::VoiceHandle voice, float gain, float pan) noexcept
+{
+    Voice * const playing = m_voices.get(voice);
+
+    if (playing == nullptr) {    // stale handle
+        return false;
+    }
+
+    computeGains(gain, pan, playing->leftGain, playing->rightGain);
+
+    return true;
+}
+
+
+//==================================================================================================
+// Mix blocks while the ring has room for them.
+//==================================================================================================
+std::size_t oogl::AudioMixer::render(std::size_t frameCount)
+{
+    OOGL_PROFILE_ZONE("AudioMixer::render");
+
+    std::size_t mixed = 0;
+
+    while (mixed < frameCount && m_ring.getWritableCount() >= BLOCK_FRAMES * 2) {
+        mixBlock();
+        mixed += BLOCK_FRAMES;
+    }
+
+    return mixed;
+}
+
+
+//==================================================================================================
+// Take frames from the ring, and fill the missing ones with silence.
+//==================================================================================================
+void oogl::AudioMixer::pull(float * output, std::size_t frameCount) noexcept
+{
+    std::size_t const read = m_ring.read(output, frameCount * 2);
+
+    if (read < frameCount * 2) {    // the mixer is late : underrun
+        std::fill(output + read, output + frameCount * 2, 0.f);
+        m_underrunCount.fetch_add((frameCount * 2 - read) / 2, std::memory_order_relaxed);
+    }
+}
+
+
+//==================================================================================================
+// Feed a sink, block by block.
+//==================================================================================================
+void oogl::AudioMixer::drain(oogl::IAudioSink & sink, std::size_t frameCount)
+{
+    float block[BLOCK_FRAMES * 2];
+
+    for (std::size_t done = 0; done < frameCount; done += BLOCK_FRAMES) {
+        std::size_t const count = std::min(BLOCK_FRAMES, frameCount - done);
+
+        pull(block, count);
+        sink.write(block, count);
+    }
+}
+
+
+//==================================================================================================
+// Select the kernel of a level.
+//==================================================================================================
+void oogl::AudioMixer::setIsaLevel(oogl::IsaLevel level) noexcept
+{
+    level = std::min(level, oogl::Blitter::detectIsaLevel());
+
+    m_kernel   = mixScalar;
+    m_isaLevel = oogl::IsaLevel::SCALAR;
+
+    #if defined(OOGL_AUDIOMIXER_X86)
+    switch (level) {
+        case oogl::IsaLevel::AVX512:    m_kernel = mixAvx512;    break;
+        case oogl::IsaLevel::AVX2:      m_kernel = mixAvx2;      break;
+        case oogl::IsaLevel::SSE2:      m_kernel = mixSse2;      break;
+        default:                                                 break;
+    }
+    m_isaLevel = level;
+    #endif
+}
+
+
+//==================================================================================================
+// Mix one block : accumulate every voice into the planar buffers, then interleave the block into
+// the ring. The voices which reached their end get erased. When there are many voices and a pool,
+// each slice of voices is mixed into its own buffers by a task, and the slices get summed.
+//==================================================================================================
+void oogl::AudioMixer::mixBlock()
+{
+    std::fill(m_left.begin(), m_left.end(), 0.f);
+    std::fill(m_right.begin(), m_right.end(), 0.f);
+
+    Voice * const     voices     = m_voices.empty() ? nullptr : &*m_voices.begin();
+    std::size_t const voiceCount = m_voices.size();
+    std::size_t const sliceCount = (voiceCount + SLICE_VOICES - 1) / SLICE_VOICES;
+
+    if (m_workerPool == nullptr || ! m_workerPool->isRunning() || sliceCount < 2) {
+        mixVoices(voices, voices + voiceCount, m_left.data(), m_right.data(), m_ended);
+    } else {
+        if (m_slices.size() < sliceCount) {
+            m_slices.resize(sliceCount);
+        }
+
+        m_workerPool->parallelFor(sliceCount, [this, voices, voiceCount] (std::size_t index) {
+            Slice & slice = m_slices[index];
+            slice.left.assign(BLOCK_FRAMES, 0.f);
+            slice.right.assign(BLOCK_FRAMES, 0.f);
+            slice.ended.clear();
+
+            mixVoices(voices + index * SLICE_VOICES,
+                      voices + std::min((index + 1) * SLICE_VOICES, voiceCount),
+                      slice.left.data(), slice.right.data(), slice.ended);
+        });
+
+        for (std::size_t index = 0; index < sliceCount; index++) {
+            Slice const & slice = m_slices[index];
+
+            for (std::size_t frame = 0; frame < BLOCK_FRAMES; frame++) {
+                m_left[frame]  += slice.left[frame];
+                m_right[frame] += slice.right[frame];
+            }
+            m_ended.insert(m_ended.end(), slice.ended.begin(), slice.ended.end());
+        }
+    }
+
+    for (oogl::VoiceHandle const & voice : m_ended) {
+        m_voices.erase(voice);
+    }
+    m_ended.clear();
+
+    for (std::size_t frame = 0; frame < BLOCK_FRAMES; frame++) {
+        m_interleaved[2 * frame]     = m_left[frame];
+        m_interleaved[2 * frame + 1] = m_right[frame];
+    }
+
+    m_ring.write(m_interleaved.data(), m_interleaved.size());
+}
+
+
+//==================================================================================================
+// Accumulate a range of voices into planar buffers, wrapping the looping voices.
+//==================================================================================================
+void oogl::AudioMixer::mixVoices(Voice * first, Voice * last, float * left, float * right,
+                                 std::vector<oogl::VoiceHandle> & ended) const
+{
+    for (Voice * voice = first; voice != last; voice++) {
+        std::size_t done = 0;
+
+        while (done < BLOCK_FRAMES) {
+            std::size_t const count = std::min(BLOCK_FRAMES - done,
+                                               voice->length - voice->position);
+
+            m_kernel(left + done, right + done, voice->samples + voice->position, count,
+                     voice->leftGain, voice->rightGain);
+            done            += count;
+            voice->position += count;
+
+            if (voice->position == voice->length) {    // end of the samples
+                if (! voice->loop || voice->length == 0) {
+                    ended.push_back(voice->handle);
+                    break;
+                }
+                voice->position = 0;
+            }
+        }
+    }
+}
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     AudioRingBuffer.cpp
+///! \brief    This file contains the definition of the class oogl::AudioRingBuffer and its
+///!           features. The class oogl::AudioRingBuffer is the lock-free single-producer
+///!           single-consumer queue of samples between the audio mixer and the audio output.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::AudioRingBuffer
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <algorithm>
+#include <cstring>
+
+#include "AudioRingBuffer.hpp"    // Inclusion of the header file which declares the class and
+                                  // features which get defined here.
+
+
+
+//==================================================================================================
+// Class constructor.
+//==================================================================================================
+oogl::AudioRingBuffer::AudioRingBuffer(std::size_t capacity) :
+m_samples(), m_mask(1), m_writePosition(0), m_readPosition(0)
+{
+    while (m_mask + 1 < capacity) {    // round up to a power of two, at least two samples
+        m_mask = (m_mask << 1) | 1;
+    }
+
+    m_samples.reset(new float[m_mask + 1]());
+}
+
+
+//==================================================================================================
+// Write samples : copy them in at most two parts around the end of the ring, then publish them.
+//==================================================================================================
+std::size_t oogl::AudioRingBuffer::write(float const * samples, std::size_t count) noexcept
+{
+    std::size_t const position = m_writePosition.load(std::memory_order_relaxed);
+    std::size_t const consumed = m_readPosition.load(std::memory_order_acquire);
+    std::size_t const room     = m_mask + 1 - (position - consumed);
+
+    count = std::min(count, room);
+
+    std::size_t const offset = position & m_mask;
+    std::size_t const first  = std::min(count, m_mask + 1 - offset);
+
+    std::memcpy(&m_samples[offset], samples, first * sizeof(float));
+    std::memcpy(&m_samples[0], samples + first, (count - first) * sizeof(float));
+
+    m_writePosition.store(position + count, std::memory_order_release);
+
+    return count;
+}
+
+
+//==================================================================================================
+// Read samples : copy them in at most two parts around the end of the ring, then free the room.
+//==================================================================================================
+std::size_t oogl::AudioRingBuffer::read(float * samples, std::size_t count) noexcept
+{
+    std::size_t const position  = m_readPosition.load(std::memory_order_relaxed);
+    std::size_t const available = m_writePosition.load(std::memory_order_acquire) - position;
+
+    count = std::min(count, available);
+
+    std::size_t const offset = position & m_mask;
+    std::size_t const first  = std::min(count, m_mask + 1 - offset);
+
+    std::memcpy(samples, &m_samples[offset], first * sizeof(float));
+    std::memcpy(samples + first, &m_samples[0], (count - first) * sizeof(float));
+
+    m_readPosition.store(position + count, std::memory_order_release);
+
+    return count;
+}
+
+
+//==================================================================================================
+// Room left for the producer.
+//==================================================================================================
+std::size_t oogl::AudioRingBuffer::getWritableCount() const noexcept
+{
+    return m_mask + 1 - getReadableCount();
+}
+
+
+//==================================================================================================
+// Samples left for the consumer.
+//==================================================================================================
+std::size_t oogl::AudioRingBuffer::getReadableCount() const noexcept
+{
+    return m_writePosition.load(std::memory_order_acquire)
+         - m_readPosition.load(std::memory_order_acquire);
+}
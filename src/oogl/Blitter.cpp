@@ -0,0 +1,588 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     Blitter.cpp
+///! \brief    This file contains the definition of the class oogl::Blitter and its features.
+///!           The class oogl::Blitter copies, stretches and blends pixels between framebuffers,
+///!           through kernels chosen at run time for the instruction sets the processor supports.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::Blitter
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define OOGL_BLITTER_X86                           // x86 kernels, built with target attributes
+#define OOGL_TARGET(isa)    __attribute__((target(isa)))
+#include <immintrin.h>
+#endif
+
+#include "Blitter.hpp"    // Inclusion of the header file which declares the class and
+                          // features which get defined here.
+
+
+
+//==================================================================================================
+// Blending coefficients : the source is weighted by Fa = a0 * 255 + a1 * destination alpha and the
+// destination by Fb = b0 * 255 + b1 * source alpha, which covers every Porter-Duff operator. With
+// premultiplied pixels, source * Fa + destination * Fb never exceeds 255 * 255.
+//==================================================================================================
+namespace
+{
+    struct Coefficients
+    {
+        int16_t a0, a1, b0, b1;
+    };
+
+    Coefficients const COEFFICIENTS[] =
+    {
+        { 0,  0, 0,  0 },    // CLEAR
+        { 1,  0, 0,  0 },    // SOURCE
+        { 0,  0, 1,  0 },    // DESTINATION
+        { 1,  0, 1, -1 },    // SOURCE_OVER
+        { 1, -1, 1,  0 },    // DEST_OVER
+        { 0,  1, 0,  0 },    // SOURCE_IN
+        { 0,  0, 0,  1 },    // DEST_IN
+        { 1, -1, 0,  0 },    // SOURCE_OUT
+        { 0,  0, 1, -1 },    // DEST_OUT
+        { 0,  1, 1, -1 },    // SOURCE_ATOP
+        { 1, -1, 0,  1 },    // DEST_ATOP
+        { 1, -1, 1, -1 }     // XOR
+    };
+
+
+    //==============================================================================================
+    // Scalar kernels, also used for the tails of the vector kernels.
+    //==============================================================================================
+
+    // Division by 255 of a product of two 8 bits values, rounded to the nearest.
+    inline uint32_t divide255(uint32_t value)
+    {
+        value += 128;
+        return (value + (value >> 8)) >> 8;
+    }
+
+    void copyScalar(uint32_t * destination, uint32_t const * source, std::size_t length)
+    {
+        std::memmove(destination, source, length * sizeof(uint32_t));
+    }
+
+    void stretchScalar(uint32_t * destination, uint32_t const * source, std::size_t length,
+                       uint32_t start, uint32_t step)
+    {
+        for (std::size_t index = 0; index < length; index++, start += step) {
+            destination[index] = source[start >> 16];
+        }
+    }
+
+    void blendScalar(uint32_t * destination, uint32_t const * source, std::size_t length,
+                     Coefficients const & coefficients)
+    {
+        for (std::size_t index = 0; index < length; index++) {
+            uint32_t const top    = source[index];
+            uint32_t const bottom = destination[index];
+
+            uint32_t const topFactor    = coefficients.a0 * 255 + coefficients.a1 * (bottom >> 24);
+            uint32_t const bottomFactor = coefficients.b0 * 255 + coefficients.b1 * (top >> 24);
+
+            uint32_t blended = 0;
+            for (unsigned int shift = 0; shift < 32; shift += 8) {
+                blended |= divide255(((top >> shift) & 0xFF) * topFactor
+                                     + ((bottom >> shift) & 0xFF) * bottomFactor) << shift;
+            }
+
+            destination[index] = blended;
+        }
+    }
+
+
+    #if defined(OOGL_BLITTER_X86)
+
+    //==============================================================================================
+    // SSE2 kernels : 4 pixels per iteration. The pixels get unpacked to 16 bits channels, with
+    // the alpha channel broadcast to the whole pixel by 16 bits shuffles.
+    //==============================================================================================
+
+    OOGL_TARGET("sse2")
+    void copySse2(uint32_t * destination, uint32_t const * source, std::size_t length)
+    {
+        std::size_t index = 0;
+
+        for (; index + 16 <= length; index += 16) {
+            __m128i const * from = reinterpret_cast<__m128i const *>(source + index);
+            __m128i *       to   = reinterpret_cast<__m128i *>(destination + index);
+
+            __m128i const first  = _mm_loadu_si128(from);
+            __m128i const second = _mm_loadu_si128(from + 1);
+            __m128i const third  = _mm_loadu_si128(from + 2);
+            __m128i const fourth = _mm_loadu_si128(from + 3);
+
+            _mm_storeu_si128(to,     first);
+            _mm_storeu_si128(to + 1, second);
+            _mm_storeu_si128(to + 2, third);
+            _mm_storeu_si128(to + 3, fourth);
+        }
+
+        copyScalar(destination + index, source + index, length - index);
+    }
+
+    OOGL_TARGET("sse2")
+    inline __m128i blendHalfSse2(__m128i top, __m128i bottom, __m128i a0, __m128i a1, __m128i b0,
+                                 __m128i b1)
+    {
+        __m128i const topAlpha    = _mm_shufflehi_epi16(_mm_shufflelo_epi16(top,    0xFF), 0xFF);
+        __m128i const bottomAlpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(bottom, 0xFF), 0xFF);
+
+        __m128i const topFactor    = _mm_add_epi16(a0, _mm_mullo_epi16(bottomAlpha, a1));
+        __m128i const bottomFactor = _mm_add_epi16(b0, _mm_mullo_epi16(topAlpha,    b1));
+
+        __m128i sum = _mm_add_epi16(_mm_mullo_epi16(top,    topFactor),
+                                    _mm_mullo_epi16(bottom, bottomFactor));
+        sum = _mm_add_epi16(sum, _mm_set1_epi16(128));
+
+        return _mm_srli_epi16(_mm_add_epi16(sum, _mm_srli_epi16(sum, 8)), 8);
+    }
+
+    OOGL_TARGET("sse2")
+    void blendSse2(uint32_t * destination, uint32_t const * source, std::size_t length,
+                   Coefficients const & coefficients)
+    {
+        __m128i const zero = _mm_setzero_si128();
+        __m128i const a0   = _mm_set1_epi16(static_cast<int16_t>(coefficients.a0 * 255));
+        __m128i const a1   = _mm_set1_epi16(coefficients.a1);
+        __m128i const b0   = _mm_set1_epi16(static_cast<int16_t>(coefficients.b0 * 255));
+        __m128i const b1   = _mm_set1_epi16(coefficients.b1);
+
+        std::size_t index = 0;
+
+        for (; index + 4 <= length; index += 4) {
+            __m128i const top    = _mm_loadu_si128(
+                reinterpret_cast<__m128i const *>(source + index));
+            __m128i const bottom = _mm_loadu_si128(
+                reinterpret_cast<__m128i const *>(destination + index));
+
+            __m128i const low  = blendHalfSse2(_mm_unpacklo_epi8(top, zero),
+                                               _mm_unpacklo_epi8(bottom, zero), a0, a1, b0, b1);
+            __m128i const high = blendHalfSse2(_mm_unpackhi_epi8(top, zero),
+                                               _mm_unpackhi_epi8(bottom, zero), a0, a1, b0, b1);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + index),
+                             _mm_packus_epi16(low, high));
+        }
+
+        blendScalar(destination + index, source + index, length - index, coefficients);
+    }
+
+
+    //==============================================================================================
+    // AVX2 kernels : 8 pixels per iteration. Unpacking and packing both work within 128 bits
+    // lanes, so the pixel order is kept. Stretching reads the source pixels with gathers.
+    //==============================================================================================
+
+    OOGL_TARGET("avx2")
+    void copyAvx2(uint32_t * destination, uint32_t const * source, std::size_t length)
+    {
+        std::size_t index = 0;
+
+        for (; index + 32 <= length; index += 32) {
+            __m256i const * from = reinterpret_cast<__m256i const *>(source + index);
+            __m256i *       to   = reinterpret_cast<__m256i *>(destination + index);
+
+            __m256i const first  = _mm256_loadu_si256(from);
+            __m256i const second = _mm256_loadu_si256(from + 1);
+            __m256i const third  = _mm256_loadu_si256(from + 2);
+            __m256i const fourth = _mm256_loadu_si256(from + 3);
+
+            _mm256_storeu_si256(to,     first);
+            _mm256_storeu_si256(to + 1, second);
+            _mm256_storeu_si256(to + 2, third);
+            _mm256_storeu_si256(to + 3, fourth);
+        }
+
+        copyScalar(destination + index, source + index, length - index);
+    }
+
+    OOGL_TARGET("avx2")
+    void stretchAvx2(uint32_t * destination, uint32_t const * source, std::size_t length,
+                     uint32_t start, uint32_t step)
+    {
+        __m256i       position  = _mm256_add_epi32(
+            _mm256_set1_epi32(static_cast<int>(start)),
+            _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                               _mm256_set1_epi32(static_cast<int>(step)))
+        );
+        __m256i const increment = _mm256_set1_epi32(static_cast<int>(step * 8));
+
+        std::size_t index = 0;
+
+        for (; index + 8 <= length; index += 8) {
+            __m256i const pixels = _mm256_i32gather_epi32(
+                reinterpret_cast<int const *>(source), _mm256_srli_epi32(position, 16), 4
+            );
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + index), pixels);
+            position = _mm256_add_epi32(position, increment);
+        }
+
+        stretchScalar(destination + index, source, length - index,
+                      start + static_cast<uint32_t>(index) * step, step);
+    }
+
+    OOGL_TARGET("avx2")
+    inline __m256i blendHalfAvx2(__m256i top, __m256i bottom, __m256i a0, __m256i a1, __m256i b0,
+                                 __m256i b1)
+    {
+        __m256i const topAlpha    = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(top,    0xFF),
+                                                           0xFF);
+        __m256i const bottomAlpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(bottom, 0xFF),
+                                                           0xFF);
+
+        __m256i const topFactor    = _mm256_add_epi16(a0, _mm256_mullo_epi16(bottomAlpha, a1));
+        __m256i const bottomFactor = _mm256_add_epi16(b0, _mm256_mullo_epi16(topAlpha,    b1));
+
+        __m256i sum = _mm256_add_epi16(_mm256_mullo_epi16(top,    topFactor),
+                                       _mm256_mullo_epi16(bottom, bottomFactor));
+        sum = _mm256_add_epi16(sum, _mm256_set1_epi16(128));
+
+        return _mm256_srli_epi16(_mm256_add_epi16(sum, _mm256_srli_epi16(sum, 8)), 8);
+    }
+
+    OOGL_TARGET("avx2")
+    void blendAvx2(uint32_t * destination, uint32_t const * source, std::size_t length,
+                   Coefficients const & coefficients)
+    {
+        __m256i const zero = _mm256_setzero_si256();
+        __m256i const a0   = _mm256_set1_epi16(static_cast<int16_t>(coefficients.a0 * 255));
+        __m256i const a1   = _mm256_set1_epi16(coefficients.a1);
+        __m256i const b0   = _mm256_set1_epi16(static_cast<int16_t>(coefficients.b0 * 255));
+        __m256i const b1   = _mm256_set1_epi16(coefficients.b1);
+
+        std::size_t index = 0;
+
+        for (; index + 8 <= length; index += 8) {
+            __m256i const top    = _mm256_loadu_si256(
+                reinterpret_cast<__m256i const *>(source + index));
+            __m256i const bottom = _mm256_loadu_si256(
+                reinterpret_cast<__m256i const *>(destination + index));
+
+            __m256i const low  = blendHalfAvx2(_mm256_unpacklo_epi8(top, zero),
+                                               _mm256_unpacklo_epi8(bottom, zero), a0, a1, b0, b1);
+            __m256i const high = blendHalfAvx2(_mm256_unpackhi_epi8(top, zero),
+                                               _mm256_unpackhi_epi8(bottom, zero), a0, a1, b0, b1);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + index),
+                                _mm256_packus_epi16(low, high));
+        }
+
+        _mm256_zeroupper();    // the tail call skips the implicit clear : avoid AVX to SSE stalls
+        blendScalar(destination + index, source + index, length - index, coefficients);
+    }
+
+
+    //==============================================================================================
+    // AVX-512 kernels : 16 pixels per iteration, same scheme as the AVX2 ones. The 16 bits
+    // operations require the BW extension.
+    //==============================================================================================
+
+    OOGL_TARGET("avx512f,avx512bw")
+    void copyAvx512(uint32_t * destination, uint32_t const * source, std::size_t length)
+    {
+        std::size_t index = 0;
+
+        for (; index + 64 <= length; index += 64) {
+            __m512i const first  = _mm512_loadu_si512(source + index);
+            __m512i const second = _mm512_loadu_si512(source + index + 16);
+            __m512i const third  = _mm512_loadu_si512(source + index + 32);
+            __m512i const fourth = _mm512_loadu_si512(source + index + 48);
+
+            _mm512_storeu_si512(destination + index,      first);
+            _mm512_storeu_si512(destination + index + 16, second);
+            _mm512_storeu_si512(destination + index + 32, third);
+            _mm512_storeu_si512(destination + index + 48, fourth);
+        }
+
+        copyScalar(destination + index, source + index, length - index);
+    }
+
+    OOGL_TARGET("avx512f,avx512bw")
+    void stretchAvx512(uint32_t * destination, uint32_t const * source, std::size_t length,
+                       uint32_t start, uint32_t step)
+    {
+        __m512i       position  = _mm512_add_epi32(
+            _mm512_set1_epi32(static_cast<int>(start)),
+            _mm512_mullo_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13,
+                                                 14, 15),
+                               _mm512_set1_epi32(static_cast<int>(step)))
+        );
+        __m512i const increment = _mm512_set1_epi32(static_cast<int>(step * 16));
+
+        std::size_t index = 0;
+
+        for (; index + 16 <= length; index += 16) {
+            __m512i const pixels = _mm512_i32gather_epi32(_mm512_srli_epi32(position, 16),
+                                                          source, 4);
+            _mm512_storeu_si512(destination + index, pixels);
+            position = _mm512_add_epi32(position, increment);
+        }
+
+        stretchScalar(destination + index, source, length - index,
+                      start + static_cast<uint32_t>(index) * step, step);
+    }
+
+    OOGL_TARGET("avx512f,avx512bw")
+    inline __m512i blendHalfAvx512(__m512i top, __m512i bottom, __m512i a0, __m512i a1,
+                                   __m512i b0, __m512i b1)
+    {
+        __m512i const topAlpha    = _mm512_shufflehi_epi16(_mm512_shufflelo_epi16(top,    0xFF),
+                                                           0xFF);
+        __m512i const bottomAlpha = _mm512_shufflehi_epi16(_mm512_shufflelo_epi16(bottom, 0xFF),
+                                                           0xFF);
+
+        __m512i const topFactor    = _mm512_add_epi16(a0, _mm512_mullo_epi16(bottomAlpha, a1));
+        __m512i const bottomFactor = _mm512_add_epi16(b0, _mm512_mullo_epi16(topAlpha,    b1));
+
+        __m512i sum = _mm512_add_epi16(_mm512_mullo_epi16(top,    topFactor),
+                                       _mm512_mullo_epi16(bottom, bottomFactor));
+        sum = _mm512_add_epi16(sum, _mm512_set1_epi16(128));
+
+        return _mm512_srli_epi16(_mm512_add_epi16(sum, _mm512_srli_epi16(sum, 8)), 8);
+    }
+
+    OOGL_TARGET("avx512f,avx512bw")
+    void blendAvx512(uint32_t * destination, uint32_t const * source, std::size_t length,
+                     Coefficients const & coefficients)
+    {
+        __m512i const zero = _mm512_setzero_si512();
+        __m512i const a0   = _mm512_set1_epi16(static_cast<int16_t>(coefficients.a0 * 255));
+        __m512i const a1   = _mm512_set1_epi16(coefficients.a1);
+        __m512i const b0   = _mm512_set1_epi16(static_cast<int16_t>(coefficients.b0 * 255));
+        __m512i const b1   = _mm512_set1_epi16(coefficients.b1);
+
+        std::size_t index = 0;
+
+        for (; index + 16 <= length; index += 16) {
+            __m512i const top    = _mm512_loadu_si512(source + index);
+            __m512i const bottom = _mm512_loadu_si512(destination + index);
+
+            __m512i const low  = blendHalfAvx512(_mm512_unpacklo_epi8(top, zero),
+                                                 _mm512_unpacklo_epi8(bottom, zero),
+                                                 a0, a1, b0, b1);
+            __m512i const high = blendHalfAvx512(_mm512_unpackhi_epi8(top, zero),
+                                                 _mm512_unpackhi_epi8(bottom, zero),
+                                                 a0, a1, b0, b1);
+
+            _mm512_storeu_si512(destination + index, _mm512_packus_epi16(low, high));
+        }
+
+        _mm256_zeroupper();    // the tail call skips the implicit clear : avoid AVX to SSE stalls
+        blendScalar(destination + index, source + index, length - index, coefficients);
+    }
+
+    #endif    // OOGL_BLITTER_X86
+
+
+    //==============================================================================================
+    // Kernel tables, one per instruction set level. SSE2 has no gather : stretching stays scalar.
+    //==============================================================================================
+    struct KernelTable
+    {
+        oogl::IsaLevel    level;
+        void (*copy)(uint32_t *, uint32_t const *, std::size_t);
+        void (*stretch)(uint32_t *, uint32_t const *, std::size_t, uint32_t, uint32_t);
+        void (*blend)(uint32_t *, uint32_t const *, std::size_t, Coefficients const &);
+    };
+
+    KernelTable const SCALAR_KERNELS = {
+        oogl::IsaLevel::SCALAR, copyScalar, stretchScalar, blendScalar
+    };
+
+    #if defined(OOGL_BLITTER_X86)
+    KernelTable const SSE2_KERNELS = {
+        oogl::IsaLevel::SSE2,   copySse2,   stretchScalar, blendSse2
+    };
+    KernelTable const AVX2_KERNELS = {
+        oogl::IsaLevel::AVX2,   copyAvx2,   stretchAvx2,   blendAvx2
+    };
+    KernelTable const AVX512_KERNELS = {
+        oogl::IsaLevel::AVX512, copyAvx512, stretchAvx512, blendAvx512
+    };
+    #endif
+
+    // Kernels in use ; written at the handler initialization, read by any thread.
+    std::atomic<KernelTable const *> s_kernels(&SCALAR_KERNELS);
+
+    inline KernelTable const & kernels()
+    {
+        return *s_kernels.load(std::memory_order_relaxed);
+    }
+
+    // Clip a rectangle of the source, copied at (x, y) in the destination, to both framebuffers.
+    bool clip(oogl::Framebuffer const & destination, unsigned int x, unsigned int y,
+              oogl::Framebuffer const & source, oogl::Rectangle & area)
+    {
+        if (area.xPosition >= source.getWidth() || area.yPosition >= source.getHeight()
+            || x >= destination.getWidth() || y >= destination.getHeight()) {
+            return false;
+        }
+
+        area.width  = std::min({area.width,  source.getWidth()  - area.xPosition,
+                                destination.getWidth()  - x});
+        area.height = std::min({area.height, source.getHeight() - area.yPosition,
+                                destination.getHeight() - y});
+
+        return area.width != 0 && area.height != 0;
+    }
+}
+
+
+//==================================================================================================
+// Best supported instruction set level, through CPUID.
+//==================================================================================================
+oogl::IsaLevel oogl::Blitter::detectIsaLevel() noexcept
+{
+    #if defined(OOGL_BLITTER_X86)
+
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return oogl::IsaLevel::AVX512;
+    } else if (__builtin_cpu_supports("avx2")) {
+        return oogl::IsaLevel::AVX2;
+    } else if (__builtin_cpu_supports("sse2")) {
+        return oogl::IsaLevel::SSE2;
+    }
+
+    #endif
+
+    return oogl::IsaLevel::SCALAR;
+}
+
+
+//==================================================================================================
+// Select the kernel table, the level being capped by the supported one.
+//==================================================================================================
+void oogl::Blitter::selectKernels(oogl::IsaLevel level) noexcept
+{
+    level = std::min(level, detectIsaLevel());
+
+    KernelTable const * table = &SCALAR_KERNELS;
+
+    #if defined(OOGL_BLITTER_X86)
+    switch (level) {
+        case oogl::IsaLevel::AVX512:    table = &AVX512_KERNELS;    break;
+        case oogl::IsaLevel::AVX2:      table = &AVX2_KERNELS;      break;
+        case oogl::IsaLevel::SSE2:      table = &SSE2_KERNELS;      break;
+        default:                                                    break;
+    }
+    #endif
+
+    s_kernels.store(table, std::memory_order_relaxed);
+}
+
+
+//==================================================================================================
+// Level of the kernels in use.
+//==================================================================================================
+oogl::IsaLevel oogl::Blitter::getIsaLevel() noexcept
+{
+    return kernels().level;
+}
+
+
+//==================================================================================================
+// Copy a clipped rectangle, row by row.
+//==================================================================================================
+void oogl::Blitter::blit(oogl::Framebuffer & destination, unsigned int x, unsigned int y,
+                         oogl::Framebuffer const & source, oogl::Rectangle const & area) noexcept
+{
+    oogl::Rectangle clipped = area;
+    if (! clip(destination, x, y, source, clipped)) {
+        return;
+    }
+
+    KernelTable const & table = kernels();
+
+    for (unsigned int row = 0; row < clipped.height; row++) {
+        table.copy(destination.getRow(y + row) + x,
+                   source.getRow(clipped.yPosition + row) + clipped.xPosition, clipped.width);
+    }
+}
+
+
+//==================================================================================================
+// Stretch a rectangle : source positions are stepped in 16.16 fixed point, so that the target
+// rows that got clipped on the left or on the top are simply skipped.
+//==================================================================================================
+void oogl::Blitter::stretchBlit(oogl::Framebuffer & destination, oogl::Rectangle const & target,
+                                oogl::Framebuffer const & source,
+                                oogl::Rectangle const & area) noexcept
+{
+    if (area.width == 0 || area.height == 0 || target.width == 0 || target.height == 0
+        || target.xPosition >= destination.getWidth()
+        || target.yPosition >= destination.getHeight()) {
+        return;
+    }
+
+    uint32_t const stepX = (static_cast<uint32_t>(area.width)  << 16) / target.width;
+    uint32_t const stepY = (static_cast<uint32_t>(area.height) << 16) / target.height;
+
+    unsigned int const width  = std::min(target.width,  destination.getWidth()  - target.xPosition);
+    unsigned int const height = std::min(target.height, destination.getHeight() - target.yPosition);
+
+    KernelTable const & table = kernels();
+
+    for (unsigned int row = 0; row < height; row++) {
+        unsigned int const sourceY = area.yPosition + ((row * stepY) >> 16);
+
+        table.stretch(destination.getRow(target.yPosition + row) + target.xPosition,
+                      source.getRow(sourceY), width,
+                      static_cast<uint32_t>(area.xPosition) << 16, stepX);
+    }
+}
+
+
+//==================================================================================================
+// Blend a clipped rectangle, row by row.
+//==================================================================================================
+void oogl::Blitter::blend(oogl::Framebuffer & destination, unsigned int x, unsigned int y,
+                          oogl::Framebuffer const & source, oogl::Rectangle const & area,
+                          oogl::BlendMode mode) noexcept
+{
+    oogl::Rectangle clipped = area;
+    if (! clip(destination, x, y, source, clipped)) {
+        return;
+    }
+
+    KernelTable const &  table        = kernels();
+    Coefficients const & coefficients = COEFFICIENTS[static_cast<int>(mode)];
+
+    for (unsigned int row = 0; row < clipped.height; row++) {
+        table.blend(destination.getRow(y + row) + x,
+                    source.getRow(clipped.yPosition + row) + clipped.xPosition, clipped.width,
+                    coefficients);
+    }
+}
+
+
+//==================================================================================================
+// Span operations, straight to the kernels in use.
+//==================================================================================================
+void oogl::Blitter::copySpan(uint32_t * destination, uint32_t const * source,
+                             std::size_t length) noexcept
+{
+    kernels().copy(destination, source, length);
+}
+
+void oogl::Blitter::stretchSpan(uint32_t * destination, uint32_t const * source,
+                                std::size_t length, uint32_t start, uint32_t step) noexcept
+{
+    kernels().stretch(destination, source, length, start, step);
+}
+
+void oogl::Blitter::blendSpan(uint32_t * destination, uint32_t const * source,
+                              std::size_t length, oogl::BlendMode mode) noexcept
+{
+    kernels().blend(destination, source, length, COEFFICIENTS[static_cast<int>(mode)]);
+}
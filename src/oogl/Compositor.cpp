@@ -0,0 +1,305 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     Compositor.cpp
+///! \brief    This file contains the definition of the class oogl::Compositor and its features.
+///!           The class oogl::Compositor composes a window tree into a target framebuffer : the
+///!           content of the visible windows gets blended over the content of the root.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::Compositor
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <algorithm>
+
+// Include list
+#include "Blitter.hpp"
+#include "Profiler.hpp"
+
+#include "Compositor.hpp"    // Inclusion of the header file which declares the class and
+                             // features which get defined here.
+
+
+
+//==================================================================================================
+// Rectangle helpers.
+//==================================================================================================
+namespace
+{
+    // Intersection of two rectangles ; its width or height is zero when they do not overlap.
+    oogl::Rectangle intersect(oogl::Rectangle const & first, oogl::Rectangle const & second)
+    {
+        unsigned int const left   = std::max(first.xPosition, second.xPosition);
+        unsigned int const top    = std::max(first.yPosition, second.yPosition);
+        unsigned int const right  = std::min(first.xPosition + first.width,
+                                             second.xPosition + second.width);
+        unsigned int const bottom = std::min(first.yPosition + first.height,
+                                             second.yPosition + second.height);
+
+        if (left >= right || top >= bottom) {
+            return oogl::Rectangle { left, top, 0, 0 };
+        }
+
+        return oogl::Rectangle { left, top, right - left, bottom - top };
+    }
+
+    // Remove the occluder from every rectangle of the region : each rectangle is split into the
+    // (at most four) bands left around the occluder.
+    void subtract(std::vector<oogl::Rectangle> & region, oogl::Rectangle const & occluder)
+    {
+        std::vector<oogl::Rectangle> result;
+
+        for (oogl::Rectangle const & rectangle : region) {
+            oogl::Rectangle const hole = intersect(rectangle, occluder);
+
+            if (hole.width == 0 || hole.height == 0) {    // untouched by the occluder
+                result.push_back(rectangle);
+                continue;
+            }
+
+            unsigned int const right  = rectangle.xPosition + rectangle.width;
+            unsigned int const bottom = rectangle.yPosition + rectangle.height;
+
+            if (hole.yPosition > rectangle.yPosition) {                      // band above
+                result.push_back({ rectangle.xPosition, rectangle.yPosition,
+                                   rectangle.width, hole.yPosition - rectangle.yPosition });
+            }
+            if (hole.yPosition + hole.height < bottom) {                      // band below
+                result.push_back({ rectangle.xPosition, hole.yPosition + hole.height,
+                                   rectangle.width, bottom - hole.yPosition - hole.height });
+            }
+            if (hole.xPosition > rectangle.xPosition) {                      // band on the left
+                result.push_back({ rectangle.xPosition, hole.yPosition,
+                                   hole.xPosition - rectangle.xPosition, hole.height });
+            }
+            if (hole.xPosition + hole.width < right) {                        // band on the right
+                result.push_back({ hole.xPosition + hole.width, hole.yPosition,
+                                   right - hole.xPosition - hole.width, hole.height });
+            }
+        }
+
+        region.swap(result);
+    }
+
+    // Whether two rectangles are the same.
+    bool isSame(oogl::Rectangle const & first, oogl::Rectangle const & second)
+    {
+        return first.xPosition == second.xPosition && first.yPosition == second.yPosition
+            && first.width == second.width && first.height == second.height;
+    }
+}
+
+
+//==================================================================================================
+// Class constructor : nothing composed yet.
+//==================================================================================================
+oogl::Compositor::Compositor(oogl::WorkerPool & pool) noexcept :
+m_pool(pool), m_damage(), m_drawList(), m_placements(), m_target(nullptr), m_root(nullptr)
+{}
+
+
+//==================================================================================================
+// Compose a tree : find the damage from the draw list, cull the windows away from it or covered,
+// then compose the damaged rows band by band. Bands never share a pixel of the target.
+//==================================================================================================
+oogl::DamageRegion const & oogl::Compositor::compose(oogl::Window & root,
+                                                     oogl::Framebuffer & target)
+{
+    OOGL_PROFILE_ZONE("Compositor::compose");
+
+    oogl::Rectangle const dimensions = root.getDimensions();
+    bool const            isFresh    = &target != m_target || &root != m_root
+                                       || target.getPixels() == nullptr
+                                       || target.getWidth() != dimensions.width
+                                       || target.getHeight() != dimensions.height;
+
+    if (isFresh) {    // the target holds nothing composed from this tree
+        target.allocate(dimensions.width, dimensions.height);
+        m_placements.clear();
+        m_target = &target;
+        m_root   = &root;
+    }
+
+    m_damage.clear();
+    m_drawList.clear();
+
+    collect(root, 0, 0, { 0, 0, dimensions.width, dimensions.height });
+    collectDamage();
+
+    if (isFresh) {
+        m_damage.clear();
+        m_damage.add({ 0, 0, dimensions.width, dimensions.height });
+    }
+
+    m_damage.clip(dimensions.width, dimensions.height);
+
+    if (m_damage.isEmpty()) {    // nothing changed
+        return m_damage;
+    }
+
+    cull();
+
+    oogl::Rectangle const bounds = m_damage.getBounds();
+    unsigned int const    first  = bounds.yPosition / BAND_HEIGHT;
+    unsigned int const    last   = (bounds.yPosition + bounds.height - 1) / BAND_HEIGHT;
+
+    m_pool.parallelFor(last - first + 1, [this, &target, first] (std::size_t band) {
+        unsigned int const top = (first + static_cast<unsigned int>(band)) * BAND_HEIGHT;
+        composeBand(target, top, top + BAND_HEIGHT);
+    });
+
+    return m_damage;
+}
+
+
+//==================================================================================================
+// Walk the tree in drawing order : the window, then its children from the bottom of the stack up.
+// Each window is clipped to the area of its parent.
+//==================================================================================================
+void oogl::Compositor::collect(oogl::Window & window, unsigned int x, unsigned int y,
+                               oogl::Rectangle const & bounds)
+{
+    oogl::Rectangle const dimensions = window.getDimensions();
+    oogl::Rectangle const clip       = intersect({ x, y, dimensions.width, dimensions.height },
+                                                 bounds);
+
+    if (clip.width == 0 || clip.height == 0
+        || window.getFramebuffer().getPixels() == nullptr) {    // nothing to show
+        return;
+    }
+
+    oogl::Window const * const below = m_drawList.empty() ? nullptr : m_drawList.back().window;
+    m_drawList.push_back(DrawCall { &window, Placement { x, y, clip, below }, {} });
+
+    for (oogl::Window * child = window.getFirstChild(); child != nullptr;
+         child = child->getNextSibling()) {
+        if (! child->hasOption(oogl::WindowOption::HIDDEN)
+            && ! child->hasOption(oogl::WindowOption::MINIMIZED)) {
+            oogl::Rectangle const area = child->getDimensions();
+            collect(*child, x + area.xPosition, y + area.yPosition, clip);
+        }
+    }
+}
+
+
+//==================================================================================================
+// Damage of the draw list : the rectangles drawn in each window, the old and new areas of the
+// windows placed differently or drawn after another window, and the areas of the windows gone
+// since the previous composition.
+//==================================================================================================
+void oogl::Compositor::collectDamage()
+{
+    std::unordered_map<oogl::Window const *, Placement> placements(m_drawList.size());
+
+    for (DrawCall const & call : m_drawList) {
+        Placement const & current  = call.placement;
+        auto const        previous = m_placements.find(call.window);
+
+        if (previous == m_placements.end()) {    // new, or shown again
+            m_damage.add(current.clip);
+        } else {
+            Placement const & former = previous->second;
+
+            if (former.x != current.x || former.y != current.y || former.below != current.below
+                || ! isSame(former.clip, current.clip)) {    // moved, resized or restacked
+                m_damage.add(former.clip);
+                m_damage.add(current.clip);
+            }
+
+            m_placements.erase(previous);
+        }
+
+        for (oogl::Rectangle const & rectangle : call.window->getDamage().getRectangles()) {
+            m_damage.add(intersect({ current.x + rectangle.xPosition,
+                                     current.y + rectangle.yPosition,
+                                     rectangle.width, rectangle.height }, current.clip));
+        }
+
+        call.window->clearDamage();
+        placements.emplace(call.window, current);
+    }
+
+    for (auto const & gone : m_placements) {    // hidden, unlinked or out of their parent
+        m_damage.add(gone.second.clip);
+    }
+
+    m_placements.swap(placements);
+}
+
+
+//==================================================================================================
+// Visible rectangles of the draw calls : walk the draw list from the last call drawn, so that the
+// area covered by the opaque windows drawn after each call is known when reaching it. Only the
+// windows declared OPAQUE cover the ones below them.
+//==================================================================================================
+void oogl::Compositor::cull()
+{
+    oogl::Rectangle const        bounds = m_damage.getBounds();
+    std::vector<oogl::Rectangle> covered;
+
+    for (auto call = m_drawList.rbegin(); call != m_drawList.rend(); ++call) {
+        oogl::Rectangle const area = intersect(call->placement.clip, bounds);
+
+        call->visible.clear();
+
+        if (area.width == 0 || area.height == 0) {    // away from the damage
+            continue;
+        }
+
+        call->visible.push_back(area);
+        for (oogl::Rectangle const & occluder : covered) {
+            subtract(call->visible, occluder);
+        }
+
+        if (call->window->hasOption(oogl::WindowOption::OPAQUE)) {
+            covered.push_back(area);
+        }
+    }
+}
+
+
+//==================================================================================================
+// Compose the damaged rectangles of a band : for each one, the root gets copied, then the other
+// windows get blended over it in drawing order, so that a pixel comes out the same whatever the
+// rectangles overlapping it.
+//==================================================================================================
+void oogl::Compositor::composeBand(oogl::Framebuffer & target, unsigned int top,
+                                   unsigned int bottom) const noexcept
+{
+    oogl::Rectangle const band = { 0, top, target.getWidth(), bottom - top };
+
+    for (oogl::Rectangle const & damaged : m_damage.getRectangles()) {
+        oogl::Rectangle const area = intersect(damaged, band);
+
+        if (area.width == 0 || area.height == 0) {    // out of the band
+            continue;
+        }
+
+        for (DrawCall const & call : m_drawList) {
+            oogl::Framebuffer const & source    = call.window->getFramebuffer();
+            Placement const &         placement = call.placement;
+
+            for (oogl::Rectangle const & visible : call.visible) {
+                oogl::Rectangle rectangle = intersect(visible, area);
+                rectangle = intersect(rectangle, { placement.x, placement.y,
+                                                   source.getWidth(), source.getHeight() });
+
+                if (rectangle.width == 0 || rectangle.height == 0) {
+                    continue;
+                }
+
+                unsigned int const x = rectangle.xPosition - placement.x;
+                unsigned int const y = rectangle.yPosition - placement.y;
+
+                if (placement.below == nullptr) {    // the root : nothing under it
+                    target.copy(source, x, y, rectangle.width, rectangle.height,
+                                rectangle.xPosition, rectangle.yPosition);
+                } else {
+                    oogl::Blitter::blend(target, rectangle.xPosition, rectangle.yPosition,
+                                         source, { x, y, rectangle.width, rectangle.height },
+                                         oogl::BlendMode::SOURCE_OVER);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     DamageRegion.cpp
+///! \brief    This file contains the definition of the class oogl::DamageRegion and its features.
+///!           The class oogl::DamageRegion accumulates the rectangles of a surface that have been
+///!           drawn since its last presentation, so that only those get presented.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::DamageRegion
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <algorithm>
+#include <limits>
+
+#include "DamageRegion.hpp"    // Inclusion of the header file which declares the class and
+                               // features which get defined here.
+
+
+
+//==================================================================================================
+// Rectangle helpers.
+//==================================================================================================
+namespace
+{
+    // Number of pixels of a rectangle.
+    uint64_t area(oogl::Rectangle const & rectangle)
+    {
+        return static_cast<uint64_t>(rectangle.width) * rectangle.height;
+    }
+
+    // Smallest rectangle containing both given ones.
+    oogl::Rectangle unite(oogl::Rectangle const & first, oogl::Rectangle const & second)
+    {
+        unsigned int const left   = std::min(first.xPosition, second.xPosition);
+        unsigned int const top    = std::min(first.yPosition, second.yPosition);
+        unsigned int const right  = std::max(first.xPosition + first.width,
+                                             second.xPosition + second.width);
+        unsigned int const bottom = std::max(first.yPosition + first.height,
+                                             second.yPosition + second.height);
+
+        return oogl::Rectangle { left, top, right - left, bottom - top };
+    }
+
+    // Whether the rectangles overlap or share an edge.
+    bool touch(oogl::Rectangle const & first, oogl::Rectangle const & second)
+    {
+        return first.xPosition  <= second.xPosition + second.width
+            && second.xPosition <= first.xPosition  + first.width
+            && first.yPosition  <= second.yPosition + second.height
+            && second.yPosition <= first.yPosition  + first.height;
+    }
+
+    // Whether the first rectangle contains the second one.
+    bool contain(oogl::Rectangle const & first, oogl::Rectangle const & second)
+    {
+        return first.xPosition <= second.xPosition
+            && first.yPosition <= second.yPosition
+            && second.xPosition + second.width  <= first.xPosition + first.width
+            && second.yPosition + second.height <= first.yPosition + first.height;
+    }
+}
+
+
+//==================================================================================================
+// Class constructor.
+//==================================================================================================
+oogl::DamageRegion::DamageRegion() :
+m_rectangles()
+{
+    m_rectangles.reserve(MAX_RECTANGLES);
+}
+
+
+//==================================================================================================
+// Add a damaged rectangle : merge it with the touching rectangles as long as the bounding box does
+// not cover more pixels than both rectangles, then keep it apart or force a merge when full.
+//==================================================================================================
+void oogl::DamageRegion::add(oogl::Rectangle const & rectangle)
+{
+    if (area(rectangle) == 0) {    // nothing gets damaged
+        return;
+    }
+
+    oogl::Rectangle damage = rectangle;
+    bool            merged = true;
+
+    while (merged) {    // a merged rectangle may now touch other ones
+        merged = false;
+
+        for (std::size_t index = 0; index < m_rectangles.size(); index++) {
+            oogl::Rectangle const & current = m_rectangles[index];
+
+            if (contain(current, damage)) {    // already damaged
+                return;
+            }
+
+            oogl::Rectangle const bounds = unite(current, damage);
+
+            if (touch(current, damage) && area(bounds) <= area(current) + area(damage)) {
+                damage = bounds;
+                m_rectangles[index] = m_rectangles.back();
+                m_rectangles.pop_back();
+                merged = true;
+                break;
+            }
+        }
+    }
+
+    if (m_rectangles.size() < MAX_RECTANGLES) {
+        m_rectangles.push_back(damage);
+        return;
+    }
+
+    // No room left : merge with the rectangle whose bounding box grows the least
+    std::size_t best   = 0;
+    uint64_t    growth = std::numeric_limits<uint64_t>::max();
+
+    for (std::size_t index = 0; index < m_rectangles.size(); index++) {
+        uint64_t const current = area(unite(m_rectangles[index], damage))
+                                 - area(m_rectangles[index]);
+        if (current < growth) {
+            best   = index;
+            growth = current;
+        }
+    }
+
+    m_rectangles[best] = unite(m_rectangles[best], damage);
+}
+
+
+//==================================================================================================
+// Clip every rectangle to the bounds, and drop the ones left empty.
+//==================================================================================================
+void oogl::DamageRegion::clip(unsigned int width, unsigned int height) noexcept
+{
+    std::vector<oogl::Rectangle>::iterator last = std::remove_if(
+        m_rectangles.begin(), m_rectangles.end(),
+        [width, height] (oogl::Rectangle & rectangle) {
+            if (rectangle.xPosition >= width || rectangle.yPosition >= height) {
+                return true;
+            }
+
+            rectangle.width  = std::min(rectangle.width,  width  - rectangle.xPosition);
+            rectangle.height = std::min(rectangle.height, height - rectangle.yPosition);
+            return false;
+        }
+    );
+
+    m_rectangles.erase(last, m_rectangles.end());
+}
+
+
+//==================================================================================================
+// Bounding box of the region.
+//==================================================================================================
+oogl::Rectangle oogl::DamageRegion::getBounds() const noexcept
+{
+    if (m_rectangles.empty()) {
+        return oogl::Rectangle { 0, 0, 0, 0 };
+    }
+
+    oogl::Rectangle bounds = m_rectangles.front();
+    for (oogl::Rectangle const & rectangle : m_rectangles) {
+        bounds = unite(bounds, rectangle);
+    }
+
+    return bounds;
+}
@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     EventQueue.cpp
+///! \brief    This file contains the definition of the class oogl::EventQueue and its features.
+///!           The class oogl::EventQueue is the bounded lock-free queue of the events subsystem :
+///!           any thread can push events, and the main loop drains them by batches.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::EventQueue
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "EventQueue.hpp"    // Inclusion of the header file which declares the class and features
+                             // which get defined here.
+
+
+
+//==================================================================================================
+// Class constructor : both lanes get the capacity.
+//==================================================================================================
+oogl::EventQueue::EventQueue(std::size_t capacity) :
+m_discrete(capacity), m_bulk(capacity), m_recorder(nullptr), m_inputState(nullptr),
+m_overflowCount(0), m_coalescedCount(0)
+{}
+
+
+//==================================================================================================
+// Lane constructor : cell p is free for the producer of position p.
+//==================================================================================================
+oogl::EventQueue::Lane::Lane(std::size_t capacity) :
+cells(), mask(1), pushPosition(0), pollPosition(0)
+{
+    while (mask + 1 < capacity) {    // round up to a power of two, at least two cells
+        mask = (mask << 1) | 1;
+    }
+
+    cells.reset(new Cell[mask + 1]);
+
+    for (std::size_t position = 0; position <= mask; position++) {
+        cells[position].sequence.store(position, std::memory_order_relaxed);
+    }
+}
+
+
+//==================================================================================================
+// Push an event into its lane.
+//==================================================================================================
+bool oogl::EventQueue::push(oogl::Event const & event) noexcept
+{
+    Lane & lane = isBulk(event.type) ? m_bulk : m_discrete;
+
+    if (! lane.push(event)) {    // full
+        m_overflowCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    return true;
+}
+
+
+//==================================================================================================
+// Push an event into a lane : claim the push position whose cell is free, write the event into the
+// cell, then publish it to the consumer.
+//==================================================================================================
+bool oogl::EventQueue::Lane::push(oogl::Event const & event) noexcept
+{
+    std::size_t position = pushPosition.load(std::memory_order_relaxed);
+    Cell *      cell;
+
+    for (;;) {
+        cell = &cells[position & mask];
+
+        std::size_t const sequence = cell->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t const lag   = static_cast<std::ptrdiff_t>(sequence - position);
+
+        if (lag == 0) {             // free cell : try to claim the position
+            if (pushPosition.compare_exchange_weak(position, position + 1,
+                                                   std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (lag < 0) {       // the consumer has not freed the cell yet : full
+            return false;
+        } else {                    // another producer claimed the position : catch up
+            position = pushPosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->event = event;
+    cell->sequence.store(position + 1, std::memory_order_release);
+
+    return true;
+}
+
+
+//==================================================================================================
+// Pop a batch of events : the discrete ones first, then the merged bulk ones, each one recorded as
+// it leaves its lane.
+//==================================================================================================
+std::size_t oogl::EventQueue::poll(oogl::Event * events, std::size_t maxCount) noexcept
+{
+    std::size_t count = 0;
+
+    while (count < maxCount) {
+        Cell * const cell = m_discrete.front();
+
+        if (cell != nullptr) {
+            if (m_recorder != nullptr) {
+                m_recorder->record(cell->event);
+            }
+
+            events[count++] = cell->event;
+            m_discrete.release();
+        } else if (popBulk(events[count])) {
+            count++;
+        } else {    // empty
+            break;
+        }
+    }
+
+    if (m_inputState != nullptr) {    // the events are handed : publish their state
+        for (std::size_t index = 0; index < count; index++) {
+            m_inputState->apply(events[index]);
+        }
+
+        m_inputState->publish();
+    }
+
+    return count;
+}
+
+
+//==================================================================================================
+// Merge a run of bulk events : the later event of a window replaces the earlier one, as it holds
+// the current position or area. The run stops at another type or window, when a discrete event
+// arrives, or after a lap of the ring, so that a flood cannot hold the consumer.
+//==================================================================================================
+bool oogl::EventQueue::popBulk(oogl::Event & event) noexcept
+{
+    Cell * cell = m_bulk.front();
+
+    if (cell == nullptr) {    // empty
+        return false;
+    }
+
+    if (m_recorder != nullptr) {
+        m_recorder->record(cell->event);
+    }
+
+    event = cell->event;
+    m_bulk.release();
+
+    uint64_t merged = 0;
+
+    while (merged < m_bulk.mask && (cell = m_bulk.front()) != nullptr
+           && cell->event.type == event.type && cell->event.window == event.window
+           && m_discrete.front() == nullptr) {
+        if (m_recorder != nullptr) {
+            m_recorder->record(cell->event);
+        }
+
+        event = cell->event;
+        m_bulk.release();
+        merged++;
+    }
+
+    if (merged > 0) {    // only the consumer writes the count
+        m_coalescedCount.store(m_coalescedCount.load(std::memory_order_relaxed) + merged,
+                               std::memory_order_relaxed);
+    }
+
+    return true;
+}
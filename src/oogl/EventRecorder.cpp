@@ -0,0 +1,211 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     EventRecorder.cpp
+///! \brief    This file contains the definition of the class oogl::EventRecorder and its
+///!           features. The class oogl::EventRecorder appends the events handed by the event queue
+///!           to a compact binary log, so that a session can be replayed by oogl::EventReplayer.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::EventRecorder
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Include list
+#include "OOGLException.hpp"
+
+#include "EventRecorder.hpp"    // Inclusion of the header file which declares the class and
+                                // features which get defined here.
+
+
+
+//==================================================================================================
+// Serialization of the records : fixed size little endian fields, and variable-length quantities.
+//==================================================================================================
+namespace
+{
+    // Write a value of the given byte size at the cursor, and move the cursor after it.
+    void put(char * & cursor, uint64_t value, unsigned int size) noexcept
+    {
+        for (unsigned int byte = 0; byte < size; byte++) {
+            *cursor++ = static_cast<char>((value >> (8 * byte)) & 0xFF);
+        }
+    }
+
+    // Write an unsigned value by groups of 7 bits, the low ones first, the high bit of each byte
+    // telling whether another one follows.
+    void putUnsigned(char * & cursor, uint64_t value) noexcept
+    {
+        while (value >= 0x80) {
+            *cursor++ = static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+
+        *cursor++ = static_cast<char>(value);
+    }
+
+    // Write a signed value zigzag encoded, so that the small negative values stay short.
+    void putSigned(char * & cursor, int64_t value) noexcept
+    {
+        putUnsigned(cursor,
+                    (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+}
+
+
+//==================================================================================================
+// Class constructor : create the file and write the header into the buffer.
+//==================================================================================================
+oogl::EventRecorder::EventRecorder(std::string const & path) :
+m_file(path, std::ios::binary | std::ios::trunc), m_buffer(new char[BUFFER_SIZE]), m_bufferSize(0),
+m_lastTimestamp(0), m_eventCount(0), m_byteCount(HEADER_SIZE), m_failed(false)
+{
+    if (! m_file) {    // the file cannot be created
+        OOGL_THROW(oogl::ExceptionCode::EVENT_LOG_FAILED);
+    }
+
+    char * cursor = m_buffer.get();
+
+    put(cursor, MAGIC, 4);
+    put(cursor, VERSION, 4);
+
+    m_bufferSize = HEADER_SIZE;
+}
+
+
+//==================================================================================================
+// Class destructor : errors cannot be reported anymore, they are ignored.
+//==================================================================================================
+oogl::EventRecorder::~EventRecorder() noexcept
+{
+#if defined(OOGL_NO_EXCEPTIONS)
+    close();
+#else
+    try {
+        close();
+    } catch (...) {
+    }
+#endif
+}
+
+
+//==================================================================================================
+// Append the record of an event to the buffer, writing the buffer first when the record may not
+// fit in it anymore.
+//==================================================================================================
+void oogl::EventRecorder::record(oogl::Event const & event) noexcept
+{
+    if (m_failed || ! m_file.is_open()) {    // recording stopped
+        return;
+    }
+
+    if (m_bufferSize + MAX_RECORD > BUFFER_SIZE) {
+        write();
+
+        if (m_failed) {
+            return;
+        }
+    }
+
+    char * const start  = m_buffer.get() + m_bufferSize;
+    char *       cursor = start;
+
+    *cursor++ = static_cast<char>(event.type);
+    putSigned(cursor, static_cast<int64_t>(event.timestamp - m_lastTimestamp));
+    putUnsigned(cursor, event.window);
+
+    switch (event.type) {
+        case oogl::EventType::KEY_DOWN:
+        case oogl::EventType::KEY_UP:
+            putUnsigned(cursor, event.key.code);
+            putUnsigned(cursor, event.key.modifiers);
+            putUnsigned(cursor, event.key.repeat);
+            break;
+
+        case oogl::EventType::MOUSE_MOTION:
+        case oogl::EventType::MOUSE_BUTTON_DOWN:
+        case oogl::EventType::MOUSE_BUTTON_UP:
+        case oogl::EventType::MOUSE_WHEEL:
+            putSigned(cursor, event.mouse.x);
+            putSigned(cursor, event.mouse.y);
+            putUnsigned(cursor, event.mouse.button);
+            putUnsigned(cursor, event.mouse.buttons);
+            break;
+
+        case oogl::EventType::WINDOW_RESIZED:
+        case oogl::EventType::WINDOW_MOVED:
+            putSigned(cursor, event.area.x);
+            putSigned(cursor, event.area.y);
+            putUnsigned(cursor, event.area.width);
+            putUnsigned(cursor, event.area.height);
+            break;
+
+        case oogl::EventType::TIMER:
+            putUnsigned(cursor, event.timer.id);
+            putUnsigned(cursor, event.timer.data);
+            break;
+
+        case oogl::EventType::USER:    // opaque data : kept as is
+            put(cursor, event.user[0], 8);
+            put(cursor, event.user[1], 8);
+            break;
+
+        default:                       // no payload
+            break;
+    }
+
+    m_bufferSize    += static_cast<std::size_t>(cursor - start);
+    m_byteCount     += static_cast<uint64_t>(cursor - start);
+    m_lastTimestamp  = event.timestamp;
+    m_eventCount++;
+}
+
+
+//==================================================================================================
+// Write the buffer and flush the file.
+//==================================================================================================
+void oogl::EventRecorder::flush()
+{
+    if (! m_file.is_open()) {    // closed file
+        OOGL_THROW(oogl::ExceptionCode::EVENT_LOG_FAILED);
+    }
+
+    write();
+    m_file.flush();
+
+    if (m_failed || ! m_file) {    // the records cannot be written
+        m_failed = true;
+        OOGL_THROW(oogl::ExceptionCode::EVENT_LOG_FAILED);
+    }
+}
+
+
+//==================================================================================================
+// Write the buffer, then close the file.
+//==================================================================================================
+void oogl::EventRecorder::close()
+{
+    if (! m_file.is_open()) {    // already closed
+        return;
+    }
+
+    write();
+    m_file.close();
+
+    if (m_failed || ! m_file) {    // the records cannot be written
+        m_failed = true;
+        OOGL_THROW(oogl::ExceptionCode::EVENT_LOG_FAILED);
+    }
+}
+
+
+//==================================================================================================
+// Append the buffer to the file ; a failure stops the recording.
+//==================================================================================================
+void oogl::EventRecorder::write() noexcept
+{
+    if (m_bufferSize > 0 && ! m_failed) {
+        m_file.write(m_buffer.get(), static_cast<std::streamsize>(m_bufferSize));
+        m_failed = ! m_file;
+    }
+
+    m_bufferSize = 0;
+}
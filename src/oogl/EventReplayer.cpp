@@ -0,0 +1,277 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     EventReplayer.cpp
+///! \brief    This file contains the definition of the class oogl::EventReplayer and its
+///!           features. The class oogl::EventReplayer reads back an event log written by
+///!           oogl::EventRecorder, to replay a recorded session at its pace or as fast as possible.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::EventReplayer
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#if defined(__unix__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+// Include list
+#include "EventRecorder.hpp"
+#include "OOGLException.hpp"
+
+#include "EventReplayer.hpp"    // Inclusion of the header file which declares the class and
+                                // features which get defined here.
+
+
+
+//==================================================================================================
+// Deserialization of the records, each read checked against the end of the log.
+//==================================================================================================
+namespace
+{
+    typedef unsigned char const * Cursor;
+
+    // Read a little endian value of the given byte size.
+    bool get(Cursor & cursor, Cursor end, uint64_t & value, unsigned int size) noexcept
+    {
+        if (static_cast<std::size_t>(end - cursor) < size) {    // truncated
+            return false;
+        }
+
+        value = 0;
+        for (unsigned int byte = 0; byte < size; byte++) {
+            value |= static_cast<uint64_t>(*cursor++) << (8 * byte);
+        }
+
+        return true;
+    }
+
+    // Read a value written by groups of 7 bits, the low ones first.
+    bool getUnsigned(Cursor & cursor, Cursor end, uint64_t & value) noexcept
+    {
+        value = 0;
+
+        for (unsigned int shift = 0; shift < 64 && cursor < end; shift += 7) {
+            uint64_t const byte = *cursor++;
+            value |= (byte & 0x7F) << shift;
+
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+
+        return false;    // truncated, or longer than 64 bits
+    }
+
+    // Read a zigzag encoded value.
+    bool getSigned(Cursor & cursor, Cursor end, int64_t & value) noexcept
+    {
+        uint64_t encoded;
+
+        if (! getUnsigned(cursor, end, encoded)) {
+            return false;
+        }
+
+        value = static_cast<int64_t>((encoded >> 1) ^ (~(encoded & 1) + 1));
+        return true;
+    }
+
+    // Read 32 bits fields.
+    bool getUnsigned(Cursor & cursor, Cursor end, uint32_t & value) noexcept
+    {
+        uint64_t wide;
+        bool const valid = getUnsigned(cursor, end, wide);
+
+        value = static_cast<uint32_t>(wide);
+        return valid;
+    }
+
+    bool getSigned(Cursor & cursor, Cursor end, int32_t & value) noexcept
+    {
+        int64_t wide;
+        bool const valid = getSigned(cursor, end, wide);
+
+        value = static_cast<int32_t>(wide);
+        return valid;
+    }
+}
+
+
+//==================================================================================================
+// Class constructor : map the whole file, or read it where memory mapping is not available, then
+// check the header.
+//==================================================================================================
+oogl::EventReplayer::EventReplayer(std::string const & path) :
+m_data(nullptr), m_size(0), m_position(oogl::EventRecorder::HEADER_SIZE), m_lastTimestamp(0),
+m_copy()
+{
+#if defined(__unix__)
+    int const file = ::open(path.c_str(), O_RDONLY);
+    struct stat status;
+
+    if (file < 0) {    // the file cannot be opened
+        OOGL_THROW(oogl::ExceptionCode::EVENT_LOG_FAILED);
+    }
+
+    if (::fstat(file, &status) != 0
+        || static_cast<std::size_t>(status.st_size) < oogl::EventRecorder::HEADER_SIZE) {
+        ::close(file);    // too short for a header
+        OOGL_THROW(oogl::ExceptionCode::EVENT_LOG_FAILED);
+    }
+
+    void * const mapping = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ,
+                                  MAP_PRIVATE, file, 0);
+    ::close(file);    // the mapping keeps the file
+
+    if (mapping == MAP_FAILED) {    // the file cannot be mapped
+        OOGL_THROW(oogl::ExceptionCode::EVENT_LOG_FAILED);
+    }
+
+    ::madvise(mapping, static_cast<std::size_t>(status.st_size), MADV_SEQUENTIAL);
+
+    m_data = static_cast<unsigned char const *>(mapping);
+    m_size = static_cast<std::size_t>(status.st_size);
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+    if (! file) {    // the file cannot be opened
+        OOGL_THROW(oogl::ExceptionCode::EVENT_LOG_FAILED);
+    }
+
+    m_size = static_cast<std::size_t>(file.tellg());
+    m_copy.reset(new unsigned char[m_size + 1]);
+    m_data = m_copy.get();
+
+    file.seekg(0);
+    file.read(reinterpret_cast<char *>(m_copy.get()), static_cast<std::streamsize>(m_size));
+
+    if (! file || m_size < oogl::EventRecorder::HEADER_SIZE) {    // unreadable, or no header
+        OOGL_THROW(oogl::ExceptionCode::EVENT_LOG_FAILED);
+    }
+#endif
+
+    Cursor   cursor = m_data;
+    uint64_t magic   = 0;
+    uint64_t version = 0;
+
+    get(cursor, m_data + m_size, magic, 4);
+    get(cursor, m_data + m_size, version, 4);
+
+    if (magic != oogl::EventRecorder::MAGIC || version != oogl::EventRecorder::VERSION) {
+        release();    // not a log of this format
+        OOGL_THROW(oogl::ExceptionCode::EVENT_LOG_FAILED);
+    }
+}
+
+
+//==================================================================================================
+// Class destructor.
+//==================================================================================================
+oogl::EventReplayer::~EventReplayer() noexcept
+{
+    release();
+}
+
+
+//==================================================================================================
+// Decode a record : the whole record is decoded before the position moves, so that an incomplete
+// one is never handed.
+//==================================================================================================
+bool oogl::EventReplayer::next(oogl::Event & event) noexcept
+{
+    Cursor       cursor = m_data + m_position;
+    Cursor const end    = m_data + m_size;
+
+    if (cursor == end || *cursor > static_cast<unsigned char>(oogl::EventType::USER)) {
+        return false;    // end of the log, or unknown type
+    }
+
+    oogl::Event decoded = oogl::Event();
+    int64_t     delta;
+
+    decoded.type = static_cast<oogl::EventType>(*cursor++);
+
+    bool valid = getSigned(cursor, end, delta) && getUnsigned(cursor, end, decoded.window);
+
+    switch (decoded.type) {
+        case oogl::EventType::KEY_DOWN:
+        case oogl::EventType::KEY_UP:
+            valid = valid && getUnsigned(cursor, end, decoded.key.code)
+                    && getUnsigned(cursor, end, decoded.key.modifiers)
+                    && getUnsigned(cursor, end, decoded.key.repeat);
+            break;
+
+        case oogl::EventType::MOUSE_MOTION:
+        case oogl::EventType::MOUSE_BUTTON_DOWN:
+        case oogl::EventType::MOUSE_BUTTON_UP:
+        case oogl::EventType::MOUSE_WHEEL:
+            valid = valid && getSigned(cursor, end, decoded.mouse.x)
+                    && getSigned(cursor, end, decoded.mouse.y)
+                    && getUnsigned(cursor, end, decoded.mouse.button)
+                    && getUnsigned(cursor, end, decoded.mouse.buttons);
+            break;
+
+        case oogl::EventType::WINDOW_RESIZED:
+        case oogl::EventType::WINDOW_MOVED:
+            valid = valid && getSigned(cursor, end, decoded.area.x)
+                    && getSigned(cursor, end, decoded.area.y)
+                    && getUnsigned(cursor, end, decoded.area.width)
+                    && getUnsigned(cursor, end, decoded.area.height);
+            break;
+
+        case oogl::EventType::TIMER:
+            valid = valid && getUnsigned(cursor, end, decoded.timer.id)
+                    && getUnsigned(cursor, end, decoded.timer.data);
+            break;
+
+        case oogl::EventType::USER:
+            valid = valid && get(cursor, end, decoded.user[0], 8)
+                    && get(cursor, end, decoded.user[1], 8);
+            break;
+
+        default:    // no payload
+            break;
+    }
+
+    if (! valid) {    // incomplete or invalid record
+        return false;
+    }
+
+    m_lastTimestamp   += static_cast<uint64_t>(delta);
+    decoded.timestamp  = m_lastTimestamp;
+    m_position         = static_cast<std::size_t>(cursor - m_data);
+    event              = decoded;
+
+    return true;
+}
+
+
+//==================================================================================================
+// Go back to the first record.
+//==================================================================================================
+void oogl::EventReplayer::rewind() noexcept
+{
+    m_position      = oogl::EventRecorder::HEADER_SIZE;
+    m_lastTimestamp = 0;
+}
+
+
+//==================================================================================================
+// Unmap the log ; the copy is freed with the instance.
+//==================================================================================================
+void oogl::EventReplayer::release() noexcept
+{
+#if defined(__unix__)
+    if (m_data != nullptr) {
+        ::munmap(const_cast<unsigned char *>(m_data), m_size);
+    }
+#endif
+
+    m_data     = nullptr;
+    m_size     = 0;
+    m_position = 0;
+}
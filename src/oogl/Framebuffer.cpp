@@ -0,0 +1,195 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     Framebuffer.cpp
+///! \brief    This file contains the definition of the class oogl::Framebuffer and its features.
+///!           The class oogl::Framebuffer is an offscreen array of 32 bits pixels, that backs the
+///!           content of a window without requiring any display server.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::Framebuffer
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Include list
+#include "OOGLException.hpp"
+
+#include "Framebuffer.hpp"    // Inclusion of the header file which declares the class and
+                              // features which get defined here.
+
+
+
+//==================================================================================================
+// Default constructor : no pixels.
+//==================================================================================================
+oogl::Framebuffer::Framebuffer() noexcept :
+m_pixels(nullptr), m_pitch(0), m_capacity(0), m_width(0), m_height(0)
+{}
+
+
+//==================================================================================================
+// Copy constructor : allocate the same dimensions and copy the rows.
+//==================================================================================================
+oogl::Framebuffer::Framebuffer(oogl::Framebuffer const & instance) :
+Framebuffer()
+{
+    if (instance.m_pixels == nullptr) {    // nothing to copy
+        return;
+    }
+
+    allocate(instance.m_width, instance.m_height);
+    std::memcpy(m_pixels, instance.m_pixels, m_pitch * m_height * sizeof(uint32_t));
+}
+
+
+//==================================================================================================
+// Move constructor : steal the memory block.
+//==================================================================================================
+oogl::Framebuffer::Framebuffer(oogl::Framebuffer && instance) noexcept :
+m_pixels(std::exchange(instance.m_pixels, nullptr)), m_pitch(std::exchange(instance.m_pitch, 0)),
+m_capacity(std::exchange(instance.m_capacity, 0)), m_width(std::exchange(instance.m_width, 0)),
+m_height(std::exchange(instance.m_height, 0))
+{}
+
+
+//==================================================================================================
+// Class destructor.
+//==================================================================================================
+oogl::Framebuffer::~Framebuffer() noexcept
+{
+    release();
+}
+
+
+//==================================================================================================
+// Size the framebuffer : rows are padded to the alignment, and the current memory block is reused
+// whenever it is large enough.
+//==================================================================================================
+void oogl::Framebuffer::allocate(unsigned int width, unsigned int height)
+{
+    std::size_t const pixelsPerAlignment = ALIGNMENT / sizeof(uint32_t);
+    std::size_t const pitch = (width + pixelsPerAlignment - 1) / pixelsPerAlignment
+                              * pixelsPerAlignment;
+    std::size_t const size  = pitch * height * sizeof(uint32_t);
+
+    if (size > m_capacity) {    // the current block is too small : get a new one
+        release();
+
+        void * const block = std::aligned_alloc(ALIGNMENT, size);
+        if (block == nullptr) {
+            OOGL_THROW(oogl::ExceptionCode::FRAMEBUFFER_ALLOCATION_FAILED);
+        }
+
+        m_pixels   = static_cast<uint32_t *>(block);
+        m_capacity = size;
+    }
+
+    m_pitch  = pitch;
+    m_width  = width;
+    m_height = height;
+}
+
+
+//==================================================================================================
+// Release the memory block.
+//==================================================================================================
+void oogl::Framebuffer::release() noexcept
+{
+    std::free(m_pixels);
+
+    m_pixels   = nullptr;
+    m_pitch    = 0;
+    m_capacity = 0;
+    m_width    = 0;
+    m_height   = 0;
+}
+
+
+//==================================================================================================
+// Clear : the rows are contiguous, padding included, so the whole block is a single span.
+//==================================================================================================
+void oogl::Framebuffer::clear(uint32_t color) noexcept
+{
+    fillSpan(m_pixels, m_pitch * m_height, color);
+}
+
+
+//==================================================================================================
+// Fill a rectangle clipped to the framebuffer, row by row.
+//==================================================================================================
+void oogl::Framebuffer::fill(unsigned int x, unsigned int y, unsigned int width,
+                             unsigned int height, uint32_t color) noexcept
+{
+    if (x >= m_width || y >= m_height) {    // the rectangle is out of the framebuffer
+        return;
+    }
+
+    unsigned int const lastX = x + std::min(width,  m_width  - x);
+    unsigned int const lastY = y + std::min(height, m_height - y);
+
+    for (unsigned int row = y; row < lastY; row++) {
+        fillSpan(getRow(row) + x, lastX - x, color);
+    }
+}
+
+
+//==================================================================================================
+// Copy a rectangle clipped to both framebuffers, row by row.
+//==================================================================================================
+void oogl::Framebuffer::copy(oogl::Framebuffer const & source, unsigned int sourceX,
+                             unsigned int sourceY, unsigned int width, unsigned int height,
+                             unsigned int x, unsigned int y) noexcept
+{
+    if (sourceX >= source.m_width || sourceY >= source.m_height || x >= m_width
+        || y >= m_height) {    // the rectangle is out of one of the framebuffers
+        return;
+    }
+
+    width  = std::min({width,  source.m_width  - sourceX, m_width  - x});
+    height = std::min({height, source.m_height - sourceY, m_height - y});
+
+    for (unsigned int row = 0; row < height; row++) {
+        std::memcpy(getRow(y + row) + x, source.getRow(sourceY + row) + sourceX,
+                    width * sizeof(uint32_t));
+    }
+}
+
+
+//==================================================================================================
+// Fill a span : scalar stores up to the first 16 bytes boundary, then four 16 bytes stores per
+// iteration, i.e. a full cache line when the span starts on a row, and scalar stores for the tail.
+//==================================================================================================
+void oogl::Framebuffer::fillSpan(uint32_t * span, std::size_t length, uint32_t color) noexcept
+{
+    #if defined(__SSE2__)
+
+    while (length != 0 && (reinterpret_cast<std::uintptr_t>(span) & 15) != 0) {
+        *span++ = color;
+        length--;
+    }
+
+    __m128i const value = _mm_set1_epi32(static_cast<int>(color));
+
+    for (; length >= 16; span += 16, length -= 16) {
+        _mm_store_si128(reinterpret_cast<__m128i *>(span),      value);
+        _mm_store_si128(reinterpret_cast<__m128i *>(span + 4),  value);
+        _mm_store_si128(reinterpret_cast<__m128i *>(span + 8),  value);
+        _mm_store_si128(reinterpret_cast<__m128i *>(span + 12), value);
+    }
+
+    for (; length >= 4; span += 4, length -= 4) {
+        _mm_store_si128(reinterpret_cast<__m128i *>(span), value);
+    }
+
+    #endif
+
+    std::fill_n(span, length, color);
+}
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     InputState.cpp
+///! \brief    This file contains the definition of the class oogl::InputState and its features.
+///!           The class oogl::InputState holds the state of the input devices (keys held down,
+///!           pointer, joystick axes and buttons), published once per poll of the events, so that
+///!           any thread reads a consistent snapshot of it without lock.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::InputState
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "InputState.hpp"    // Inclusion of the header file which declares the class and features
+                             // which get defined here.
+
+
+
+//==================================================================================================
+// Class constructor : the published words are the ones of the empty state, for the readers coming
+// before the first poll.
+//==================================================================================================
+oogl::InputState::InputState() noexcept :
+m_pending(), m_changed(false), m_sequence(0), m_published()
+{
+    for (std::atomic<uint64_t> & word : m_published) {
+        word.store(0, std::memory_order_relaxed);
+    }
+}
+
+
+//==================================================================================================
+// Apply an event : the key events set the bit of their key, the mouse events the pointer.
+//==================================================================================================
+void oogl::InputState::apply(oogl::Event const & event) noexcept
+{
+    switch (event.type) {
+        case oogl::EventType::KEY_DOWN:
+        case oogl::EventType::KEY_UP:
+            if (event.key.code < oogl::InputSnapshot::KEY_COUNT) {
+                uint64_t const bit = uint64_t(1) << (event.key.code % 64);
+
+                if (event.type == oogl::EventType::KEY_DOWN) {
+                    m_pending.keys[event.key.code / 64] |= bit;
+                } else {
+                    m_pending.keys[event.key.code / 64] &= ~bit;
+                }
+            }
+
+            m_pending.modifiers = event.key.modifiers;
+            break;
+
+        case oogl::EventType::MOUSE_MOTION:
+        case oogl::EventType::MOUSE_BUTTON_DOWN:
+        case oogl::EventType::MOUSE_BUTTON_UP:
+            m_pending.mouseX       = event.mouse.x;
+            m_pending.mouseY       = event.mouse.y;
+            m_pending.mouseWindow  = event.window;
+            m_pending.mouseButtons = event.mouse.buttons;
+            break;
+
+        case oogl::EventType::MOUSE_WHEEL:    // x and y are the scroll : the pointer stays
+            m_pending.mouseButtons = event.mouse.buttons;
+            break;
+
+        default:    // no input state
+            return;
+    }
+
+    m_pending.timestamp = event.timestamp;
+    m_changed           = true;
+}
+
+
+//==================================================================================================
+// Set a joystick axis.
+//==================================================================================================
+void oogl::InputState::setAxis(std::size_t axis, int16_t value) noexcept
+{
+    if (axis < oogl::InputSnapshot::AXIS_COUNT && m_pending.axes[axis] != value) {
+        m_pending.axes[axis] = value;
+        m_changed            = true;
+    }
+}
+
+
+//==================================================================================================
+// Set the joystick buttons held.
+//==================================================================================================
+void oogl::InputState::setJoystickButtons(uint32_t buttons) noexcept
+{
+    if (m_pending.joystickButtons != buttons) {
+        m_pending.joystickButtons = buttons;
+        m_changed                 = true;
+    }
+}
+
+
+//==================================================================================================
+// Publish the pending state : the sequence is odd while the words get written. The release fence
+// keeps the words from being written before the odd sequence, the release store keeps them from
+// being written after the even one.
+//==================================================================================================
+void oogl::InputState::publish() noexcept
+{
+    if (! m_changed) {    // the readers already have it
+        return;
+    }
+
+    uint64_t const sequence = m_sequence.load(std::memory_order_relaxed);
+    uint64_t       words[WORD_COUNT];
+
+    m_pending.sequence = sequence / 2 + 1;
+    m_changed          = false;
+    std::memcpy(words, &m_pending, sizeof(words));
+
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (std::size_t index = 0; index < WORD_COUNT; index++) {
+        m_published[index].store(words[index], std::memory_order_relaxed);
+    }
+
+    m_sequence.store(sequence + 2, std::memory_order_release);
+}
@@ -0,0 +1,38 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     NullAudioSink.cpp
+///! \brief    This file contains the definition of the class oogl::NullAudioSink and its
+///!           features. The class oogl::NullAudioSink is the audio output discarding the frames,
+///!           to run the audio subsystem headless.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::NullAudioSink
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <cmath>
+
+#include "NullAudioSink.hpp"    // Inclusion of the header file which declares the class and
+                                // features which get defined here.
+
+
+
+//==================================================================================================
+// Class constructor.
+//==================================================================================================
+oogl::NullAudioSink::NullAudioSink() noexcept :
+m_frameCount(0), m_peak(0.f)
+{}
+
+
+//==================================================================================================
+// Count the frames and track the peak.
+//==================================================================================================
+void oogl::NullAudioSink::write(float const * samples, std::size_t frameCount)
+{
+    for (std::size_t index = 0; index < frameCount * 2; index++) {
+        m_peak = std::fmax(m_peak, std::fabs(samples[index]));
+    }
+
+    m_frameCount += frameCount;
+}
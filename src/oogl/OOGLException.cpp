@@ -8,6 +8,10 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+// Standard include list
+#include <cstdio>
+#include <cstdlib>
+
 #include "OOGLException.hpp"    // Inclusion of the header file which declares the class and
                                 // features which get defined here.
 
@@ -19,15 +23,91 @@
 std::function<std::string(void)> oogl::OOGLException::s_getExternalExceptionMessage
     = [] (void) { return std::string(""); };    // Default : no additional message to return
 
-// The map associating exception codes to exception
-// messages is defined at the end of the file.
+
+//==================================================================================================
+// Build the table associating the exception codes to exception messages, in the order of the codes
+//==================================================================================================
+char const * const oogl::OOGLException::s_exceptionMessages[] =
+{
+    // NO_EXCEPTION
+    "No detailed exception message.",
+
+    // OOGL_HANDLER_ALREADY_CREATED
+    "A graphic library handler already exist ; you cannot create another one.",
+
+    // OOGL_HANDLER_NOT_CREATED
+    "A graphic library handler must have been created before being either accessed or deleted.",
+
+    // UNKNOWN_GRAPHIC_LIBRARY
+    "The graphic library handler cannot be created : the given library is not supported.",
+
+    // LIB_ALREADY_INIT
+    "A graphic library has already been initialized ; it cannot be initialized twice.",
+
+    // LIB_NOT_INIT
+    "Trying to exit an unitialized library.",
+
+    // OOGLHANDLER_NULL_OBJ_TRACK
+    "A trackable object, i.e. an object the graphic library handler will track"
+    " to be able to free all memory space, should not be given through the null"
+    " pointer.",
+
+    // WIN_ALREADY_CREATED
+    "The call of the method \\create\\ is make several times for a unique window."
+    " A Window instance can only call this method once without calling"
+    " \\destroy\\.",
+
+    // WIN_NOT_CREATED
+    "The Window instance which calls \\destroy\\ has not called \\create\\ before.",
+
+    // FRAMEBUFFER_ALLOCATION_FAILED
+    "The memory required by the pixels of a framebuffer cannot be allocated.",
+
+    // EVENTS_NOT_INIT
+    "The event queue is only available once the library has been initialized"
+    " with the events subsystem activated.",
+
+    // TIMER_NOT_INIT
+    "The timer wheel is only available once the library has been initialized"
+    " with the timer subsystem activated.",
+
+    // AUDIO_NOT_INIT
+    "The audio mixer is only available once the library has been initialized"
+    " with the audio subsystem activated.",
+
+    // AUDIO_SINK_FAILED
+    "The audio output cannot be opened, or the frames cannot be written to it.",
+
+    // PROFILER_EXPORT_FAILED
+    "The profiler trace file cannot be created, or the records cannot be written to it.",
+
+    // HANDLER_BACKEND_MISMATCH
+    "The graphic library handler is not of the backend selected at compile time.",
+
+    // PLUGIN_LOAD_FAILED
+    "The plugin of the graphic library cannot be loaded, or it is not built for this framework.",
+
+    // EVENT_LOG_FAILED
+    "The event log cannot be created, written or mapped, or it is not an event log.",
+
+    // RESOURCE_LOAD_FAILED
+    "The resource file cannot be opened, or it cannot be read whole.",
+
+    // TRACKER_ALLOCATION_FAILED
+    "The memory required to track one more object cannot be allocated.",
+
+    // RESULT_WITHOUT_VALUE
+    "A result holding a value has been built from NO_EXCEPTION, without the value."
+};
+
 
 
 //==================================================================================================
-// Class constructor implementation
+// Class constructor implementation : the whole message is built once, so that what() only returns
+// it. The external message is taken when the exception is created, right after the error.
 //==================================================================================================
 oogl::OOGLException::OOGLException(oogl::ExceptionCode exceptionCode) noexcept :
-m_code(exceptionCode), MessagedException(oogl::OOGLException::getMessageFromCode(exceptionCode))
+m_code(exceptionCode), MessagedException(oogl::OOGLException::buildMessage(exceptionCode))
 {}
 
 
@@ -48,67 +128,51 @@ m_code(exception.m_code), MessagedException(std::move(exception))
 
 
 //==================================================================================================
-// Method that returns the exception message
+// Set the external function that details graphic library error message
 //==================================================================================================
-const char * oogl::OOGLException::what() const throw()
+void oogl::OOGLException::setExternalErrorFunction(std::function<std::string(void)> getError)
 {
-    return (
-        std::string(oogl::MessagedException::what()) + "\n"
-        + oogl::OOGLException::s_getExternalExceptionMessage()
-    ).c_str();
+    s_getExternalExceptionMessage = getError;
 }
 
 
 //==================================================================================================
-// Set the external function that details graphic library error message
+// Return the message associated in the table
 //==================================================================================================
-void oogl::OOGLException::setExternalErrorFunction(std::function<std::string(void)> getError)
+char const * oogl::OOGLException::getMessageFromCode(oogl::ExceptionCode code) noexcept
 {
-    s_getExternalExceptionMessage = getError;
+    static_assert(sizeof(s_exceptionMessages) / sizeof(s_exceptionMessages[0])
+                  == oogl::ExceptionCode::RESULT_WITHOUT_VALUE + 1,
+                  "Every exception code needs a message, in the order of the codes.");
+
+    std::size_t const index = static_cast<std::size_t>(code);
+
+    return index < sizeof(s_exceptionMessages) / sizeof(s_exceptionMessages[0])
+           ? s_exceptionMessages[index] : s_exceptionMessages[oogl::ExceptionCode::NO_EXCEPTION];
 }
 
 
 //==================================================================================================
-// Return the message associated in the map
+// Report the error and abort : the way errors end the program when exceptions are disabled.
 //==================================================================================================
-std::string oogl::OOGLException::getMessageFromCode(oogl::ExceptionCode code) noexcept
+void oogl::OOGLException::fail(oogl::ExceptionCode code) noexcept
 {
-    return oogl::OOGLException::s_mapExceptionCodeMessage.at(code);
+    std::fprintf(stderr, "oogl : %s\n", oogl::OOGLException::getMessageFromCode(code));
+    std::abort();
 }
 
 
 //==================================================================================================
-// Build the map associating the exception codes to exception messages
+// Message of the exception : the message of the code, then the external one if any.
 //==================================================================================================
-std::map<oogl::ExceptionCode, std::string> oogl::OOGLException::s_mapExceptionCodeMessage =
+std::string oogl::OOGLException::buildMessage(oogl::ExceptionCode code)
 {
-    {
-        oogl::ExceptionCode::NO_EXCEPTION,
-        "No detailed exception message."
-    }, {
-        oogl::ExceptionCode::OOGL_HANDLER_ALREADY_CREATED,
-        "A graphic library handler already exist ; you cannot create another one."
-    }, {
-        oogl::ExceptionCode::OOGL_HANDLER_NOT_CREATED,
-        "A graphic library handler must have been created before being either accessed or deleted."
-    }, {
-        oogl::ExceptionCode::LIB_ALREADY_INIT,
-        "A graphic library has already been initialized ; it cannot be initialized twice."
-    }, {
-        oogl::ExceptionCode::LIB_NOT_INIT,
-        "Trying to exit an unitialized library."
-    }, {
-        oogl::ExceptionCode::OOGLHANDLER_NULL_OBJ_TRACK,
-        std::string("A trackable object, i.e. an object the graphic library handler will track")
-        + std::string("to be able to free all memory space, should not be given through the null")
-        + std::string("pointer.")
-    }, {
-        oogl::ExceptionCode::WIN_ALREADY_CREATED,
-        std::string("The call of the method \\create\\ is make several times for a unique window.")
-        + std::string(" A Window instance can only call this method once without calling")
-        + std::string(" \\destroy\\.")
-    }, {
-        oogl::ExceptionCode::WIN_NOT_CREATED,
-        "The Window instance which calls \\destroy\\ has not called \\create\\ before."
+    std::string       message  = oogl::OOGLException::getMessageFromCode(code);
+    std::string const external = oogl::OOGLException::s_getExternalExceptionMessage();
+
+    if (! external.empty()) {
+        message += "\n" + external;
     }
-};
+
+    return message;
+}
@@ -10,14 +10,85 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+// Standard include list
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
 // Include list
+#include "Blitter.hpp"
 #include "OOGLException.hpp"
 #include "OOGLHandlerFactory.hpp"
+#include "Profiler.hpp"
 
 #include "OOGLHandler.hpp"    // Inclusion of the header file which declares the class and
                               // features which get defined here.
 
 
+//==================================================================================================
+// Combination of every subsystem flag.
+//==================================================================================================
+namespace
+{
+    oogl::MediaSystem const ALL_SYSTEMS = oogl::MediaSystem::AUDIO | oogl::MediaSystem::EVENTS
+                                        | oogl::MediaSystem::GAME_CONTROLLER
+                                        | oogl::MediaSystem::HAPTIC | oogl::MediaSystem::JOYSTICK
+                                        | oogl::MediaSystem::TIMER | oogl::MediaSystem::VIDEO;
+
+    // Every system behind a flag, in the order of the flags, and their names in the reports.
+    oogl::MediaSystem const SYSTEMS[] = { oogl::MediaSystem::AUDIO, oogl::MediaSystem::EVENTS,
+                                          oogl::MediaSystem::GAME_CONTROLLER,
+                                          oogl::MediaSystem::HAPTIC, oogl::MediaSystem::JOYSTICK,
+                                          oogl::MediaSystem::TIMER, oogl::MediaSystem::VIDEO };
+    char const * const SYSTEM_NAMES[] = { "audio", "events", "game controller", "haptic",
+                                          "joystick", "timer", "video" };
+
+    // Index of a single system flag in the tables above, or the table size for the others.
+    unsigned int getSystemIndex(oogl::MediaSystem system) noexcept
+    {
+        unsigned int index = 0;
+        while (index < sizeof(SYSTEMS) / sizeof(SYSTEMS[0]) && SYSTEMS[index] != system) {
+            index++;
+        }
+        return index;
+    }
+
+    // Add systems to a combination of flags, MediaSystem::ALL absorbing the others.
+    oogl::MediaSystem addSystems(oogl::MediaSystem flags, oogl::MediaSystem system) noexcept
+    {
+        if (system == oogl::MediaSystem::ALL) {           // all the systems using one flag
+            return oogl::MediaSystem::ALL;
+        }
+        return flags == oogl::MediaSystem::ALL ? flags : flags | system;
+    }
+
+    // Remove systems from a combination of flags.
+    oogl::MediaSystem removeSystems(oogl::MediaSystem flags, oogl::MediaSystem system) noexcept
+    {
+        if (flags == oogl::MediaSystem::NONE || system == oogl::MediaSystem::ALL) {
+            return oogl::MediaSystem::NONE;
+        }
+        return (flags == oogl::MediaSystem::ALL ? ALL_SYSTEMS : flags) & (~system);
+    }
+
+    // Tell whether every given system is in a combination of flags.
+    bool hasSystems(oogl::MediaSystem flags, oogl::MediaSystem system) noexcept
+    {
+        if (flags == oogl::MediaSystem::ALL) {
+            return true;
+        }
+
+        return system != oogl::MediaSystem::NONE
+            && system != oogl::MediaSystem::ALL
+            && (flags & system) == system;
+    }
+}
+
 
 //==================================================================================================
 // Primitive of the methods in charge of the library initialization.
@@ -26,12 +97,81 @@
 //==================================================================================================
 void oogl::OOGLHandler::init()
 {
+    OOGL_PROFILE_ZONE("OOGLHandler::init");
+
     if (m_isInitialized) { // The library has already been initialized
-        throw oogl::OOGLException(oogl::ExceptionCode::LIB_ALREADY_INIT);
+        OOGL_THROW(oogl::ExceptionCode::LIB_ALREADY_INIT);
     }
 
     // No exception to throw here, initialize the library
+    uint64_t const start = oogl::Profiler::now();
+
+    std::fill(std::begin(m_startupDurations), std::end(m_startupDurations), 0);
+
+    oogl::Blitter::selectKernels(oogl::Blitter::detectIsaLevel());    // Best pixel kernels
+
+    m_workerPool.start();
+
+    // The systems not deferred start concurrently ; the events start with the timers, which push
+    // their events to the queue.
+    oogl::MediaSystem eager = oogl::MediaSystem::NONE;
+
+    for (oogl::MediaSystem const system : SYSTEMS) {
+        if (isSystemActivated(system) && ! isSystemDeferred(system)) {
+            eager = eager | system;
+        }
+    }
+
+    if (hasSystems(eager, oogl::MediaSystem::TIMER)
+        && isSystemActivated(oogl::MediaSystem::EVENTS)) {
+        eager = eager | oogl::MediaSystem::EVENTS;
+    }
 
+    std::exception_ptr failure;
+    std::mutex         failureMutex;
+
+    {
+        oogl::TaskGroup group(m_workerPool);
+
+        for (oogl::MediaSystem const system : SYSTEMS) {
+            if (! hasSystems(eager, system)) {
+                continue;
+            }
+
+            group.run([this, system, &failure, &failureMutex] () {
+                #if defined(OOGL_NO_EXCEPTIONS)
+                startSystem(system);
+                #else
+                try {
+                    startSystem(system);
+                } catch (...) {    // reported once every system is done
+                    std::lock_guard<std::mutex> lock(failureMutex);
+                    if (! failure) { failure = std::current_exception(); }
+                }
+                #endif
+            });
+        }
+
+        group.wait();
+    }
+
+    #if ! defined(OOGL_NO_EXCEPTIONS)
+    if (failure) {    // leave the library as it was
+        m_audioMixer.reset();
+        m_timerWheel.reset();
+        m_eventQueue.reset();
+        m_inputState.reset();
+        m_workerPool.stop();
+        std::rethrow_exception(failure);
+    }
+    #endif
+
+    connectSystems(eager);
+
+    m_initDuration = oogl::Profiler::now() - start;
+
+    std::lock_guard<std::mutex> const lock(m_startMutex);
+    publishSystems();
     m_isInitialized = true;
 }
 
@@ -43,23 +183,44 @@ void oogl::OOGLHandler::init()
 //==================================================================================================
 void oogl::OOGLHandler::exit()
 {
+    OOGL_PROFILE_ZONE("OOGLHandler::exit");
+
     if (! m_isInitialized) { // The library is not yet initialized
-        throw oogl::OOGLException(oogl::ExceptionCode::LIB_NOT_INIT);
+        OOGL_THROW(oogl::ExceptionCode::LIB_NOT_INIT);
     }
 
-    // No exception to throw here
+    // The failure of an object is reported once the library is shut down
+    std::exception_ptr failure;
 
-    // Destroy the tracked objects
-    std::set<ITrackableObject*>::iterator objectIt;
-    for (objectIt = m_tracker.begin(); objectIt != m_tracker.end(); objectIt++) {
-        (*objectIt)->free();
+    #if defined(OOGL_NO_EXCEPTIONS)
+    freeTrackedObjects();       // Before the pool stops : the objects are freed on it
+    #else
+    try {
+        freeTrackedObjects();   // Before the pool stops : the objects are freed on it
+    } catch (...) {    // the subsystems still get stopped
+        failure = std::current_exception();
     }
+    #endif
+
+    {
+        std::lock_guard<std::mutex> const lock(m_startMutex);
 
-    m_tracker = std::set<ITrackableObject*>();  // Make the tracker set empty
+        m_isInitialized = false;    // Library marked as unitialized : nothing starts anymore
+        withdrawSystems();
 
-    m_isInitialized = false;    // Library marked as unitialized
+        m_audioMixer.reset();       // Playing voices, pending timers and events are dropped
+        m_timerWheel.reset();
+        m_eventQueue.reset();
+        m_inputState.reset();
+    }
 
+    m_workerPool.stop();            // The tasks still queued run before the workers end
 
+    #if ! defined(OOGL_NO_EXCEPTIONS)
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    #endif
 }
 
 
@@ -68,66 +229,382 @@ void oogl::OOGLHandler::exit()
 //==================================================================================================
 oogl::OOGLHandler & oogl::OOGLHandler::activateSystem(MediaSystem system) noexcept
 {
-    if (m_systems == oogl::MediaSystem::NONE) {          // no system to activate : return
-        return *this;
+    m_systems = addSystems(m_systems, system);
+    return *this;
+}
+
+
+//==================================================================================================
+// Method which deactivates the library subsystem.
+//==================================================================================================
+oogl::OOGLHandler & oogl::OOGLHandler::deactivateSystem(MediaSystem system) noexcept
+{
+    m_systems = removeSystems(m_systems, system);
+    return *this;
+}
+
+
+//==================================================================================================
+// Method which tells whether the given subsystems are activated.
+//==================================================================================================
+bool oogl::OOGLHandler::isSystemActivated(MediaSystem system) const noexcept
+{
+    return hasSystems(m_systems, system);
+}
+
+
+//==================================================================================================
+// Method which defers the start of the given subsystems to their first use.
+//==================================================================================================
+oogl::OOGLHandler & oogl::OOGLHandler::deferSystem(MediaSystem system) noexcept
+{
+    m_deferred = addSystems(m_deferred, system);
+    return *this;
+}
+
+
+//==================================================================================================
+// Method which starts the given subsystems with the library again.
+//==================================================================================================
+oogl::OOGLHandler & oogl::OOGLHandler::undeferSystem(MediaSystem system) noexcept
+{
+    m_deferred = removeSystems(m_deferred, system);
+    return *this;
+}
+
+
+//==================================================================================================
+// Method which tells whether the start of the given subsystems is deferred.
+//==================================================================================================
+bool oogl::OOGLHandler::isSystemDeferred(MediaSystem system) const noexcept
+{
+    return hasSystems(m_deferred, system);
+}
+
+
+//==================================================================================================
+// Method which gives access to the event queue.
+//==================================================================================================
+oogl::EventQueue & oogl::OOGLHandler::getEventQueue()
+{
+    oogl::EventQueue * queue = m_publishedQueue.load(std::memory_order_acquire);
+
+    if (queue == nullptr) {    // deferred : start it now
+        startOnFirstUse(oogl::MediaSystem::EVENTS);
+        queue = m_publishedQueue.load(std::memory_order_acquire);
     }
 
-    if (system == oogl::MediaSystem::ALL) {              // activate all the system using one flag
-        m_systems = oogl::MediaSystem::ALL;
-    } else if (m_systems != oogl::MediaSystem::ALL) {    // there are systems left to activate
-        m_systems = m_systems | system;
+    if (queue == nullptr) {    // the events subsystem has not been initialized
+        OOGL_THROW(oogl::ExceptionCode::EVENTS_NOT_INIT);
     }
 
-    return *this;
+    return *queue;
 }
 
 
 //==================================================================================================
-// Method which deactivates the library subsystem.
+// Method which gives access to the input state.
 //==================================================================================================
-oogl::OOGLHandler & oogl::OOGLHandler::deactivateSystem(MediaSystem system) noexcept
+oogl::InputState & oogl::OOGLHandler::getInputState()
+{
+    getEventQueue();    // published with the queue : started, or reported
+
+    return *m_inputState;
+}
+
+
+//==================================================================================================
+// Method which gives access to the timer wheel.
+//==================================================================================================
+oogl::TimerWheel & oogl::OOGLHandler::getTimerWheel()
 {
-    if (m_systems == oogl::MediaSystem::NONE) {          // no system to deactivate : return
-        return *this;
+    oogl::TimerWheel * timers = m_publishedTimers.load(std::memory_order_acquire);
+
+    if (timers == nullptr) {    // deferred : start it now
+        startOnFirstUse(oogl::MediaSystem::TIMER);
+        timers = m_publishedTimers.load(std::memory_order_acquire);
     }
 
-    if (system == oogl::MediaSystem::ALL) {              // deactivate all the system using one flag
-        m_systems = oogl::MediaSystem::NONE;
-    } else if (m_systems != oogl::MediaSystem::NONE) {   // there are systems left to deactivate
-        m_systems = m_systems & (!system);
+    if (timers == nullptr) {    // the timer subsystem has not been initialized
+        OOGL_THROW(oogl::ExceptionCode::TIMER_NOT_INIT);
     }
 
-    return *this;
+    return *timers;
 }
 
 
 //==================================================================================================
-// Method which registers a new trackable object.
+// Method which gives access to the audio mixer.
 //==================================================================================================
-oogl::OOGLHandler & oogl::OOGLHandler::track(ITrackableObject * object) noexcept
+oogl::AudioMixer & oogl::OOGLHandler::getAudioMixer()
 {
-    if (object == nullptr) {    // the pointer does not point to an actual object
-        throw oogl::OOGLException(oogl::ExceptionCode::OOGLHANDLER_NULL_OBJ_TRACK);
+    oogl::AudioMixer * mixer = m_publishedMixer.load(std::memory_order_acquire);
+
+    if (mixer == nullptr) {    // deferred : start it now
+        startOnFirstUse(oogl::MediaSystem::AUDIO);
+        mixer = m_publishedMixer.load(std::memory_order_acquire);
     }
 
-    m_tracker.insert(object);   // Add the object to the tracker set.
+    if (mixer == nullptr) {    // the audio subsystem has not been initialized
+        OOGL_THROW(oogl::ExceptionCode::AUDIO_NOT_INIT);
+    }
 
-    return *this;
+    return *mixer;
 }
 
 
 //==================================================================================================
-// Method which unregisters a given trackable object.
+// Method which gives the time a subsystem took to start.
 //==================================================================================================
-oogl::OOGLHandler & oogl::OOGLHandler::untrack(ITrackableObject * object) noexcept
+uint64_t oogl::OOGLHandler::getStartupDuration(MediaSystem system) const noexcept
 {
-    if (object == nullptr) {    // the pointer does not point to an actual object
-        throw oogl::OOGLException(oogl::ExceptionCode::OOGLHANDLER_NULL_OBJ_TRACK);
+    if (system == oogl::MediaSystem::ALL) {
+        return m_initDuration;
     }
 
-    m_tracker.erase(object);   // Add the object to the tracker set.
+    unsigned int const index = getSystemIndex(system);
 
-    return *this;
+    return index < SYSTEM_COUNT ? m_startupDurations[index] : 0;
+}
+
+
+//==================================================================================================
+// Method which writes the startup time of the library and of the activated subsystems.
+//==================================================================================================
+void oogl::OOGLHandler::writeStartupReport(std::ostream & stream) const
+{
+    char line[96];
+
+    std::snprintf(line, sizeof(line), "%-20s %12.1f us\n", "initialization", m_initDuration / 1e3);
+    stream << line;
+
+    for (unsigned int index = 0; index < SYSTEM_COUNT; index++) {
+        if (! isSystemActivated(SYSTEMS[index])) {
+            continue;
+        }
+
+        if (m_startupDurations[index] != 0) {
+            std::snprintf(line, sizeof(line), "  %-18s %12.1f us\n", SYSTEM_NAMES[index],
+                          m_startupDurations[index] / 1e3);
+        } else {
+            std::snprintf(line, sizeof(line), "  %-18s %15s\n", SYSTEM_NAMES[index],
+                          isSystemDeferred(SYSTEMS[index]) ? "deferred" : "no service");
+        }
+        stream << line;
+    }
+}
+
+
+//==================================================================================================
+// Start the service of one subsystem. The flags without service yet only get timed.
+//==================================================================================================
+bool oogl::OOGLHandler::startSystem(MediaSystem system)
+{
+    OOGL_PROFILE_ZONE("OOGLHandler::startSystem");
+
+    uint64_t const start   = oogl::Profiler::now();
+    bool           started = false;
+
+    if (system == oogl::MediaSystem::EVENTS && ! m_eventQueue) {
+        m_eventQueue.reset(new oogl::EventQueue());
+        m_inputState.reset(new oogl::InputState());
+        started = true;
+    } else if (system == oogl::MediaSystem::TIMER && ! m_timerWheel) {
+        m_timerWheel.reset(new oogl::TimerWheel());
+        started = true;
+    } else if (system == oogl::MediaSystem::AUDIO && ! m_audioMixer) {
+        m_audioMixer.reset(new oogl::AudioMixer());
+        started = true;
+    }
+
+    if (started) {
+        m_startupDurations[getSystemIndex(system)] = oogl::Profiler::now() - start;
+    }
+
+    return started;
+}
+
+
+//==================================================================================================
+// Start a deferred subsystem, and the events before the timers. The starts are serialized, so that
+// the threads using a subsystem at once start it once ; the services are published connected.
+//==================================================================================================
+void oogl::OOGLHandler::startOnFirstUse(MediaSystem system)
+{
+    std::lock_guard<std::mutex> const lock(m_startMutex);
+
+    if (! m_isInitialized || ! isSystemActivated(system)) {    // nothing to start
+        return;
+    }
+
+    oogl::MediaSystem started = oogl::MediaSystem::NONE;
+
+    if (system == oogl::MediaSystem::TIMER && isSystemActivated(oogl::MediaSystem::EVENTS)
+        && startSystem(oogl::MediaSystem::EVENTS)) {
+        started = oogl::MediaSystem::EVENTS;
+    }
+
+    if (startSystem(system)) {
+        started = started | system;
+    }
+
+    connectSystems(started);
+    publishSystems();
+}
+
+
+//==================================================================================================
+// Connect the services just started : the queue publishes the input state, the timers push their
+// events to the queue, and the timers and the mixer run on the worker pool. The services started
+// before only get the new queue, which the timers read atomically.
+//==================================================================================================
+void oogl::OOGLHandler::connectSystems(MediaSystem started) noexcept
+{
+    if (hasSystems(started, oogl::MediaSystem::EVENTS) && m_eventQueue) {
+        m_eventQueue->setInputState(m_inputState.get());
+
+        if (m_timerWheel && ! hasSystems(started, oogl::MediaSystem::TIMER)) {    // running
+            m_timerWheel->setEventQueue(m_eventQueue.get());
+        }
+    }
+
+    if (hasSystems(started, oogl::MediaSystem::TIMER) && m_timerWheel) {
+        m_timerWheel->setEventQueue(m_eventQueue.get());
+        m_timerWheel->setWorkerPool(&m_workerPool);
+    }
+
+    if (hasSystems(started, oogl::MediaSystem::AUDIO) && m_audioMixer) {
+        m_audioMixer->setWorkerPool(&m_workerPool);
+    }
+}
+
+
+//==================================================================================================
+// Publish the started services : the getters acquire them, connected.
+//==================================================================================================
+void oogl::OOGLHandler::publishSystems() noexcept
+{
+    m_publishedQueue.store(m_eventQueue.get(), std::memory_order_release);
+    m_publishedTimers.store(m_timerWheel.get(), std::memory_order_release);
+    m_publishedMixer.store(m_audioMixer.get(), std::memory_order_release);
+}
+
+
+//==================================================================================================
+// Withdraw the services, before they get destroyed.
+//==================================================================================================
+void oogl::OOGLHandler::withdrawSystems() noexcept
+{
+    m_publishedQueue.store(nullptr, std::memory_order_release);
+    m_publishedTimers.store(nullptr, std::memory_order_release);
+    m_publishedMixer.store(nullptr, std::memory_order_release);
+}
+
+
+//==================================================================================================
+// Free the tracked objects. The tracker is snapshot, as free() usually untracks the object. Each
+// object gets the depth of its chain of owners among the tracked ones, found in constant time
+// through their tracking handles ; the objects are then freed from the deepest level up, every
+// level being spread on the worker pool. Meanwhile, untracking only resets the handles, and the
+// tracker is emptied at the end. The first error gets reported once every object has been freed.
+//==================================================================================================
+void oogl::OOGLHandler::freeTrackedObjects()
+{
+    std::size_t const NO_DEPTH = SIZE_MAX;        // depth not computed yet
+    std::size_t const IN_CHAIN = SIZE_MAX - 1;    // depth being computed : ends an owner cycle
+
+    std::vector<oogl::ITrackableObject *> const objects(m_tracker.begin(), m_tracker.end());
+    std::size_t const                           count = objects.size();
+
+    // Depth of every object, walking up its owners until a known depth or a root
+    std::vector<std::size_t> depths(count, NO_DEPTH);
+    std::vector<std::size_t> chain;
+    std::size_t              levelCount = 0;
+
+    for (std::size_t index = 0; index < count; index++) {
+        std::size_t current = index;
+
+        while (depths[current] == NO_DEPTH) {
+            depths[current] = IN_CHAIN;
+            chain.push_back(current);
+
+            oogl::ITrackableObject *  const owner   = objects[current]->getOwner();
+            oogl::ITrackableObject ** const tracked = (owner != nullptr)
+                                                    ? m_tracker.get(owner->m_trackingHandle)
+                                                    : nullptr;
+
+            if (tracked == nullptr || *tracked != owner) {    // root among the tracked objects
+                break;
+            }
+            current = static_cast<std::size_t>(tracked - &*m_tracker.begin());
+        }
+
+        std::size_t depth = (depths[current] < IN_CHAIN) ? depths[current] + 1 : 0;
+
+        while (! chain.empty()) {
+            depths[chain.back()] = depth++;
+            chain.pop_back();
+        }
+
+        levelCount = std::max(levelCount, depth);
+    }
+
+    // Objects sorted by decreasing depth
+    std::vector<std::size_t> levelStarts(levelCount + 1, 0);
+    for (std::size_t const depth : depths) {
+        levelStarts[levelCount - 1 - depth]++;
+    }
+    for (std::size_t level = 0, start = 0; level <= levelCount; level++) {
+        std::size_t const size = levelStarts[level];
+        levelStarts[level]     = start;
+        start                 += size;
+    }
+
+    std::vector<oogl::ITrackableObject *> ordered(count);
+    {
+        std::vector<std::size_t> next(levelStarts);
+        for (std::size_t index = 0; index < count; index++) {
+            ordered[next[levelCount - 1 - depths[index]]++] = objects[index];
+        }
+    }
+
+    std::exception_ptr failure;
+    std::mutex         failureMutex;
+
+    auto const release = [&] (std::size_t index) {
+        oogl::ITrackableObject * const object = ordered[index];
+
+        #if defined(OOGL_NO_EXCEPTIONS)
+        object->free();
+        #else
+        try {
+            object->free();
+        } catch (...) {    // the other objects still get freed
+            std::lock_guard<std::mutex> lock(failureMutex);
+            if (! failure) { failure = std::current_exception(); }
+        }
+        #endif
+
+        object->m_trackingHandle = oogl::INVALID_SLOT_HANDLE;
+    };
+
+    m_isTearingDown = true;
+
+    for (std::size_t level = 0; level < levelCount; level++) {
+        std::size_t const first = levelStarts[level];
+
+        m_workerPool.parallelFor(levelStarts[level + 1] - first,
+                                 [&release, first] (std::size_t index) { release(first + index); });
+    }
+
+    m_isTearingDown = false;
+    m_tracker.clear();
+
+    #if ! defined(OOGL_NO_EXCEPTIONS)
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    #endif
 }
 
 
@@ -137,5 +614,24 @@ oogl::OOGLHandler & oogl::OOGLHandler::untrack(ITrackableObject * object) noexce
 oogl::OOGLHandler::OOGLHandler() :
 m_isInitialized(false),
 m_systems(oogl::MediaSystem::NONE),
-m_tracker(std::set<ITrackableObject*> ())
-{}
+m_deferred(oogl::MediaSystem::NONE),
+m_initDuration(0),
+m_startupDurations(),
+m_tracker(oogl::SlotMap<ITrackableObject*> ()),
+m_isTearingDown(false),
+m_workerPool(),
+m_scheduler(),
+m_eventQueue(),
+m_inputState(),
+m_timerWheel(),
+m_audioMixer(),
+m_startMutex(),
+m_publishedQueue(nullptr),
+m_publishedTimers(nullptr),
+m_publishedMixer(nullptr)
+{
+    // The workers run tasks of this handler : the accesses through the factory must give it
+    m_workerPool.setWorkerHook([this] (unsigned int) {
+        oogl::OOGLHandlerFactory().setCurrentHandler(this);
+    });
+}
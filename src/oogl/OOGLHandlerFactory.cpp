@@ -4,16 +4,32 @@
 ///!           features. The class oogl::OOGLHandlerFactory stores the active graphic library
 ///!           handler, and makes it available to other classes. It is designed with respect to the
 ///!           singleton pattern, so that any other classes of the framework can easily access the
-///!           one and unique instance of the class.
+///!           one and unique instance of the class, unless the calling thread works for an
+///!           isolated handler. The libraries built as plugins are loaded on the creation of
+///!           their first handler, and unloaded with their last one.
 ///! \author   Stevy Kimpe
 ///! \version  1.0.0
 ///! \see      oogl::OOGLHandler
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+// Standard include list
+#include <map>
+#include <mutex>
+#include <string>
+
+#if defined(__unix__)
+#include <dlfcn.h>
+#endif
+
 // Include list
 #include "OOGLException.hpp"
 #include "OOGLHandler.hpp"
+#include "OOGLPlugin.hpp"
+
+#if ! defined(OOGL_NO_BUILTIN_SOFTWARE)
+#include "software/SoftwareHandler.hpp"
+#endif
 
 #include "OOGLHandlerFactory.hpp"    // Inclusion of the header file which declares the class and
                                      // features which get defined here.
@@ -26,6 +42,90 @@
 oogl::OOGLHandler *  oogl::OOGLHandlerFactory::s_graphicLibraryHandler = nullptr;
 
 
+//==================================================================================================
+// Handler the calling thread works for, nullptr for the unique one.
+//==================================================================================================
+namespace
+{
+    thread_local oogl::OOGLHandler *    t_currentHandler = nullptr;
+}
+
+
+//==================================================================================================
+// Registry of the libraries : the built in ones, and the plugins with the handlers created from
+// them, so that a plugin gets unloaded with its last handler.
+//==================================================================================================
+namespace
+{
+    // Entry points of the plugins, as OOGL_PLUGIN defines them
+    typedef unsigned int         (*PluginAbiFunction)();
+    typedef oogl::OOGLHandler *  (*PluginCreateFunction)();
+
+    char const * const PLUGIN_ABI_SYMBOL    = "oogl_plugin_abi_version";
+    char const * const PLUGIN_CREATE_SYMBOL = "oogl_plugin_create_handler";
+
+    // Library of the registry : built in when it has no path, plugin otherwise.
+    struct Library
+    {
+        std::string             path;        // Shared object of the plugin, empty when built in
+        void *                  plugin;      // Loaded shared object, nullptr until needed
+        PluginCreateFunction    create;      // Entry point creating the handlers
+        std::size_t             handlers;    // Handlers alive, created from the shared object
+    };
+
+    std::mutex                                             s_registryMutex;
+    std::map<oogl::GraphicLibrary, Library>                s_registry = {
+        #if defined(OOGL_NO_BUILTIN_SOFTWARE)
+        { oogl::GraphicLibrary::SOFTWARE,     { "liboogl-software.so", nullptr, nullptr, 0 } },
+        #else
+        { oogl::GraphicLibrary::SOFTWARE,     { "", nullptr, nullptr, 0 } },
+        #endif
+        { oogl::GraphicLibrary::NULL_LIBRARY, { "liboogl-null.so", nullptr, nullptr, 0 } }
+    };
+    std::map<oogl::OOGLHandler *, oogl::GraphicLibrary>    s_pluginHandlers;
+
+    // Load the shared object of a plugin, and check it is built for the framework.
+    bool loadPlugin(Library & library) noexcept
+    {
+        #if defined(__unix__)
+        void * const plugin = dlopen(library.path.c_str(), RTLD_NOW | RTLD_LOCAL);
+
+        if (plugin == nullptr) {
+            return false;
+        }
+
+        PluginAbiFunction const abi =
+            reinterpret_cast<PluginAbiFunction>(dlsym(plugin, PLUGIN_ABI_SYMBOL));
+        PluginCreateFunction const create =
+            reinterpret_cast<PluginCreateFunction>(dlsym(plugin, PLUGIN_CREATE_SYMBOL));
+
+        if (abi == nullptr || create == nullptr || abi() != OOGL_PLUGIN_ABI_VERSION) {
+            dlclose(plugin);
+            return false;
+        }
+
+        library.plugin = plugin;
+        library.create = create;
+        return true;
+        #else
+        static_cast<void>(library);
+        return false;
+        #endif
+    }
+
+    // Unload the shared object of a plugin without handlers.
+    void unloadPlugin(Library & library) noexcept
+    {
+        #if defined(__unix__)
+        dlclose(library.plugin);
+        #endif
+
+        library.plugin = nullptr;
+        library.create = nullptr;
+    }
+}
+
+
 //==================================================================================================
 // Method creating a new graphic library handler.
 //==================================================================================================
@@ -33,15 +133,10 @@ void oogl::OOGLHandlerFactory::createGraphicLibraryHandler(oogl::GraphicLibrary
 {
     // Test a GL handler is not already instanciated
     if (s_graphicLibraryHandler != nullptr) {
-        throw oogl::OOGLException(oogl::ExceptionCode::OOGL_HANDLER_ALREADY_CREATED);
+        OOGL_THROW(oogl::ExceptionCode::OOGL_HANDLER_ALREADY_CREATED);
     }
 
-    // According to the specified library, the right constructor gets called.
-    if (/* Library test */true) {           // TO DO!
-        //new;
-    } else {
-        ;
-    }
+    s_graphicLibraryHandler = newHandler(library);
 }
 
 
@@ -52,11 +147,11 @@ void oogl::OOGLHandlerFactory::destroyGraphicLibraryHandler()
 {
     // Test the handler exist before returning it
     if (s_graphicLibraryHandler == nullptr) {
-        throw oogl::OOGLException(oogl::ExceptionCode::OOGL_HANDLER_NOT_CREATED);
+        OOGL_THROW(oogl::ExceptionCode::OOGL_HANDLER_NOT_CREATED);
     }
 
     // Exit properly the library system
-    delete s_graphicLibraryHandler;
+    deleteHandler(s_graphicLibraryHandler);
 
     // Delete the pointer to the instance
     s_graphicLibraryHandler = nullptr;
@@ -64,15 +159,195 @@ void oogl::OOGLHandlerFactory::destroyGraphicLibraryHandler()
 
 
 //==================================================================================================
-// Method returning a reference to the instanciated graphic library handler.
+// Method creating a handler which the factory does not store.
+//==================================================================================================
+oogl::OOGLHandler & oogl::OOGLHandlerFactory::createIsolatedHandler(oogl::GraphicLibrary library)
+{
+    return *newHandler(library);
+}
+
+
+//==================================================================================================
+// Method destroying an isolated handler.
+//==================================================================================================
+void oogl::OOGLHandlerFactory::destroyIsolatedHandler(oogl::OOGLHandler & handler) noexcept
+{
+    if (t_currentHandler == &handler) {    // the thread works for the unique handler again
+        t_currentHandler = nullptr;
+    }
+
+    deleteHandler(&handler);
+}
+
+
+//==================================================================================================
+// Method registering the plugin of a library.
+//==================================================================================================
+void oogl::OOGLHandlerFactory::registerGraphicLibrary(oogl::GraphicLibrary library,
+                                                      std::string const & path)
+{
+    std::lock_guard<std::mutex> const lock(s_registryMutex);
+
+    Library & registered = s_registry[library];
+    registered.path = path;    // a loaded plugin keeps serving its handlers until the last one
+}
+
+
+//==================================================================================================
+// Method telling whether the plugin of a library is loaded.
+//==================================================================================================
+bool oogl::OOGLHandlerFactory::isGraphicLibraryLoaded(oogl::GraphicLibrary library) const noexcept
+{
+    std::lock_guard<std::mutex> const lock(s_registryMutex);
+
+    std::map<oogl::GraphicLibrary, Library>::const_iterator const registered =
+        s_registry.find(library);
+
+    return registered != s_registry.end() && registered->second.plugin != nullptr;
+}
+
+
+//==================================================================================================
+// Method selecting the handler the calling thread works for.
+//==================================================================================================
+oogl::OOGLHandler * oogl::OOGLHandlerFactory::setCurrentHandler(oogl::OOGLHandler * handler) const
+    noexcept
+{
+    oogl::OOGLHandler * const former = t_currentHandler;
+    t_currentHandler = handler;
+    return former;
+}
+
+
+//==================================================================================================
+// Method returning a reference to the current handler, or to the instanciated graphic library
+// handler.
 //==================================================================================================
 oogl::OOGLHandler & oogl::OOGLHandlerFactory::getGraphicLibraryHandler() const
 {
+    if (t_currentHandler != nullptr) {    // the thread works for an isolated handler
+        return *t_currentHandler;
+    }
+
     // Test the handler exist before returning it
     if (s_graphicLibraryHandler == nullptr) {
-        throw oogl::OOGLException(oogl::ExceptionCode::OOGL_HANDLER_NOT_CREATED);
+        OOGL_THROW(oogl::ExceptionCode::OOGL_HANDLER_NOT_CREATED);
     }
 
     // Returns the reference
     return *s_graphicLibraryHandler;
-}
\ No newline at end of file
+}
+
+
+//==================================================================================================
+// Method returning the instanciated graphic library handler, or the error through the result.
+//==================================================================================================
+oogl::Result<oogl::OOGLHandler &> oogl::OOGLHandlerFactory::tryGetGraphicLibraryHandler() const
+    noexcept
+{
+    if (t_currentHandler != nullptr) {    // the thread works for an isolated handler
+        return *t_currentHandler;
+    }
+
+    // Test the handler exist before returning it
+    if (s_graphicLibraryHandler == nullptr) {
+        return oogl::ExceptionCode::OOGL_HANDLER_NOT_CREATED;
+    }
+
+    // Returns the reference
+    return *s_graphicLibraryHandler;
+}
+
+
+//==================================================================================================
+// Create a handler : a built in library calls the right constructor, while a plugin gets loaded
+// with its first handler.
+//==================================================================================================
+oogl::OOGLHandler * oogl::OOGLHandlerFactory::newHandler(oogl::GraphicLibrary library)
+{
+    std::lock_guard<std::mutex> const lock(s_registryMutex);
+
+    std::map<oogl::GraphicLibrary, Library>::iterator const registered = s_registry.find(library);
+
+    if (registered == s_registry.end()) {          // No handler for this library
+        OOGL_THROW(oogl::ExceptionCode::UNKNOWN_GRAPHIC_LIBRARY);
+    }
+
+    Library & plugin = registered->second;
+
+    if (plugin.path.empty() && plugin.plugin == nullptr) {    // built in library
+        switch (library) {
+            #if ! defined(OOGL_NO_BUILTIN_SOFTWARE)
+            case oogl::GraphicLibrary::SOFTWARE:
+                return new oogl::software::SoftwareHandler();
+            #endif
+
+            default:                            // No handler for this library
+                OOGL_THROW(oogl::ExceptionCode::UNKNOWN_GRAPHIC_LIBRARY);
+        }
+    }
+
+    if (plugin.plugin == nullptr && ! loadPlugin(plugin)) {
+        OOGL_THROW(oogl::ExceptionCode::PLUGIN_LOAD_FAILED);
+    }
+
+    oogl::OOGLHandler * handler = nullptr;
+
+    #if defined(OOGL_NO_EXCEPTIONS)
+    handler = plugin.create();
+    #else
+    try {
+        handler = plugin.create();
+    } catch (...) {    // a plugin without handlers does not stay loaded
+        if (plugin.handlers == 0) { unloadPlugin(plugin); }
+        throw;
+    }
+    #endif
+
+    if (handler == nullptr) {                   // the plugin could not build its handler
+        if (plugin.handlers == 0) { unloadPlugin(plugin); }
+        OOGL_THROW(oogl::ExceptionCode::PLUGIN_LOAD_FAILED);
+    }
+
+    #if defined(OOGL_NO_EXCEPTIONS)
+    s_pluginHandlers.emplace(handler, library);
+    #else
+    try {
+        s_pluginHandlers.emplace(handler, library);
+    } catch (...) {    // an untracked handler could never unload its plugin
+        delete handler;
+        if (plugin.handlers == 0) { unloadPlugin(plugin); }
+        throw;
+    }
+    #endif
+
+    plugin.handlers++;
+
+    return handler;
+}
+
+
+//==================================================================================================
+// Destroy a handler : the plugin it comes from gets unloaded with its last handler, as the code of
+// the handler lives in it.
+//==================================================================================================
+void oogl::OOGLHandlerFactory::deleteHandler(oogl::OOGLHandler * handler) noexcept
+{
+    std::lock_guard<std::mutex> const lock(s_registryMutex);
+
+    std::map<oogl::OOGLHandler *, oogl::GraphicLibrary>::iterator const created =
+        s_pluginHandlers.find(handler);
+
+    delete handler;
+
+    if (created == s_pluginHandlers.end()) {    // built in library
+        return;
+    }
+
+    Library & plugin = s_registry[created->second];
+    s_pluginHandlers.erase(created);
+
+    if (--plugin.handlers == 0) {
+        unloadPlugin(plugin);
+    }
+}
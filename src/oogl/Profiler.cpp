@@ -0,0 +1,304 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     Profiler.cpp
+///! \brief    This file contains the definition of the class oogl::Profiler and its features.
+///!           The class oogl::Profiler records the time spent in scoped zones into per-thread
+///!           rings, and exports them as a Chrome trace.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::Profiler
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Include list
+#include "OOGLException.hpp"
+
+#include "Profiler.hpp"    // Inclusion of the header file which declares the class and features
+                           // which get defined here.
+
+
+
+//==================================================================================================
+// Rings of the threads. A ring is only written by its thread ; the registry keeps the rings of the
+// ended threads for the exporter, until a new thread reuses them.
+//==================================================================================================
+namespace
+{
+    std::size_t const RING_MASK = oogl::Profiler::RING_CAPACITY - 1;
+
+    // Recorded zone ; relaxed atomics, so that the exporter may read a ring being written.
+    struct Record
+    {
+        std::atomic<char const *>    name;
+        std::atomic<uint64_t>        start;
+        std::atomic<uint64_t>        end;
+    };
+
+    // Ring of a thread : records in [max(tail, head - capacity), head[ are available.
+    struct Ring
+    {
+        Record                   records[oogl::Profiler::RING_CAPACITY];
+        std::atomic<uint64_t>    head;        // Records written so far
+        std::atomic<uint64_t>    tail;        // First record kept by the last clear
+        uint32_t                 threadId;    // Identifier in the traces
+        std::string              name;        // Name in the traces, empty when none
+        bool                     retired;     // The thread has ended
+    };
+
+    // Rings of every thread, protected by a mutex taken outside of the record path only.
+    struct Registry
+    {
+        std::mutex                            mutex;
+        std::vector<std::unique_ptr<Ring>>    rings;
+        uint32_t                              nextThreadId = 1;
+    };
+
+    Registry & getRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    // Owner of the ring of a thread, retiring it when the thread ends.
+    struct RingOwner
+    {
+        Ring * ring = nullptr;
+
+        ~RingOwner()
+        {
+            if (ring != nullptr) {
+                std::lock_guard<std::mutex> const lock(getRegistry().mutex);
+                ring->retired = true;
+            }
+        }
+    };
+
+    thread_local RingOwner t_owner;
+
+    // Ring of the calling thread : a retired ring is reused, else a new one is made. Null when the
+    // ring cannot be allocated.
+    Ring * attachRing() noexcept
+    {
+        if (t_owner.ring != nullptr) {
+            return t_owner.ring;
+        }
+
+        Registry &                  registry = getRegistry();
+        std::lock_guard<std::mutex> const lock(registry.mutex);
+
+        std::vector<std::unique_ptr<Ring>>::iterator const retired = std::find_if(
+            registry.rings.begin(), registry.rings.end(),
+            [] (std::unique_ptr<Ring> const & ring) { return ring->retired; });
+
+        Ring * ring = nullptr;
+        if (retired != registry.rings.end()) {
+            ring = retired->get();
+            ring->tail.store(ring->head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            ring->name.clear();
+        } else {
+#if defined(OOGL_NO_EXCEPTIONS)
+            registry.rings.emplace_back(new Ring());
+#else
+            try {
+                registry.rings.emplace_back(new Ring());
+            } catch (...) {    // the zones of the thread get dropped
+                return nullptr;
+            }
+#endif
+            ring = registry.rings.back().get();
+        }
+
+        ring->threadId = registry.nextThreadId++;
+        ring->retired  = false;
+        t_owner.ring   = ring;
+
+        return ring;
+    }
+
+    // Write a string as a JSON string.
+    void writeJsonString(std::ostream & stream, char const * text)
+    {
+        stream << '"';
+        for (; *text != '\0'; text++) {
+            if (*text == '"' || *text == '\\') {
+                stream << '\\';
+            }
+            stream << (static_cast<unsigned char>(*text) < 0x20 ? ' ' : *text);
+        }
+        stream << '"';
+    }
+
+    // Write nanoseconds as microseconds, with three decimals.
+    void writeMicroseconds(std::ostream & stream, uint64_t nanoseconds)
+    {
+        char const decimals[] = { char('0' + nanoseconds / 100 % 10),
+                                  char('0' + nanoseconds / 10 % 10),
+                                  char('0' + nanoseconds % 10), '\0' };
+
+        stream << nanoseconds / 1000 << '.' << decimals;
+    }
+}
+
+
+//==================================================================================================
+// Attach the calling thread : its ring gets allocated, once, so that recording never does.
+//==================================================================================================
+bool oogl::Profiler::attachThread() noexcept
+{
+    return attachRing() != nullptr;
+}
+
+
+//==================================================================================================
+// Record a zone : write the record, then publish it. Without ring, the zone is dropped.
+//==================================================================================================
+void oogl::Profiler::record(char const * name, uint64_t start, uint64_t end) noexcept
+{
+    Ring * const ring = t_owner.ring;
+    if (ring == nullptr) {
+        return;
+    }
+
+    uint64_t const position = ring->head.load(std::memory_order_relaxed);
+    Record &       record   = ring->records[position & RING_MASK];
+
+    record.name.store(name, std::memory_order_relaxed);
+    record.start.store(start, std::memory_order_relaxed);
+    record.end.store(end, std::memory_order_relaxed);
+
+    ring->head.store(position + 1, std::memory_order_release);
+}
+
+
+//==================================================================================================
+// Name the calling thread ; the name is dropped when the thread cannot get a ring.
+//==================================================================================================
+void oogl::Profiler::setThreadName(std::string const & name)
+{
+    Ring * const ring = attachRing();
+    if (ring == nullptr) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> const lock(getRegistry().mutex);
+    ring->name = name;
+}
+
+
+//==================================================================================================
+// Forget the records : every ring starts after its last record.
+//==================================================================================================
+void oogl::Profiler::clear() noexcept
+{
+    Registry &                  registry = getRegistry();
+    std::lock_guard<std::mutex> const lock(registry.mutex);
+
+    for (std::unique_ptr<Ring> const & ring : registry.rings) {
+        ring->tail.store(ring->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+
+//==================================================================================================
+// Write the trace : the records of each ring are copied, then the ones the thread may have
+// overwritten during the copy are dropped. Times are given in microseconds since the first zone.
+//==================================================================================================
+void oogl::Profiler::writeChromeTrace(std::ostream & stream)
+{
+    struct Zone
+    {
+        char const * name;
+        uint64_t     start;
+        uint64_t     end;
+        uint32_t     threadId;
+    };
+
+    std::vector<Zone>                                zones;
+    std::vector<std::pair<uint32_t, std::string>>    names;
+
+    {
+        Registry &                  registry = getRegistry();
+        std::lock_guard<std::mutex> const lock(registry.mutex);
+
+        for (std::unique_ptr<Ring> const & ring : registry.rings) {
+            uint64_t const head  = ring->head.load(std::memory_order_acquire);
+            uint64_t const first = std::max(ring->tail.load(std::memory_order_relaxed),
+                                            head > RING_CAPACITY ? head - RING_CAPACITY : 0);
+            std::size_t const copied = zones.size();
+
+            for (uint64_t position = first; position < head; position++) {
+                Record const & record = ring->records[position & RING_MASK];
+                zones.push_back(Zone { record.name.load(std::memory_order_relaxed),
+                                       record.start.load(std::memory_order_relaxed),
+                                       record.end.load(std::memory_order_relaxed),
+                                       ring->threadId });
+            }
+
+            // Records from the slot being written onwards may be torn
+            uint64_t const written = ring->head.load(std::memory_order_acquire);
+            uint64_t const valid   = written >= RING_CAPACITY ? written - RING_CAPACITY + 1 : 0;
+            if (valid > first) {
+                std::size_t const dropped = static_cast<std::size_t>(
+                    std::min<uint64_t>(valid - first, zones.size() - copied));
+                zones.erase(zones.begin() + copied, zones.begin() + copied + dropped);
+            }
+
+            if (! ring->name.empty()) {
+                names.emplace_back(ring->threadId, ring->name);
+            }
+        }
+    }
+
+    uint64_t origin = UINT64_MAX;
+    for (Zone const & zone : zones) {
+        origin = std::min(origin, zone.start);
+    }
+
+    stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    char const * separator = "\n";
+    for (std::pair<uint32_t, std::string> const & name : names) {
+        stream << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+               << name.first << ",\"args\":{\"name\":";
+        writeJsonString(stream, name.second.c_str());
+        stream << "}}";
+        separator = ",\n";
+    }
+
+    for (Zone const & zone : zones) {
+        stream << separator << "{\"name\":";
+        writeJsonString(stream, zone.name);
+        stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << zone.threadId << ",\"ts\":";
+        writeMicroseconds(stream, zone.start - origin);
+        stream << ",\"dur\":";
+        writeMicroseconds(stream, zone.end - zone.start);
+        stream << '}';
+        separator = ",\n";
+    }
+
+    stream << "\n]}\n";
+}
+
+
+//==================================================================================================
+// Write the trace into a file.
+//==================================================================================================
+void oogl::Profiler::exportChromeTrace(std::string const & path)
+{
+    std::ofstream file(path, std::ios::trunc);
+
+    writeChromeTrace(file);
+    file.close();
+
+    if (! file) {    // the file cannot be written
+        OOGL_THROW(oogl::ExceptionCode::PROFILER_EXPORT_FAILED);
+    }
+}
@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     Scheduler.cpp
+///! \brief    This file contains the definition of the class oogl::Scheduler and its features.
+///!           The class oogl::Scheduler resumes the work waiting for an event, a timer or a load
+///!           on the thread of the main loop, and pools the frames of the coroutines it resumes.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::Scheduler
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <new>
+
+// Include list
+#include "OOGLException.hpp"
+#include "Profiler.hpp"
+
+#include "Scheduler.hpp"    // Inclusion of the header file which declares the class and features
+                            // which get defined here.
+
+
+
+//==================================================================================================
+// Class constructor : the free lists are empty until a frame of their class is needed.
+//==================================================================================================
+oogl::Scheduler::Scheduler() :
+m_ready(), m_running(), m_inboxMutex(), m_inbox(), m_hasPosted(false), m_waiters(), m_failure(),
+m_pool(new FramePool { {}, {}, 0, false })
+{}
+
+
+//==================================================================================================
+// Class destructor : the pool goes with the scheduler, unless frames are still alive. Their tasks
+// may still be destroyed : the last release frees the pool. The frames of the coroutines dropped
+// are never released, and neither is their pool.
+//==================================================================================================
+oogl::Scheduler::~Scheduler() noexcept
+{
+    if (m_pool->frameCount == 0) {
+        delete m_pool;
+    } else {
+        m_pool->isOrphan = true;
+    }
+}
+
+
+//==================================================================================================
+// Post a continuation to the inbox : the next run moves it to the ready ones.
+//==================================================================================================
+void oogl::Scheduler::post(oogl::Continuation continuation)
+{
+    std::lock_guard<std::mutex> const lock(m_inboxMutex);
+
+    m_inbox.push_back(continuation);
+    m_hasPosted.store(true, std::memory_order_release);
+}
+
+
+//==================================================================================================
+// Register a continuation waiting for an event.
+//==================================================================================================
+void oogl::Scheduler::waitEvent(uint32_t window, oogl::Event * event,
+                                oogl::Continuation continuation)
+{
+    m_waiters.push_back(Waiter { window, event, continuation });
+}
+
+
+//==================================================================================================
+// Hand an event to its waiters : they leave the list, which keeps the order of the others.
+//==================================================================================================
+std::size_t oogl::Scheduler::dispatch(oogl::Event const & event)
+{
+    std::size_t kept = 0;
+
+    for (Waiter const & waiter : m_waiters) {
+        if (waiter.window == 0 || waiter.window == event.window) {    // the event it waits for
+            *waiter.event = event;
+            m_ready.push_back(waiter.continuation);
+        } else {
+            m_waiters[kept++] = waiter;
+        }
+    }
+
+    std::size_t const handed = m_waiters.size() - kept;
+    m_waiters.resize(kept);
+
+    return handed;
+}
+
+
+//==================================================================================================
+// Resume the ready continuations : the posted ones join them first, then they are swapped out, so
+// that the ones made ready meanwhile wait for the next run.
+//==================================================================================================
+std::size_t oogl::Scheduler::run()
+{
+    OOGL_PROFILE_ZONE("Scheduler::run");
+
+    if (m_hasPosted.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> const lock(m_inboxMutex);
+
+        m_ready.insert(m_ready.end(), m_inbox.begin(), m_inbox.end());
+        m_inbox.clear();
+        m_hasPosted.store(false, std::memory_order_relaxed);
+    }
+
+    m_running.swap(m_ready);
+
+    for (oogl::Continuation const & continuation : m_running) {
+        continuation.function(continuation.context);
+    }
+
+    std::size_t const count = m_running.size();
+    m_running.clear();
+
+#if ! defined(OOGL_NO_EXCEPTIONS)
+    if (m_failure) {    // a spawned coroutine ended with an exception
+        std::exception_ptr const failure = m_failure;
+        m_failure = nullptr;
+        std::rethrow_exception(failure);
+    }
+#endif
+
+    return count;
+}
+
+
+//==================================================================================================
+// Allocate a frame : the pool is kept in the header, for the release. An empty free list gets a
+// new chunk, carved into blocks of its class.
+//==================================================================================================
+void * oogl::Scheduler::allocateFrame(std::size_t size)
+{
+    std::size_t const frameClass = getFrameClass(size);
+    char *            block;
+
+    if (frameClass == FRAME_CLASSES) {    // too large for the pool
+        block = static_cast<char *>(::operator new(size + FRAME_HEADER));
+    } else {
+        FreeFrame *& freeList = m_pool->freeFrames[frameClass];
+
+        if (freeList == nullptr) {
+            std::size_t const       blockSize = MIN_FRAME << frameClass;
+            std::unique_ptr<char[]> chunk(new char[CHUNK_SIZE]);
+
+            for (std::size_t offset = CHUNK_SIZE; offset >= blockSize; offset -= blockSize) {
+                FreeFrame * const frame = reinterpret_cast<FreeFrame *>(&chunk[offset - blockSize]);
+                frame->next             = freeList;
+                freeList                = frame;
+            }
+
+            m_pool->chunks.push_back(std::move(chunk));
+        }
+
+        block    = reinterpret_cast<char *>(freeList);
+        freeList = freeList->next;
+    }
+
+    *reinterpret_cast<FramePool **>(block) = m_pool;
+    m_pool->frameCount++;
+
+    return block + FRAME_HEADER;
+}
+
+
+//==================================================================================================
+// Release a frame to the free list of its class, in the pool which allocated it. The last frame of
+// the pool of a destroyed scheduler frees the pool.
+//==================================================================================================
+void oogl::Scheduler::releaseFrame(void * frame, std::size_t size) noexcept
+{
+    char * const      block      = static_cast<char *>(frame) - FRAME_HEADER;
+    FramePool * const pool       = *reinterpret_cast<FramePool **>(block);
+    std::size_t const frameClass = getFrameClass(size);
+
+    pool->frameCount--;
+
+    if (frameClass == FRAME_CLASSES) {    // allocated from the heap
+        ::operator delete(block);
+    } else {
+        FreeFrame * const freeFrame  = reinterpret_cast<FreeFrame *>(block);
+        freeFrame->next              = pool->freeFrames[frameClass];
+        pool->freeFrames[frameClass] = freeFrame;
+    }
+
+    if (pool->isOrphan && pool->frameCount == 0) {
+        delete pool;
+    }
+}
+
+
+//==================================================================================================
+// Smallest class whose blocks hold the frame and its header.
+//==================================================================================================
+std::size_t oogl::Scheduler::getFrameClass(std::size_t size) noexcept
+{
+    std::size_t frameClass = 0;
+
+    for (std::size_t block = MIN_FRAME; block < size + FRAME_HEADER && frameClass < FRAME_CLASSES;
+         block <<= 1) {
+        frameClass++;
+    }
+
+    return frameClass;
+}
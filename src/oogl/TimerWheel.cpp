@@ -0,0 +1,303 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     TimerWheel.cpp
+///! \brief    This file contains the definition of the class oogl::TimerWheel and its features.
+///!           The class oogl::TimerWheel is the timer service of the timer subsystem : a
+///!           hierarchical timing wheel scheduling, cancelling and firing timers in constant time.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::TimerWheel
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <algorithm>
+
+// Include list
+#include "EventQueue.hpp"
+#include "Profiler.hpp"
+#include "WorkerPool.hpp"
+
+#include "TimerWheel.hpp"    // Inclusion of the header file which declares the class and features
+                             // which get defined here.
+
+
+
+//==================================================================================================
+// Class constructor : every slot is empty.
+//==================================================================================================
+oogl::TimerWheel::TimerWheel(uint64_t tickDuration) :
+m_tickDuration(std::max<uint64_t>(tickDuration, 1)), m_origin(oogl::getEventTimestamp()),
+m_currentTick(0), m_timerCount(0), m_timers(), m_freeHead(NO_TIMER),
+m_slots(SLOT_COUNT * LEVEL_COUNT, NO_TIMER), m_levelCounts(), m_batch(),
+m_eventQueue(nullptr), m_workerPool(nullptr)
+{}
+
+
+//==================================================================================================
+// Schedule a timer : take a timer from the free list, or grow the pool, then link it.
+//==================================================================================================
+oogl::TimerHandle oogl::TimerWheel::schedule(uint64_t delay, oogl::TimerCallback callback,
+                                             uint64_t data, uint64_t period)
+{
+    uint32_t index = m_freeHead;
+
+    if (index == NO_TIMER) {     // no free timer : grow the pool
+        index = static_cast<uint32_t>(m_timers.size());
+        m_timers.push_back(Timer { 0, 0, 0, nullptr, NO_TIMER, NO_TIMER, NO_TIMER, 0 });
+    } else {                     // reuse the first free timer
+        m_freeHead = m_timers[index].next;
+    }
+
+    Timer &        timer = m_timers[index];
+    uint64_t const ticks = std::max<uint64_t>((delay + m_tickDuration - 1) / m_tickDuration, 1);
+
+    timer.deadline = m_currentTick + ticks;
+    timer.period   = period == 0 ? 0 : std::max<uint64_t>(period / m_tickDuration, 1);
+    timer.data     = data;
+    timer.callback = callback;
+
+    link(index);
+    m_timerCount++;
+
+    return oogl::TimerHandle { index, timer.generation };
+}
+
+
+//==================================================================================================
+// Cancel a timer : unlink it and give it back to the free list.
+//==================================================================================================
+bool oogl::TimerWheel::cancel(oogl::TimerHandle timer) noexcept
+{
+    if (timer.index >= m_timers.size() || m_timers[timer.index].generation != timer.generation
+        || m_timers[timer.index].slot == NO_TIMER) {    // stale handle
+        return false;
+    }
+
+    unlink(timer.index);
+
+    Timer & cancelled = m_timers[timer.index];
+    cancelled.generation++;
+    cancelled.next = m_freeHead;
+    m_freeHead     = timer.index;
+    m_timerCount--;
+
+    return true;
+}
+
+
+//==================================================================================================
+// Advance up to a timestamp.
+//==================================================================================================
+std::size_t oogl::TimerWheel::update(uint64_t timestamp)
+{
+    uint64_t const target = timestamp > m_origin ? (timestamp - m_origin) / m_tickDuration : 0;
+
+    return target > m_currentTick ? advance(target - m_currentTick) : 0;
+}
+
+
+//==================================================================================================
+// Advance by a number of ticks. While the lowest wheels are empty, nothing can expire before the
+// next cascade of the first non empty wheel : the time jumps directly to the tick before it.
+//==================================================================================================
+std::size_t oogl::TimerWheel::advance(uint64_t ticks)
+{
+    OOGL_PROFILE_ZONE("TimerWheel::advance");
+
+    std::size_t fired = 0;
+
+    while (ticks > 0) {
+        unsigned int emptyLevels = 0;
+        while (emptyLevels < LEVEL_COUNT && m_levelCounts[emptyLevels] == 0) {
+            emptyLevels++;
+        }
+
+        if (emptyLevels == LEVEL_COUNT) {    // no timer at all
+            m_currentTick += ticks;
+            break;
+        }
+
+        if (emptyLevels > 0) {               // skip the ticks before the next cascade
+            unsigned int const shift   = SLOT_BITS * emptyLevels;
+            uint64_t const     cascade = ((m_currentTick >> shift) + 1) << shift;
+            uint64_t const     skip    = cascade - 1 - m_currentTick;
+
+            if (skip >= ticks) {
+                m_currentTick += ticks;
+                break;
+            }
+
+            m_currentTick += skip;
+            ticks         -= skip;
+        }
+
+        tick();
+        ticks--;
+
+        if (! m_batch.empty()) {
+            fired += m_batch.size();
+            dispatch();
+        }
+    }
+
+    return fired;
+}
+
+
+//==================================================================================================
+// Link a timer into a slot : the wheel is chosen by the distance to the deadline, and the slot by
+// the deadline bits of the wheel. Deadlines out of reach are parked in the last slot of the upper
+// wheel, and get hashed again when cascaded.
+//==================================================================================================
+void oogl::TimerWheel::link(uint32_t index) noexcept
+{
+    Timer &        timer = m_timers[index];
+    uint64_t const delta = std::min(timer.deadline - m_currentTick, MAX_DELTA);
+    uint64_t const due   = m_currentTick + delta;
+
+    unsigned int level = 0;
+    while (level + 1 < LEVEL_COUNT && delta >= (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+
+    uint32_t const slot = level * SLOT_COUNT
+                        + static_cast<uint32_t>((due >> (SLOT_BITS * level)) & SLOT_MASK);
+
+    m_levelCounts[level]++;
+
+    timer.slot     = slot;
+    timer.previous = NO_TIMER;
+    timer.next     = m_slots[slot];
+
+    if (timer.next != NO_TIMER) {
+        m_timers[timer.next].previous = index;
+    }
+
+    m_slots[slot] = index;
+}
+
+
+//==================================================================================================
+// Unlink a timer from its slot.
+//==================================================================================================
+void oogl::TimerWheel::unlink(uint32_t index) noexcept
+{
+    Timer & timer = m_timers[index];
+
+    if (timer.previous == NO_TIMER) {    // first timer of the slot
+        m_slots[timer.slot] = timer.next;
+    } else {
+        m_timers[timer.previous].next = timer.next;
+    }
+
+    if (timer.next != NO_TIMER) {
+        m_timers[timer.next].previous = timer.previous;
+    }
+
+    m_levelCounts[timer.slot / SLOT_COUNT]--;
+    timer.slot = NO_TIMER;
+}
+
+
+//==================================================================================================
+// Cascade the current slot of an upper wheel : its timers are now close enough to be hashed into
+// the lower wheels.
+//==================================================================================================
+void oogl::TimerWheel::cascade(unsigned int level) noexcept
+{
+    uint32_t const slot = level * SLOT_COUNT
+                        + static_cast<uint32_t>((m_currentTick >> (SLOT_BITS * level)) & SLOT_MASK);
+    uint32_t       index = m_slots[slot];
+
+    m_slots[slot] = NO_TIMER;
+
+    while (index != NO_TIMER) {
+        uint32_t const next = m_timers[index].next;
+        m_levelCounts[level]--;
+        link(index);
+        index = next;
+    }
+}
+
+
+//==================================================================================================
+// Advance by one tick : when the lower wheels complete a turn, the upper wheels get cascaded, from
+// the top so that the timers moved down are cascaded further if need be. Then the timers of the
+// current slot of the first wheel have expired.
+//==================================================================================================
+void oogl::TimerWheel::tick()
+{
+    m_currentTick++;
+    m_batch.clear();
+
+    unsigned int levels = 0;
+    while (levels + 1 < LEVEL_COUNT
+           && (m_currentTick & ((uint64_t(1) << (SLOT_BITS * (levels + 1))) - 1)) == 0) {
+        levels++;
+    }
+
+    for (unsigned int level = levels; level > 0; level--) {
+        cascade(level);
+    }
+
+    uint32_t const slot  = static_cast<uint32_t>(m_currentTick & SLOT_MASK);
+    uint32_t       index = m_slots[slot];
+
+    m_slots[slot] = NO_TIMER;
+
+    while (index != NO_TIMER) {
+        Timer &        timer = m_timers[index];
+        uint32_t const next  = timer.next;
+
+        m_levelCounts[0]--;
+        m_batch.push_back(Expired { oogl::TimerHandle { index, timer.generation }, timer.callback,
+                                    timer.data });
+
+        if (timer.period != 0) {    // repeating timer : link it again
+            timer.deadline += timer.period;
+            link(index);
+        } else {                    // give it back to the free list
+            timer.slot       = NO_TIMER;
+            timer.generation++;
+            timer.next       = m_freeHead;
+            m_freeHead       = index;
+            m_timerCount--;
+        }
+
+        index = next;
+    }
+}
+
+
+//==================================================================================================
+// Dispatch the batch : as the event queue accepts concurrent producers, the whole batch is spread
+// on the worker pool when there is one.
+//==================================================================================================
+void oogl::TimerWheel::dispatch()
+{
+    uint64_t const           timestamp = m_origin + m_currentTick * m_tickDuration;
+    oogl::EventQueue * const queue     = m_eventQueue.load(std::memory_order_acquire);
+
+    auto const fire = [this, timestamp, queue] (std::size_t index) {
+        Expired const & expired = m_batch[index];
+
+        if (expired.callback != nullptr) {
+            expired.callback(expired.timer, expired.data);
+        } else if (queue != nullptr) {
+            oogl::Event event = {};
+            event.type        = oogl::EventType::TIMER;
+            event.timestamp   = timestamp;
+            event.timer.id    = (uint64_t(expired.timer.index) << 32) | expired.timer.generation;
+            event.timer.data  = expired.data;
+            queue->push(event);
+        }
+    };
+
+    if (m_workerPool != nullptr && m_batch.size() > 1) {
+        m_workerPool->parallelFor(m_batch.size(), fire);
+    } else {
+        for (std::size_t index = 0; index < m_batch.size(); index++) {
+            fire(index);
+        }
+    }
+}
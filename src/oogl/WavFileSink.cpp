@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     WavFileSink.cpp
+///! \brief    This file contains the definition of the class oogl::WavFileSink and its features.
+///!           The class oogl::WavFileSink is the audio output recording the frames into a WAV file,
+///!           to check the mixing headless.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::WavFileSink
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <algorithm>
+#include <cmath>
+
+// Include list
+#include "OOGLException.hpp"
+
+#include "WavFileSink.hpp"    // Inclusion of the header file which declares the class and
+                              // features which get defined here.
+
+
+
+//==================================================================================================
+// Little endian serialization of the header fields.
+//==================================================================================================
+namespace
+{
+    std::size_t const  HEADER_SIZE      = 44;    // RIFF, fmt and data chunk headers
+    unsigned int const CHANNELS         = 2;     // Stereo frames
+    unsigned int const BYTES_PER_SAMPLE = 2;     // 16 bits samples
+
+    // Write a value of the given byte size at the cursor, and move the cursor after it.
+    void put(char * & cursor, uint32_t value, unsigned int size)
+    {
+        for (unsigned int byte = 0; byte < size; byte++) {
+            *cursor++ = static_cast<char>((value >> (8 * byte)) & 0xFF);
+        }
+    }
+}
+
+
+//==================================================================================================
+// Class constructor : create the file with a header describing no frame yet.
+//==================================================================================================
+oogl::WavFileSink::WavFileSink(std::string const & path, unsigned int sampleRate) :
+m_file(path, std::ios::binary | std::ios::trunc), m_sampleRate(sampleRate), m_frameCount(0)
+{
+    if (! m_file) {    // the file cannot be created
+        OOGL_THROW(oogl::ExceptionCode::AUDIO_SINK_FAILED);
+    }
+
+    writeHeader();
+}
+
+
+//==================================================================================================
+// Class destructor : errors cannot be reported anymore, they are ignored.
+//==================================================================================================
+oogl::WavFileSink::~WavFileSink() noexcept
+{
+#if defined(OOGL_NO_EXCEPTIONS)
+    close();
+#else
+    try {
+        close();
+    } catch (...) {
+    }
+#endif
+}
+
+
+//==================================================================================================
+// Convert the samples to 16 bits integers, by chunks, and append them.
+//==================================================================================================
+void oogl::WavFileSink::write(float const * samples, std::size_t frameCount)
+{
+    if (! m_file.is_open()) {    // closed file
+        OOGL_THROW(oogl::ExceptionCode::AUDIO_SINK_FAILED);
+    }
+
+    char chunk[4096];
+
+    for (std::size_t done = 0; done < frameCount * CHANNELS; ) {
+        std::size_t const count  = std::min(frameCount * CHANNELS - done,
+                                            sizeof(chunk) / BYTES_PER_SAMPLE);
+        char *            cursor = chunk;
+
+        for (std::size_t index = 0; index < count; index++) {
+            float const sample = std::fmax(-1.f, std::fmin(1.f, samples[done + index]));
+            put(cursor, static_cast<uint16_t>(static_cast<int16_t>(std::lrint(sample * 32767.f))),
+                BYTES_PER_SAMPLE);
+        }
+
+        m_file.write(chunk, static_cast<std::streamsize>(count * BYTES_PER_SAMPLE));
+        done += count;
+    }
+
+    if (! m_file) {    // the frames cannot be written
+        OOGL_THROW(oogl::ExceptionCode::AUDIO_SINK_FAILED);
+    }
+
+    m_frameCount += frameCount;
+}
+
+
+//==================================================================================================
+// Rewrite the header with the final sizes, then close the file.
+//==================================================================================================
+void oogl::WavFileSink::close()
+{
+    if (! m_file.is_open()) {    // already closed
+        return;
+    }
+
+    m_file.seekp(0);
+    writeHeader();
+    m_file.close();
+
+    if (! m_file) {    // the header cannot be written
+        OOGL_THROW(oogl::ExceptionCode::AUDIO_SINK_FAILED);
+    }
+}
+
+
+//==================================================================================================
+// Write the RIFF header of a PCM file.
+//==================================================================================================
+void oogl::WavFileSink::writeHeader()
+{
+    uint32_t const dataSize = static_cast<uint32_t>(m_frameCount * CHANNELS * BYTES_PER_SAMPLE);
+    char           header[HEADER_SIZE];
+    char *         cursor   = header;
+
+    put(cursor, 0x46464952, 4);                                        // "RIFF"
+    put(cursor, static_cast<uint32_t>(HEADER_SIZE - 8) + dataSize, 4);
+    put(cursor, 0x45564157, 4);                                        // "WAVE"
+    put(cursor, 0x20746D66, 4);                                        // "fmt "
+    put(cursor, 16, 4);                                                // format chunk size
+    put(cursor, 1, 2);                                                 // PCM
+    put(cursor, CHANNELS, 2);
+    put(cursor, m_sampleRate, 4);
+    put(cursor, m_sampleRate * CHANNELS * BYTES_PER_SAMPLE, 4);        // bytes per second
+    put(cursor, CHANNELS * BYTES_PER_SAMPLE, 2);                       // bytes per frame
+    put(cursor, 8 * BYTES_PER_SAMPLE, 2);                              // bits per sample
+    put(cursor, 0x61746164, 4);                                        // "data"
+    put(cursor, dataSize, 4);
+
+    m_file.write(header, static_cast<std::streamsize>(HEADER_SIZE));
+}
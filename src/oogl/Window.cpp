@@ -8,9 +8,14 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+// Standard include list
+#include <atomic>
+
 // Include list
 #include "OOGLHandler.hpp"
 #include "OOGLHandlerFactory.hpp"
+#include "Profiler.hpp"
+#include "WindowIndex.hpp"
 
 #include "Window.hpp"    // Inclusion of the header file which declares the class and
                          // features which get defined here.
@@ -21,8 +26,10 @@
 // Default constructor.
 //==================================================================================================
 oogl::Window::Window() :
-m_children(std::set<Window *>()), m_dimensions({0,0,0,0}), m_isInit(false),
-m_option(oogl::WindowOption::NONE), m_parent(nullptr), m_title(std::string())
+m_dimensions({0,0,0,0}), m_isInit(false), m_option(oogl::WindowOption::NONE), m_parent(nullptr),
+m_firstChild(nullptr), m_lastChild(nullptr), m_previousSibling(nullptr), m_nextSibling(nullptr),
+m_childCount(0), m_stackKey(0), m_revision(0), m_isRevised(false), m_title(std::string()),
+m_framebuffer(), m_damage(), m_handler(nullptr), m_index(nullptr), m_indexEntry(0)
 {}
 
 
@@ -30,36 +37,92 @@ m_option(oogl::WindowOption::NONE), m_parent(nullptr), m_title(std::string())
 // Constructors to set the title and the position
 //==================================================================================================
 oogl::Window::Window(std::string tittle, oogl::Rectangle const & dimensions) :
-m_children(std::set<Window *>()), m_dimensions(dimensions), m_isInit(false),
-m_option(oogl::WindowOption::NONE), m_parent(nullptr), m_title(std::string(tittle))
+m_dimensions(dimensions), m_isInit(false), m_option(oogl::WindowOption::NONE), m_parent(nullptr),
+m_firstChild(nullptr), m_lastChild(nullptr), m_previousSibling(nullptr), m_nextSibling(nullptr),
+m_childCount(0), m_stackKey(0), m_revision(0), m_isRevised(false),
+m_title(std::string(tittle)), m_framebuffer(), m_damage(), m_handler(nullptr), m_index(nullptr),
+m_indexEntry(0)
 {}
 
 
 //==================================================================================================
-// Copy constructor.
+// Copy constructor. As its tracking handle, the links of the instance are not copied : the copy
+// starts without parent nor children, out of any index.
 //==================================================================================================
 oogl::Window::Window(oogl::Window const & instance) :
-m_children(std::set<Window *>(instance.m_children)), m_dimensions(instance.m_dimensions),
-m_isInit(instance.m_isInit), m_option(instance.m_option), m_parent(instance.m_parent),
-m_title(std::string(instance.m_title))
+oogl::ITrackableObject(instance),
+m_dimensions(instance.m_dimensions), m_isInit(instance.m_isInit), m_option(instance.m_option),
+m_parent(nullptr), m_firstChild(nullptr), m_lastChild(nullptr), m_previousSibling(nullptr),
+m_nextSibling(nullptr), m_childCount(0), m_stackKey(0), m_revision(0), m_isRevised(false),
+m_title(std::string(instance.m_title)),
+m_framebuffer(instance.m_framebuffer), m_damage(instance.m_damage), m_handler(instance.m_handler),
+m_index(nullptr), m_indexEntry(0)
 {}
 
 
 //==================================================================================================
-// Move constructor.
+// Move constructor : the new window takes the place of the instance in its tree and its index.
 //==================================================================================================
 oogl::Window::Window(oogl::Window && instance) :
-m_children(std::move(instance.m_children)), m_dimensions(std::move(instance.m_dimensions)),
-m_isInit(instance.m_isInit), m_option(instance.m_option), m_parent(instance.m_parent),
-m_title(std::move(instance.m_title))
-{}
+m_dimensions(std::move(instance.m_dimensions)), m_isInit(instance.m_isInit),
+m_option(instance.m_option), m_parent(instance.m_parent), m_firstChild(instance.m_firstChild),
+m_lastChild(instance.m_lastChild), m_previousSibling(instance.m_previousSibling),
+m_nextSibling(instance.m_nextSibling), m_childCount(instance.m_childCount),
+m_stackKey(instance.m_stackKey), m_revision(instance.m_revision), m_isRevised(false),
+m_title(std::move(instance.m_title)),
+m_framebuffer(std::move(instance.m_framebuffer)), m_damage(std::move(instance.m_damage)),
+m_handler(instance.m_handler), m_index(instance.m_index), m_indexEntry(instance.m_indexEntry)
+{
+    if (m_previousSibling != nullptr) {
+        m_previousSibling->m_nextSibling = this;
+    } else if (m_parent != nullptr) {
+        m_parent->m_firstChild = this;
+    }
+
+    if (m_nextSibling != nullptr) {
+        m_nextSibling->m_previousSibling = this;
+    } else if (m_parent != nullptr) {
+        m_parent->m_lastChild = this;
+    }
+
+    for (Window * child = m_firstChild; child != nullptr; child = child->m_nextSibling) {
+        child->m_parent = this;
+    }
+
+    instance.m_parent          = nullptr;
+    instance.m_firstChild      = nullptr;
+    instance.m_lastChild       = nullptr;
+    instance.m_previousSibling = nullptr;
+    instance.m_nextSibling     = nullptr;
+    instance.m_childCount      = 0;
+
+    if (m_index != nullptr) {
+        m_index->move(instance, *this);
+        instance.m_index = nullptr;
+    }
+
+    instance.revise();    // left without children
+    revise();             // a new window in the trees of the ancestors
+}
 
 
 //==================================================================================================
-// Class destructor.
+// Class destructor : leave the index with the subtree, leave the parent, and orphan the children.
 //==================================================================================================
 oogl::Window::~Window() noexcept
-{}
+{
+    if (m_index != nullptr) {
+        m_index->remove(*this);
+    }
+
+    if (m_parent != nullptr) {
+        looseParent();
+    }
+
+    while (m_firstChild != nullptr) {
+        m_firstChild->looseParent();
+    }
+}
 
 
 //==================================================================================================
@@ -67,18 +130,26 @@ oogl::Window::~Window() noexcept
 //==================================================================================================
 void oogl::Window::init()
 {
+    OOGL_PROFILE_ZONE("Window::init");
+
     // Check the instance is not yet initialized
     if (m_isInit) {
-        throw oogl::OOGLException(oogl::ExceptionCode::WIN_ALREADY_CREATED);
+        OOGL_THROW(oogl::ExceptionCode::WIN_ALREADY_CREATED);
     }
 
+    // Allocate the pixels first, so that a failure leaves the window untracked
+    m_framebuffer.allocate(m_dimensions.width, m_dimensions.height);
+
     // Get the library handler instance : the next line either access a handler or throw an except.
-    oogl::OOGLHandlerFactory()
-        .getGraphicLibraryHandler()
-        .track(this);                   // Track the new initialized window
+    m_handler = &oogl::OOGLHandlerFactory().getGraphicLibraryHandler();
+    m_handler->track(this);             // Track the new initialized window
 
     // Indicates the instance has been created
     m_isInit = true;
+
+    // Nothing has been presented yet : the whole window is damaged
+    m_damage.clear();
+    addDamage({0, 0, m_dimensions.width, m_dimensions.height});
 }
 
 
@@ -87,129 +158,232 @@ void oogl::Window::init()
 //==================================================================================================
 void oogl::Window::free()
 {
+    OOGL_PROFILE_ZONE("Window::free");
+
     // Check the instance is created
     if (!m_isInit) {
-        throw oogl::OOGLException(oogl::ExceptionCode::WIN_NOT_CREATED);
+        OOGL_THROW(oogl::ExceptionCode::WIN_NOT_CREATED);
     }
 
-    // Get the library handler instance : the next line is not supposed to fail here.
-    oogl::OOGLHandlerFactory()
-        .getGraphicLibraryHandler()
-        .untrack(this);                 // Untrack the window
-    
+    // The handler which tracked the window, whichever thread frees it
+    m_handler->untrack(this);           // Untrack the window
+    m_handler = nullptr;
+
+    // Release the pixels
+    m_framebuffer.release();
+    m_damage.clear();
+
     // Indicates the instance is not initialized anymore
     m_isInit = false;
 }
 
 
 //==================================================================================================
-// Method which activate an option flag.
+// The calling becomes a child of the given instance, and joins the index of its hierarchy, which
+// allocates its entries and cells.
 //==================================================================================================
-oogl::Window & oogl::Window::activateOption(WindowOption option) noexcept
+oogl::Window & oogl::Window::linkToParent(oogl::Window & window)
 {
-    if (m_option == oogl::WindowOption::NONE) {          // no option to activate : return
-        return *this;
+    if (m_index != nullptr && m_index != window.m_index) {    // leave the former index first
+        m_index->remove(*this);
+    }
+
+    if (m_parent != nullptr) {    // leave the former parent first
+        unlink();
     }
 
-    if (option == oogl::WindowOption::ALL) {             // activate all the options using one flag
-        m_option = oogl::WindowOption::ALL;
-    } else if (m_option != oogl::WindowOption::ALL) {    // there are systems left to activate
-        m_option = m_option | option;
+    m_parent = &window;
+    linkOnTop();
+
+    if (m_index != nullptr) {                 // moved within the index
+        m_index->update(*this);
+    } else if (window.m_index != nullptr) {   // joins the index
+        window.m_index->insert(*this);
     }
 
     return *this;
 }
 
+
 //==================================================================================================
-// Method which deactivate an option of the creation.
+// Unlink the parent-child windows involved in the method call.
 //==================================================================================================
-oogl::Window & oogl::Window::deactivateOption(WindowOption option) noexcept
+oogl::Window & oogl::Window::looseParent() noexcept
 {
-    if (m_option == oogl::WindowOption::NONE) {          // no option to deactivate : return
+    if (m_parent == nullptr) {    // no parent : nothing to loose
         return *this;
     }
 
-    if (option == oogl::WindowOption::ALL) {             // deactivate every options using one flag
-        m_option = oogl::WindowOption::NONE;
-    } else if (m_option != oogl::WindowOption::NONE) {   // there are options left to deactivate
-        m_option = m_option & (!option);
+    if (m_index != nullptr) {     // the subtree leaves the index of the hierarchy
+        m_index->remove(*this);
     }
 
+    unlink();
+    m_parent = nullptr;
     return *this;
 }
 
 
 //==================================================================================================
-// The calling becomes a child of the given instance.
+// Returns a view of the attached children windows.
 //==================================================================================================
-oogl::Window & oogl::Window::linkToParent(oogl::Window & window) noexcept
+oogl::WindowChildren oogl::Window::getChildren() const noexcept
 {
-    m_parent = &window;
-    window.m_children.insert(this);
-    return *this;
+    return oogl::WindowChildren(m_firstChild, m_childCount);
 }
 
 
 //==================================================================================================
-// Unlink the parent-child windows involved in the method call.
+// Put the window on the top of its siblings.
 //==================================================================================================
-oogl::Window & oogl::Window::looseParent() noexcept
+oogl::Window & oogl::Window::raise() noexcept
 {
-    m_parent->m_children.erase(this);
-    m_parent = nullptr;
+    if (m_parent != nullptr && m_nextSibling != nullptr) {    // not yet on the top
+        unlink();
+        linkOnTop();
+    }
+
     return *this;
 }
 
 
 //==================================================================================================
-// Returns a reference to the parent method.
+// Put the window at the bottom of its siblings.
 //==================================================================================================
-oogl::Window & oogl::Window::getParent() const noexcept
+oogl::Window & oogl::Window::lower() noexcept
 {
-    return *m_parent;
+    if (m_parent != nullptr && m_previousSibling != nullptr) {    // not yet at the bottom
+        unlink();
+        linkAtBottom();
+    }
+
+    return *this;
 }
 
 
 //==================================================================================================
-// Returns the set of the attached children windows.
+// Increment the revisions up to the root. The ancestors of a revised window are revised too, until
+// a tree gets flattened from one of them, which clears the flag of the window : the walk stops at
+// the first revised window, so that changes in a row cost a constant time.
 //==================================================================================================
-std::set<oogl::Window *> oogl::Window::getChildren() const noexcept
+void oogl::Window::revise() noexcept
 {
-    return m_children;
+    for (Window * window = this; window != nullptr; window = window->m_parent) {
+        if (window->m_isRevised.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        window->m_revision++;
+        window->m_isRevised.store(true, std::memory_order_relaxed);
+    }
 }
 
 
 //==================================================================================================
-// Title getter.
+// Remove the window from the children of its parent ; the parent pointer is left to the caller.
 //==================================================================================================
-std::string oogl::Window::getTitle() const noexcept
+void oogl::Window::unlink() noexcept
 {
-    return std::string(m_title);
+    if (m_previousSibling != nullptr) {
+        m_previousSibling->m_nextSibling = m_nextSibling;
+    } else {
+        m_parent->m_firstChild = m_nextSibling;
+    }
+
+    if (m_nextSibling != nullptr) {
+        m_nextSibling->m_previousSibling = m_previousSibling;
+    } else {
+        m_parent->m_lastChild = m_previousSibling;
+    }
+
+    m_previousSibling = nullptr;
+    m_nextSibling     = nullptr;
+    m_parent->m_childCount--;
+    m_parent->revise();
 }
 
 
 //==================================================================================================
-// Title setter.
+// Add the window on the top of the children of its parent : the key is above the one of the
+// former top.
 //==================================================================================================
-void oogl::Window::setTitle(std::string const & title) noexcept
+void oogl::Window::linkOnTop() noexcept
 {
-    m_title = std::string(title);
+    m_stackKey        = m_parent->m_lastChild != nullptr ? m_parent->m_lastChild->m_stackKey + 1
+                                                         : 0;
+    m_previousSibling = m_parent->m_lastChild;
+    m_nextSibling     = nullptr;
+
+    if (m_previousSibling != nullptr) {
+        m_previousSibling->m_nextSibling = this;
+    } else {
+        m_parent->m_firstChild = this;
+    }
+
+    m_parent->m_lastChild = this;
+    m_parent->m_childCount++;
+    m_parent->revise();
 }
 
 
 //==================================================================================================
-// Dimensions getter.
+// Add the window at the bottom of the children of its parent : the key is below the one of the
+// former bottom.
 //==================================================================================================
-oogl::Rectangle oogl::Window::getDimensions() const noexcept
+void oogl::Window::linkAtBottom() noexcept
 {
-    return oogl::Rectangle(m_dimensions);
+    m_stackKey        = m_parent->m_firstChild != nullptr ? m_parent->m_firstChild->m_stackKey - 1
+                                                          : 0;
+    m_previousSibling = nullptr;
+    m_nextSibling     = m_parent->m_firstChild;
+
+    if (m_nextSibling != nullptr) {
+        m_nextSibling->m_previousSibling = this;
+    } else {
+        m_parent->m_lastChild = this;
+    }
+
+    m_parent->m_firstChild = this;
+    m_parent->m_childCount++;
+    m_parent->revise();
 }
 
 
 //==================================================================================================
 // Dimensions setter.
 //==================================================================================================
-void oogl::Window::setDimensions(oogl::Rectangle const & dimensions) noexcept
+void oogl::Window::setDimensions(oogl::Rectangle const & dimensions)
 {
+    if (m_isInit) {    // resize the pixels ; no reallocation when the new size fits
+        m_framebuffer.allocate(dimensions.width, dimensions.height);
+    }
+
     m_dimensions = oogl::Rectangle(dimensions);
+
+    if (m_isInit) {    // the pixels are left unspecified : the whole window is damaged
+        m_damage.clear();
+        addDamage({0, 0, m_dimensions.width, m_dimensions.height});
+    }
+
+    if (m_index != nullptr) {
+        m_index->update(*this);
+    }
+}
+
+
+//==================================================================================================
+// Present only the damaged spans into the destination.
+//==================================================================================================
+void oogl::Window::present(oogl::Framebuffer & destination)
+{
+    OOGL_PROFILE_ZONE("Window::present");
+
+    for (oogl::Rectangle const & rectangle : m_damage.getRectangles()) {
+        destination.copy(m_framebuffer, rectangle.xPosition, rectangle.yPosition,
+                         rectangle.width, rectangle.height,
+                         m_dimensions.xPosition + rectangle.xPosition,
+                         m_dimensions.yPosition + rectangle.yPosition);
+    }
+
+    m_damage.clear();
 }
\ No newline at end of file
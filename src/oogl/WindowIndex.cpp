@@ -0,0 +1,608 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     WindowIndex.cpp
+///! \brief    This file contains the definition of the class oogl::WindowIndex and its features.
+///!           The class oogl::WindowIndex is the spatial index of a window hierarchy : it finds
+///!           the topmost visible window under a point, to route the pointer events, without
+///!           walking every window.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::WindowIndex
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <algorithm>
+
+// Include list
+#include "Profiler.hpp"
+
+#include "WindowIndex.hpp"    // Inclusion of the header file which declares the class and
+                              // features which get defined here.
+
+
+
+//==================================================================================================
+// Geometry and traversal helpers.
+//==================================================================================================
+namespace
+{
+    // Intersection of two rectangles, empty when they do not overlap.
+    oogl::Rectangle intersect(oogl::Rectangle const & first, oogl::Rectangle const & second)
+    {
+        unsigned int const left   = std::max(first.xPosition, second.xPosition);
+        unsigned int const top    = std::max(first.yPosition, second.yPosition);
+        unsigned int const right  = std::min(first.xPosition + first.width,
+                                             second.xPosition + second.width);
+        unsigned int const bottom = std::min(first.yPosition + first.height,
+                                             second.yPosition + second.height);
+
+        if (right <= left || bottom <= top) {
+            return { left, top, 0, 0 };
+        }
+
+        return { left, top, right - left, bottom - top };
+    }
+
+    // Tell whether a rectangle contains a point.
+    inline bool contains(oogl::Rectangle const & rectangle, uint64_t x, uint64_t y)
+    {
+        return x >= rectangle.xPosition && x - rectangle.xPosition < rectangle.width
+               && y >= rectangle.yPosition && y - rectangle.yPosition < rectangle.height;
+    }
+
+    // Next window of the subtree of top in depth-first order, the children of the window being
+    // skipped when descend is false ; nullptr once the subtree is walked.
+    oogl::Window * next(oogl::Window & window, oogl::Window const & top, bool descend) noexcept
+    {
+        if (descend && window.getFirstChild() != nullptr) {
+            return window.getFirstChild();
+        }
+
+        for (oogl::Window * current = &window; current != &top; current = &current->getParent()) {
+            if (current->getNextSibling() != nullptr) {
+                return current->getNextSibling();
+            }
+        }
+
+        return nullptr;
+    }
+}
+
+
+//==================================================================================================
+// Class constructor : the hierarchy of the root gets indexed.
+//==================================================================================================
+oogl::WindowIndex::WindowIndex(oogl::Window & root) :
+m_root(nullptr), m_entries(), m_nodes(), m_freeEntry(NONE), m_freeNode(NONE), m_size(0),
+m_xWorld(0), m_yWorld(0), m_worldSize(1), m_xPointer(INT32_MIN), m_yPointer(INT32_MIN)
+{
+    if (root.m_index != nullptr) {    // leave the former index
+        root.m_index->remove(root);
+    }
+
+    m_root = &root;
+    reset();
+    insert(root);
+}
+
+
+//==================================================================================================
+// Class destructor : the windows forget their index.
+//==================================================================================================
+oogl::WindowIndex::~WindowIndex() noexcept
+{
+    for (Entry const & entry : m_entries) {
+        if (entry.window != nullptr) {
+            entry.window->m_index = nullptr;
+        }
+    }
+}
+
+
+//==================================================================================================
+// Look for the point in the cells whose loosened bounds contain it, from the root cell down. The
+// bounds are doubled so that the half cells stay integral.
+//==================================================================================================
+oogl::Window * oogl::WindowIndex::hitTest(int32_t x, int32_t y) const noexcept
+{
+    if (m_root == nullptr || x < static_cast<int64_t>(m_xWorld)
+        || y < static_cast<int64_t>(m_yWorld)) {    // out of the root
+        return nullptr;
+    }
+
+    struct Cell
+    {
+        uint32_t    node;
+        uint32_t    level;
+        uint64_t    x;
+        uint64_t    y;
+    };
+
+    uint64_t const xPoint   = static_cast<uint64_t>(x);
+    uint64_t const yPoint   = static_cast<uint64_t>(y);
+    uint64_t const xDoubled = 2 * (xPoint - m_xWorld) + 1;    // center of the pixel
+    uint64_t const yDoubled = 2 * (yPoint - m_yWorld) + 1;
+
+    Cell           cells[4 * (MAX_DEPTH + 1)];
+    std::size_t    size = 0;
+    oogl::Window * best = nullptr;
+
+    cells[size++] = Cell { 0, 0, 0, 0 };
+
+    while (size > 0) {
+        Cell const   cell = cells[--size];
+        Node const & node = m_nodes[cell.node];
+
+        for (Item const & item : node.items) {
+            if (! contains(item.area, xPoint, yPoint)) {
+                continue;
+            }
+
+            oogl::Window * const window = m_entries[item.entry].window;
+            if ((best == nullptr || isAbove(*window, *best)) && isVisible(*window)) {
+                best = window;
+            }
+        }
+
+        uint64_t const quarter = m_worldSize >> (cell.level + 1);    // side of the quarters
+
+        for (uint32_t position = 0; position < 4 && quarter > 0; position++) {
+            uint32_t const child = node.children[position];
+            if (child == NONE || m_nodes[child].count == 0) {
+                continue;
+            }
+
+            uint64_t const xCell = 2 * cell.x + (position & 1);
+            uint64_t const yCell = 2 * cell.y + (position >> 1);
+            uint64_t const left  = 2 * xCell * quarter;    // loosened by half a quarter
+            uint64_t const top   = 2 * yCell * quarter;
+
+            if (xDoubled + quarter >= left && xDoubled < left + 3 * quarter
+                && yDoubled + quarter >= top && yDoubled < top + 3 * quarter) {
+                cells[size++] = Cell { child, cell.level + 1, xCell, yCell };
+            }
+        }
+    }
+
+    return best;
+}
+
+
+//==================================================================================================
+// Route the pointer events : positions are made relative to the window found.
+//==================================================================================================
+oogl::Window * oogl::WindowIndex::route(oogl::Event & event) noexcept
+{
+    OOGL_PROFILE_ZONE("WindowIndex::route");
+
+    switch (event.type) {
+        case oogl::EventType::MOUSE_MOTION:
+        case oogl::EventType::MOUSE_BUTTON_DOWN:
+        case oogl::EventType::MOUSE_BUTTON_UP:
+        {
+            m_xPointer = event.mouse.x;
+            m_yPointer = event.mouse.y;
+
+            oogl::Window * const window = hitTest(m_xPointer, m_yPointer);
+            if (window != nullptr) {
+                Entry const & entry = m_entries[window->m_indexEntry];
+                event.mouse.x -= static_cast<int32_t>(entry.xOrigin);
+                event.mouse.y -= static_cast<int32_t>(entry.yOrigin);
+            }
+            return window;
+        }
+
+        case oogl::EventType::MOUSE_WHEEL:    // the scroll has no position
+            return hitTest(m_xPointer, m_yPointer);
+
+        default:
+            return nullptr;
+    }
+}
+
+
+//==================================================================================================
+// Index a subtree in depth-first order, so that the parent of each window is composed before it.
+//==================================================================================================
+void oogl::WindowIndex::insert(oogl::Window & window)
+{
+    for (oogl::Window * current = &window; current != nullptr;
+         current = next(*current, window, true)) {
+        uint32_t const index = allocateEntry(*current);
+        compose(m_entries[index]);
+        place(index);
+    }
+}
+
+
+//==================================================================================================
+// Remove a subtree from the index ; the root takes the whole hierarchy along.
+//==================================================================================================
+void oogl::WindowIndex::remove(oogl::Window & window) noexcept
+{
+    if (&window != m_root) {
+        for (oogl::Window * current = &window; current != nullptr;
+             current = next(*current, window, true)) {
+            releaseEntry(current->m_indexEntry);
+        }
+        return;
+    }
+
+    for (Entry const & entry : m_entries) {
+        if (entry.window != nullptr) {
+            entry.window->m_index = nullptr;
+        }
+    }
+
+    m_entries.clear();
+    m_freeEntry = NONE;
+    m_size      = 0;
+    m_root      = nullptr;
+}
+
+
+//==================================================================================================
+// Compose the areas of a subtree again. A window whose area and origin did not change leaves the
+// areas of its own subtree unchanged : it gets skipped.
+//==================================================================================================
+void oogl::WindowIndex::update(oogl::Window & window)
+{
+    OOGL_PROFILE_ZONE("WindowIndex::update");
+
+    if (&window == m_root) {    // the root cell gets resized along
+        rebuild();
+        return;
+    }
+
+    oogl::Window * current = &window;
+
+    while (current != nullptr) {
+        uint32_t const index  = current->m_indexEntry;
+        Entry const    former = m_entries[index];
+        compose(m_entries[index]);
+
+        Entry const & entry = m_entries[index];
+        bool const    moved = entry.xOrigin != former.xOrigin || entry.yOrigin != former.yOrigin
+                              || entry.area.xPosition != former.area.xPosition
+                              || entry.area.yPosition != former.area.yPosition
+                              || entry.area.width != former.area.width
+                              || entry.area.height != former.area.height;
+
+        if (moved) {
+            unplace(index);
+            place(index);
+        }
+
+        current = next(*current, window, moved);
+    }
+}
+
+
+//==================================================================================================
+// The moved window keeps the entry of the instance.
+//==================================================================================================
+void oogl::WindowIndex::move(oogl::Window & from, oogl::Window & to) noexcept
+{
+    m_entries[from.m_indexEntry].window = &to;
+
+    if (m_root == &from) {
+        m_root = &to;
+    }
+}
+
+
+//==================================================================================================
+// Only the root cell is left, covering the root window with a side being a power of two.
+//==================================================================================================
+void oogl::WindowIndex::reset()
+{
+    oogl::Rectangle const dimensions = m_root->getDimensions();
+
+    m_nodes.clear();
+    m_freeNode  = NONE;
+    m_nodes.push_back(Node { { NONE, NONE, NONE, NONE }, NONE, 0, std::vector<Item>() });
+
+    m_xWorld    = dimensions.xPosition;
+    m_yWorld    = dimensions.yPosition;
+    m_worldSize = 1;
+
+    while (m_worldSize < std::max(dimensions.width, dimensions.height)) {
+        m_worldSize <<= 1;
+    }
+}
+
+
+//==================================================================================================
+// Build the quadtree again, the entries being kept.
+//==================================================================================================
+void oogl::WindowIndex::rebuild()
+{
+    OOGL_PROFILE_ZONE("WindowIndex::rebuild");
+
+    reset();
+
+    for (oogl::Window * current = m_root; current != nullptr;
+         current = next(*current, *m_root, true)) {
+        Entry & entry = m_entries[current->m_indexEntry];
+        entry.node = NONE;
+        compose(entry);
+        place(current->m_indexEntry);
+    }
+}
+
+
+//==================================================================================================
+// The area of a window is its rectangle placed in its parent, clipped by the area of the parent.
+//==================================================================================================
+void oogl::WindowIndex::compose(Entry & entry) const noexcept
+{
+    oogl::Window const &  window     = *entry.window;
+    oogl::Rectangle const dimensions = window.getDimensions();
+
+    if (&window == m_root) {
+        entry.xOrigin = dimensions.xPosition;
+        entry.yOrigin = dimensions.yPosition;
+        entry.area    = dimensions;
+        return;
+    }
+
+    Entry const & parent = m_entries[window.getParent().m_indexEntry];
+
+    entry.xOrigin = parent.xOrigin + dimensions.xPosition;
+    entry.yOrigin = parent.yOrigin + dimensions.yPosition;
+    entry.area    = intersect({ entry.xOrigin, entry.yOrigin, dimensions.width, dimensions.height },
+                              parent.area);
+}
+
+
+//==================================================================================================
+// The area goes to the deepest cell at least as large as it, among the ones holding its center :
+// the cell, loosened by half its side, contains the whole area.
+//==================================================================================================
+void oogl::WindowIndex::place(uint32_t index)
+{
+    Entry & entry = m_entries[index];
+
+    if (entry.area.width == 0 || entry.area.height == 0) {    // clipped out : nowhere to hit
+        entry.node = NONE;
+        return;
+    }
+
+    uint64_t const extent = std::max(entry.area.width, entry.area.height);
+    uint32_t       level  = 0;
+
+    while (level < MAX_DEPTH && (m_worldSize >> (level + 1)) >= extent) {
+        level++;
+    }
+
+    uint64_t const side  = m_worldSize >> level;
+    uint64_t const last  = (uint64_t(1) << level) - 1;
+    uint64_t const xCell = std::min(last, (2 * (entry.area.xPosition - uint64_t(m_xWorld))
+                                           + entry.area.width) / (2 * side));
+    uint64_t const yCell = std::min(last, (2 * (entry.area.yPosition - uint64_t(m_yWorld))
+                                           + entry.area.height) / (2 * side));
+
+    uint32_t node = 0;
+
+    for (uint32_t depth = level; depth > 0; depth--) {    // create the missing cells
+        uint32_t const position = static_cast<uint32_t>(((xCell >> (depth - 1)) & 1)
+                                                        | (((yCell >> (depth - 1)) & 1) << 1));
+        uint32_t child = m_nodes[node].children[position];
+
+        if (child == NONE) {
+            child = allocateNode(node);
+            m_nodes[node].children[position] = child;
+        }
+
+        node = child;
+    }
+
+    std::vector<Item> & items = m_nodes[node].items;
+    items.push_back(Item { m_entries[index].area, index });
+
+    m_entries[index].node = node;
+    m_entries[index].item = static_cast<uint32_t>(items.size() - 1);
+
+    for (uint32_t cell = node; cell != NONE; cell = m_nodes[cell].parent) {
+        m_nodes[cell].count++;
+    }
+}
+
+
+//==================================================================================================
+// Remove an entry from its cell, the last item of the cell taking its place. The cells left empty
+// are released, up to the highest one.
+//==================================================================================================
+void oogl::WindowIndex::unplace(uint32_t index) noexcept
+{
+    Entry & entry = m_entries[index];
+
+    if (entry.node == NONE) {    // not placed
+        return;
+    }
+
+    std::vector<Item> & items = m_nodes[entry.node].items;
+    items[entry.item] = items.back();
+    m_entries[items[entry.item].entry].item = entry.item;
+    items.pop_back();
+
+    uint32_t empty = NONE;
+
+    for (uint32_t cell = entry.node; cell != NONE; cell = m_nodes[cell].parent) {
+        if (--m_nodes[cell].count == 0 && cell != 0) {
+            empty = cell;
+        }
+    }
+
+    entry.node = NONE;
+
+    if (empty != NONE) {    // detach the empty branch from its parent
+        Node & parent = m_nodes[m_nodes[empty].parent];
+        std::replace(parent.children, parent.children + 4, empty, NONE);
+        releaseNodes(empty);
+    }
+}
+
+
+//==================================================================================================
+// Entry of a window, taken from the released ones first.
+//==================================================================================================
+uint32_t oogl::WindowIndex::allocateEntry(oogl::Window & window)
+{
+    uint32_t index = m_freeEntry;
+
+    if (index != NONE) {
+        m_freeEntry = m_entries[index].next;
+    } else {
+        index = static_cast<uint32_t>(m_entries.size());
+        m_entries.push_back(Entry());
+    }
+
+    m_entries[index] = Entry { &window, { 0, 0, 0, 0 }, 0, 0, NONE, 0, NONE };
+    window.m_index      = this;
+    window.m_indexEntry = index;
+    m_size++;
+
+    return index;
+}
+
+
+//==================================================================================================
+// Release the entry of a window, which leaves the index.
+//==================================================================================================
+void oogl::WindowIndex::releaseEntry(uint32_t index) noexcept
+{
+    unplace(index);
+
+    Entry & entry = m_entries[index];
+    entry.window->m_index = nullptr;
+    entry.window = nullptr;
+    entry.next   = m_freeEntry;
+
+    m_freeEntry = index;
+    m_size--;
+}
+
+
+//==================================================================================================
+// Cell of the quadtree, taken from the released ones first.
+//==================================================================================================
+uint32_t oogl::WindowIndex::allocateNode(uint32_t parent)
+{
+    uint32_t index = m_freeNode;
+
+    if (index != NONE) {
+        m_freeNode = m_nodes[index].parent;
+    } else {
+        index = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.push_back(Node { { NONE, NONE, NONE, NONE }, NONE, 0, std::vector<Item>() });
+    }
+
+    Node & node = m_nodes[index];
+    std::fill(node.children, node.children + 4, NONE);
+    node.parent = parent;
+    node.count  = 0;
+
+    return index;
+}
+
+
+//==================================================================================================
+// Release an empty branch without stack : go down while a quarter is left, detaching it, and
+// release the cells on the way back up.
+//==================================================================================================
+void oogl::WindowIndex::releaseNodes(uint32_t branch) noexcept
+{
+    uint32_t node = branch;
+
+    while (true) {
+        uint32_t * const children = m_nodes[node].children;
+        uint32_t * const child    = std::find_if(children, children + 4,
+                                                 [] (uint32_t cell) { return cell != NONE; });
+
+        if (child != children + 4) {    // go down
+            uint32_t const quarter = *child;
+            *child = NONE;
+            node   = quarter;
+            continue;
+        }
+
+        uint32_t const parent = m_nodes[node].parent;
+        m_nodes[node].parent = m_freeNode;
+        m_freeNode = node;
+
+        if (node == branch) {
+            return;
+        }
+
+        node = parent;
+    }
+}
+
+
+//==================================================================================================
+// A window is visible when neither it nor its ancestors, up to the root, are hidden or minimized.
+//==================================================================================================
+bool oogl::WindowIndex::isVisible(oogl::Window const & window) const noexcept
+{
+    for (oogl::Window const * current = &window; ; current = &current->getParent()) {
+        if (current->hasOption(oogl::WindowOption::HIDDEN | oogl::WindowOption::MINIMIZED)) {
+            return false;
+        }
+
+        if (current == m_root) {
+            return true;
+        }
+    }
+}
+
+
+//==================================================================================================
+// A window is above its ancestors ; otherwise, the windows are brought to the same depth, then up
+// to siblings, compared by their stacking key.
+//==================================================================================================
+bool oogl::WindowIndex::isAbove(oogl::Window const & window, oogl::Window const & other) noexcept
+{
+    if (window.m_parent == other.m_parent) {    // siblings
+        return window.m_stackKey > other.m_stackKey;
+    }
+
+    if (window.m_parent == &other || other.m_parent == &window) {
+        return window.m_parent == &other;
+    }
+
+    std::size_t windowDepth = 0;
+    std::size_t otherDepth  = 0;
+
+    for (oogl::Window const * current = window.m_parent; current != nullptr;
+         current = current->m_parent) {
+        windowDepth++;
+    }
+
+    for (oogl::Window const * current = other.m_parent; current != nullptr;
+         current = current->m_parent) {
+        otherDepth++;
+    }
+
+    oogl::Window const * first  = &window;
+    oogl::Window const * second = &other;
+
+    for (; windowDepth > otherDepth; windowDepth--) {
+        first = first->m_parent;
+    }
+
+    for (; otherDepth > windowDepth; otherDepth--) {
+        second = second->m_parent;
+    }
+
+    if (first == second) {    // one is an ancestor of the other : the deeper one is above
+        return first != &window;
+    }
+
+    while (first->m_parent != second->m_parent) {
+        first  = first->m_parent;
+        second = second->m_parent;
+    }
+
+    return first->m_stackKey > second->m_stackKey;
+}
@@ -0,0 +1,231 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     WindowTransaction.cpp
+///! \brief    This file contains the definition of the class oogl::WindowTransaction and its
+///!           features. The class oogl::WindowTransaction collects the property changes of many
+///!           windows, and applies them at once, each window being updated a single time.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::WindowTransaction
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <exception>
+#include <utility>
+
+// Include list
+#include "Profiler.hpp"
+
+#include "WindowTransaction.hpp"    // Inclusion of the header file which declares the class and
+                                    // features which get defined here.
+
+
+
+//==================================================================================================
+// Class constructor : the transaction is empty.
+//==================================================================================================
+oogl::WindowTransaction::WindowTransaction() noexcept :
+m_changes(), m_indices()
+{}
+
+
+//==================================================================================================
+// Change the title : the last one wins.
+//==================================================================================================
+oogl::WindowTransaction & oogl::WindowTransaction::setTitle(oogl::Window & window,
+                                                            std::string const & title)
+{
+    Change & change = getChange(window);
+    change.properties |= TITLE;
+    change.title       = title;
+    return *this;
+}
+
+
+//==================================================================================================
+// Change the dimensions : the last ones win.
+//==================================================================================================
+oogl::WindowTransaction & oogl::WindowTransaction::setDimensions(
+    oogl::Window & window, oogl::Rectangle const & dimensions)
+{
+    Change & change = getChange(window);
+    change.properties |= DIMENSIONS;
+    change.dimensions  = dimensions;
+    return *this;
+}
+
+
+//==================================================================================================
+// Activate options : they are not deactivated anymore. Activating every option supersedes the
+// former changes of the options.
+//==================================================================================================
+oogl::WindowTransaction & oogl::WindowTransaction::activateOption(oogl::Window & window,
+                                                                  oogl::WindowOption option)
+{
+    Change & change = getChange(window);
+
+    if (option == oogl::WindowOption::ALL) {
+        change.activated   = oogl::WindowOption::ALL;
+        change.deactivated = oogl::WindowOption::NONE;
+    } else if (change.activated != oogl::WindowOption::ALL) {
+        change.activated   = change.activated | option;
+        change.deactivated = change.deactivated & (~option);
+    }
+
+    return *this;
+}
+
+
+//==================================================================================================
+// Deactivate options : they are not activated anymore. Deactivating every option supersedes the
+// former changes of the options.
+//==================================================================================================
+oogl::WindowTransaction & oogl::WindowTransaction::deactivateOption(oogl::Window & window,
+                                                                    oogl::WindowOption option)
+{
+    Change & change = getChange(window);
+
+    if (option == oogl::WindowOption::ALL) {
+        change.activated   = oogl::WindowOption::NONE;
+        change.deactivated = oogl::WindowOption::ALL;
+    } else {
+        change.activated = change.activated & (~option);
+
+        if (change.deactivated != oogl::WindowOption::ALL) {    // else already deactivated
+            change.deactivated = change.deactivated | option;
+        }
+    }
+
+    return *this;
+}
+
+
+//==================================================================================================
+// Open a window once its other changes are applied.
+//==================================================================================================
+oogl::WindowTransaction & oogl::WindowTransaction::open(oogl::Window & window)
+{
+    getChange(window).properties |= OPEN;
+    return *this;
+}
+
+
+//==================================================================================================
+// Forget the changes of a window : its entry is kept, without window, so that the order of the
+// others does not change.
+//==================================================================================================
+void oogl::WindowTransaction::discard(oogl::Window & window) noexcept
+{
+    std::unordered_map<oogl::Window *, std::size_t>::iterator const found =
+        m_indices.find(&window);
+
+    if (found != m_indices.end()) {
+        m_changes[found->second].window = nullptr;
+        m_indices.erase(found);
+    }
+}
+
+
+//==================================================================================================
+// Apply the changes, window by window. The transaction is emptied afterwards, even when a window
+// failed, so that it is ready for the next frame.
+//==================================================================================================
+void oogl::WindowTransaction::commit()
+{
+    OOGL_PROFILE_ZONE("WindowTransaction::commit");
+
+    std::exception_ptr failure;
+
+    for (Change const & change : m_changes) {
+        if (change.window == nullptr) {    // discarded
+            continue;
+        }
+
+        #if defined(OOGL_NO_EXCEPTIONS)
+        apply(change);
+        #else
+        try {
+            apply(change);
+        } catch (...) {    // the other windows still get updated
+            if (! failure) { failure = std::current_exception(); }
+        }
+        #endif
+    }
+
+    rollback();
+
+    #if ! defined(OOGL_NO_EXCEPTIONS)
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    #endif
+}
+
+
+//==================================================================================================
+// Forget every change.
+//==================================================================================================
+void oogl::WindowTransaction::rollback() noexcept
+{
+    m_changes.clear();
+    m_indices.clear();
+}
+
+
+//==================================================================================================
+// Get the changes of a window, added on its first change : the index and the change are added
+// together, or not at all.
+//==================================================================================================
+oogl::WindowTransaction::Change & oogl::WindowTransaction::getChange(oogl::Window & window)
+{
+    std::pair<std::unordered_map<oogl::Window *, std::size_t>::iterator, bool> const inserted =
+        m_indices.emplace(&window, m_changes.size());
+
+    if (inserted.second) {    // first change of the window
+        Change added { &window, 0, std::string(), oogl::Rectangle { 0, 0, 0, 0 },
+                       oogl::WindowOption::NONE, oogl::WindowOption::NONE };
+
+        #if defined(OOGL_NO_EXCEPTIONS)
+        m_changes.push_back(std::move(added));
+        #else
+        try {
+            m_changes.push_back(std::move(added));
+        } catch (...) {    // an index without its change would point past the changes
+            m_indices.erase(inserted.first);
+            throw;
+        }
+        #endif
+    }
+
+    return m_changes[inserted.first->second];
+}
+
+
+//==================================================================================================
+// Apply the changes of a window, through its setters : the options, the title, the dimensions,
+// then the initialization, which allocates the pixels with the final dimensions.
+//==================================================================================================
+void oogl::WindowTransaction::apply(Change const & change)
+{
+    oogl::Window & window = *change.window;
+
+    if (change.deactivated != oogl::WindowOption::NONE) {
+        window.deactivateOption(change.deactivated);
+    }
+
+    if (change.activated != oogl::WindowOption::NONE) {
+        window.activateOption(change.activated);
+    }
+
+    if ((change.properties & TITLE) != 0) {
+        window.setTitle(change.title);
+    }
+
+    if ((change.properties & DIMENSIONS) != 0) {
+        window.setDimensions(change.dimensions);
+    }
+
+    if ((change.properties & OPEN) != 0) {
+        window.init();
+    }
+}
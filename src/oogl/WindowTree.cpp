@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     WindowTree.cpp
+///! \brief    This file contains the definition of the class oogl::WindowTree and its features.
+///!           The class oogl::WindowTree flattens a window hierarchy into contiguous arrays, in
+///!           depth-first order, so that traversing it is a linear scan without allocation.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::WindowTree
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Include list
+#include "Profiler.hpp"
+
+#include "WindowTree.hpp"    // Inclusion of the header file which declares the class and features
+                             // which get defined here.
+
+
+
+//==================================================================================================
+// Class constructor : the tree is empty.
+//==================================================================================================
+oogl::WindowTree::WindowTree() noexcept :
+m_windows(), m_parents(), m_depths(), m_ends(), m_root(nullptr), m_revision(0)
+{}
+
+
+//==================================================================================================
+// Flatten a hierarchy : go down to the first child while there is one, otherwise to the next
+// sibling of the window or of its closest ancestor having one. The subtree of a window ends when
+// the walk leaves it. Every window walked is flattened : its next change revises its ancestors.
+//==================================================================================================
+void oogl::WindowTree::build(oogl::Window & root)
+{
+    OOGL_PROFILE_ZONE("WindowTree::build");
+
+    m_windows.clear();
+    m_parents.clear();
+    m_depths.clear();
+    m_ends.clear();
+
+    m_root     = &root;
+    m_revision = root.m_revision;
+
+    push(&root, NO_PARENT, 0);
+    uint32_t current = 0;
+
+    while (true) {
+        oogl::Window * const child = m_windows[current]->getFirstChild();
+
+        if (child != nullptr) {    // go down
+            push(child, current, m_depths[current] + 1);
+            current = static_cast<uint32_t>(m_windows.size() - 1);
+            continue;
+        }
+
+        while (true) {             // go up until a sibling is left
+            m_ends[current] = static_cast<uint32_t>(m_windows.size());
+
+            if (current == 0) {    // back to the root
+                return;
+            }
+
+            oogl::Window * const sibling = m_windows[current]->getNextSibling();
+            uint32_t const       parent  = m_parents[current];
+
+            if (sibling != nullptr) {
+                push(sibling, parent, m_depths[current]);
+                current = static_cast<uint32_t>(m_windows.size() - 1);
+                break;
+            }
+
+            current = parent;
+        }
+    }
+}
+
+
+//==================================================================================================
+// Flatten the hierarchy again when needed.
+//==================================================================================================
+bool oogl::WindowTree::update(oogl::Window & root)
+{
+    if (m_root == &root && ! isOutdated()) {
+        return false;
+    }
+
+    build(root);
+    return true;
+}
+
+
+//==================================================================================================
+// Append a window ; the end of its subtree is known once the walk leaves it.
+//==================================================================================================
+void oogl::WindowTree::push(oogl::Window * window, uint32_t parent, uint32_t depth)
+{
+    window->m_isRevised.store(false, std::memory_order_relaxed);
+    m_windows.push_back(window);
+    m_parents.push_back(parent);
+    m_depths.push_back(depth);
+    m_ends.push_back(0);
+}
@@ -0,0 +1,448 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     WorkerPool.cpp
+///! \brief    This file contains the definition of the classes oogl::WorkerPool and
+///!           oogl::TaskGroup and their features. The class oogl::WorkerPool is the job system of
+///!           the library : a pool of worker threads, one per hardware core by default, which
+///!           balance the submitted tasks between themselves by work stealing. The class
+///!           oogl::TaskGroup gathers tasks to wait for, or to continue with once they are done.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::WorkerPool
+///! \see      oogl::TaskGroup
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Include list
+#include "Profiler.hpp"
+
+#include "WorkerPool.hpp"    // Inclusion of the header file which declares the class and
+                             // features which get defined here.
+
+
+
+//==================================================================================================
+// Identify the calling thread : pool it works for, and index of the deque it owns in that pool.
+//==================================================================================================
+namespace
+{
+    thread_local oogl::WorkerPool const *   t_workerPool  = nullptr;
+    thread_local unsigned int               t_workerIndex = 0;
+
+    // Number of tasks each worker gets in a parallel loop, to balance uneven workloads.
+    constexpr std::size_t TASKS_PER_WORKER = 4;
+}
+
+
+//==================================================================================================
+// Class constructor : the worker threads get started later on.
+//==================================================================================================
+oogl::WorkerPool::WorkerPool(unsigned int workerCount) :
+m_workerCount(workerCount != 0 ? workerCount : std::max(1u, std::thread::hardware_concurrency())),
+m_deques(), m_sharedMutex(), m_shared(), m_threads(), m_isRunning(false), m_queuedTasks(0),
+m_sleepers(0), m_sleepMutex(), m_wakeUp(), m_workerHook(), m_affinity()
+{
+    for (unsigned int index = 0; index < m_workerCount; index++) {
+        m_deques.push_back(std::unique_ptr<Deque>(new Deque()));
+    }
+}
+
+
+//==================================================================================================
+// Class destructor.
+//==================================================================================================
+oogl::WorkerPool::~WorkerPool() noexcept
+{
+    stop();
+}
+
+
+//==================================================================================================
+// Start the worker threads.
+//==================================================================================================
+void oogl::WorkerPool::start()
+{
+    if (m_isRunning.exchange(true)) {    // the workers are already running
+        return;
+    }
+
+    for (unsigned int index = 0; index < m_workerCount; index++) {
+        m_threads.emplace_back(&oogl::WorkerPool::workerLoop, this, index);
+    }
+}
+
+
+//==================================================================================================
+// Set the function the workers call when they start.
+//==================================================================================================
+void oogl::WorkerPool::setWorkerHook(std::function<void(unsigned int)> hook)
+{
+    m_workerHook = std::move(hook);
+}
+
+
+//==================================================================================================
+// Set the cores the workers get pinned to.
+//==================================================================================================
+void oogl::WorkerPool::setAffinity(std::vector<unsigned int> cores)
+{
+    m_affinity = std::move(cores);
+}
+
+
+//==================================================================================================
+// Stop and join the worker threads.
+//==================================================================================================
+void oogl::WorkerPool::stop() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        if (! m_isRunning.exchange(false)) {    // the workers are not running
+            return;
+        }
+    }
+
+    m_wakeUp.notify_all();
+
+    for (std::thread & thread : m_threads) {
+        thread.join();
+    }
+
+    m_threads.clear();
+}
+
+
+//==================================================================================================
+// Parallel loop over indices, built on the loop over ranges.
+//==================================================================================================
+void oogl::WorkerPool::parallelFor(std::size_t count,
+                                   std::function<void(std::size_t)> const & body)
+{
+    parallelForRange(count, [&body] (std::size_t first, std::size_t last) {
+        for (std::size_t index = first; index < last; index++) {
+            body(index);
+        }
+    });
+}
+
+
+//==================================================================================================
+// Parallel loop over ranges : the range is cut into tasks living on the stack of the calling
+// thread, queued where the workers steal them. The calling thread then runs tasks until the whole
+// range is done.
+//==================================================================================================
+void oogl::WorkerPool::parallelForRange(
+    std::size_t count, std::function<void(std::size_t, std::size_t)> const & body)
+{
+    if (count == 0) {    // nothing to do
+        return;
+    }
+
+    std::size_t const taskCount = std::min<std::size_t>(count, m_workerCount * TASKS_PER_WORKER);
+    std::size_t const taskSize  = (count + taskCount - 1) / taskCount;
+
+    if (taskCount == 1 || ! m_isRunning) {    // not worth a dispatch, or no workers to help
+        body(0, count);
+        return;
+    }
+
+    oogl::TaskGroup   group(*this);
+    std::vector<Task> tasks;
+    tasks.reserve((count + taskSize - 1) / taskSize);
+
+    for (std::size_t first = 0; first < count; first += taskSize) {
+        std::size_t const last = std::min(count, first + taskSize);
+        tasks.push_back(Task { [&body, first, last] () { body(first, last); }, &group, false });
+    }
+
+    group.m_pending.fetch_add(tasks.size(), std::memory_order_relaxed);
+
+    // The first range is kept for the calling thread, the others are offered to the workers
+    for (std::size_t index = tasks.size() - 1; index > 0; index--) {
+        submit(&tasks[index]);
+    }
+
+    run(&tasks[0]);
+    wait(group);
+}
+
+
+//==================================================================================================
+// Queue a task, then wake up a sleeping worker if any.
+//==================================================================================================
+void oogl::WorkerPool::submit(Task * task)
+{
+    unsigned int const self = getWorkerIndex();
+
+    m_queuedTasks.fetch_add(1, std::memory_order_seq_cst);    // ordered with the sleepers count
+
+    if (self < m_workerCount) {    // a worker : its own deque
+        m_deques[self]->push(task);
+    } else {                       // another thread : the shared queue
+        std::lock_guard<std::mutex> lock(m_sharedMutex);
+        m_shared.push_back(task);
+    }
+
+    if (m_sleepers.load(std::memory_order_seq_cst) != 0) {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);    // no lost wake-up
+        }
+        m_wakeUp.notify_one();
+    }
+}
+
+
+//==================================================================================================
+// Run a task, then notify its group : the group may get destroyed right after, so the task gets
+// released first.
+//==================================================================================================
+void oogl::WorkerPool::run(Task * task)
+{
+    task->function();
+
+    oogl::TaskGroup * const group = task->group;
+
+    if (task->owned) {
+        delete task;
+    }
+
+    if (group != nullptr) {
+        group->complete();
+    }
+}
+
+
+//==================================================================================================
+// Pop a task from the own deque, or else take one from the shared queue, or else steal one from
+// the other workers, starting from the next one.
+//==================================================================================================
+bool oogl::WorkerPool::runOneTask(unsigned int self)
+{
+    Task * task = nullptr;
+
+    if (self < m_workerCount && m_deques[self]->pop(task)) {
+        m_queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+        run(task);
+        return true;
+    }
+
+    if (m_queuedTasks.load(std::memory_order_relaxed) == 0) {    // nothing anywhere
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_sharedMutex);
+        if (! m_shared.empty()) {
+            task = m_shared.front();
+            m_shared.pop_front();
+        }
+    }
+
+    for (unsigned int offset = 1; offset <= m_workerCount && task == nullptr; offset++) {
+        unsigned int const victim = (self + offset) % (m_workerCount + 1);
+
+        if (victim < m_workerCount && victim != self && ! m_deques[victim]->steal(task)) {
+            task = nullptr;
+        }
+    }
+
+    if (task == nullptr) {    // every queue is empty, or the thieves lost the races
+        return false;
+    }
+
+    m_queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+    run(task);
+
+    return true;
+}
+
+
+//==================================================================================================
+// Help the pool until the group is done.
+//==================================================================================================
+void oogl::WorkerPool::wait(oogl::TaskGroup const & group)
+{
+    unsigned int const self = getWorkerIndex();
+
+    while (! group.isDone()) {
+        if (! runOneTask(self)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+
+//==================================================================================================
+// Worker loop : pin and set the thread up, then run tasks while there are some, sleep otherwise.
+//==================================================================================================
+void oogl::WorkerPool::workerLoop(unsigned int index)
+{
+    t_workerPool  = this;
+    t_workerIndex = index;
+
+    OOGL_PROFILE_THREAD("oogl worker " + std::to_string(index));
+
+    #if defined(__linux__)
+    if (! m_affinity.empty()) {    // best effort : the worker keeps running anywhere on failure
+        cpu_set_t cores;
+        CPU_ZERO(&cores);
+        CPU_SET(m_affinity[index % m_affinity.size()], &cores);
+        pthread_setaffinity_np(pthread_self(), sizeof(cores), &cores);
+    }
+    #endif
+
+    if (m_workerHook) {
+        m_workerHook(index);
+    }
+
+    while (true) {
+        if (runOneTask(index)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        if (! m_isRunning && m_queuedTasks == 0) {    // stopped, and nothing left to run
+            break;
+        }
+
+        m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+        m_wakeUp.wait_for(lock, std::chrono::milliseconds(1), [this] () {
+            return m_queuedTasks != 0 || ! m_isRunning;
+        });
+        m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    t_workerPool = nullptr;
+}
+
+
+//==================================================================================================
+// Worker index of the calling thread.
+//==================================================================================================
+unsigned int oogl::WorkerPool::getWorkerIndex() const noexcept
+{
+    return (t_workerPool == this) ? t_workerIndex : m_workerCount;
+}
+
+
+//==================================================================================================
+// Class constructor of a task group.
+//==================================================================================================
+oogl::TaskGroup::TaskGroup(oogl::WorkerPool & pool) noexcept :
+m_pool(pool), m_pending(0), m_mutex(), m_continuations()
+{}
+
+
+//==================================================================================================
+// Class destructor : the pool must not refer to the group anymore.
+//==================================================================================================
+oogl::TaskGroup::~TaskGroup() noexcept
+{
+    wait();
+}
+
+
+//==================================================================================================
+// Submit a task, or run it on the spot without workers.
+//==================================================================================================
+void oogl::TaskGroup::run(std::function<void()> function)
+{
+    m_pending.fetch_add(1, std::memory_order_relaxed);
+    dispatch(new oogl::WorkerPool::Task { std::move(function), this, true });
+}
+
+
+//==================================================================================================
+// Chain a continuation. While continuations are held back, the pending count carries the HOLD bit,
+// so that the group is not done before they are released : the first held continuation sets it,
+// unless no task is pending anymore, in which case the continuation is submitted right away. The
+// bit only changes under the lock.
+//==================================================================================================
+void oogl::TaskGroup::then(std::function<void()> continuation)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        std::size_t pending = m_pending.load(std::memory_order_acquire);
+        while (pending != 0 && (pending & HOLD) == 0
+               && ! m_pending.compare_exchange_weak(pending, pending | HOLD,
+                                                    std::memory_order_acq_rel)) {
+        }
+
+        if (pending != 0) {    // tasks pending : hold it back
+            m_continuations.push_back(std::move(continuation));
+            return;
+        }
+    }
+
+    run(std::move(continuation));
+}
+
+
+//==================================================================================================
+// Wait for the group, running tasks meanwhile.
+//==================================================================================================
+void oogl::TaskGroup::wait()
+{
+    m_pool.wait(*this);
+}
+
+
+//==================================================================================================
+// The group is done once no task is pending, held continuations included.
+//==================================================================================================
+bool oogl::TaskGroup::isDone() const noexcept
+{
+    return m_pending.load(std::memory_order_acquire) == 0;
+}
+
+
+//==================================================================================================
+// A task of the group is done. Once the group reaches zero, a waiting thread may destroy it : the
+// group is not touched anymore after the last decrement. The last task of a group holding
+// continuations keeps its count meanwhile, and swaps it and the HOLD bit for the continuations.
+//==================================================================================================
+void oogl::TaskGroup::complete()
+{
+    std::size_t pending = m_pending.load(std::memory_order_acquire);
+
+    while (pending != HOLD + 1) {    // not the last task before the continuations
+        if (m_pending.compare_exchange_weak(pending, pending - 1, std::memory_order_acq_rel)) {
+            return;
+        }
+    }
+
+    std::vector<std::function<void()>> continuations;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        continuations.swap(m_continuations);
+        m_pending.fetch_add(continuations.size() - HOLD - 1, std::memory_order_acq_rel);
+    }
+
+    for (std::function<void()> & continuation : continuations) {
+        dispatch(new oogl::WorkerPool::Task { std::move(continuation), this, true });
+    }
+}
+
+
+//==================================================================================================
+// Queue a task of the group, already counted as pending, or run it on the spot without workers.
+//==================================================================================================
+void oogl::TaskGroup::dispatch(oogl::WorkerPool::Task * task)
+{
+    if (m_pool.isRunning()) {
+        m_pool.submit(task);
+    } else {
+        m_pool.run(task);
+    }
+}
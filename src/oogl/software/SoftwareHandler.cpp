@@ -0,0 +1,23 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     SoftwareHandler.cpp
+///! \brief    This file contains the definition of the class oogl::software::SoftwareHandler and
+///!           its features. The class oogl::software::SoftwareHandler is the graphic library
+///!           handler of the software library, which renders on the CPU without any display server.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::software::SoftwareHandler
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "software/SoftwareHandler.hpp"    // Inclusion of the header file which declares the class
+                                           // and features which get defined here.
+
+
+
+//==================================================================================================
+// Protected class constructor : the rasterizer and the compositor run on the workers of the
+// handler.
+//==================================================================================================
+oogl::software::SoftwareHandler::SoftwareHandler() :
+oogl::OOGLHandler(), m_rasterizer(getWorkerPool()), m_compositor(getWorkerPool())
+{}
@@ -0,0 +1,259 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///! \file     TileRasterizer.cpp
+///! \brief    This file contains the definition of the class oogl::software::TileRasterizer and
+///!           its features. The class oogl::software::TileRasterizer draws primitives on the CPU :
+///!           the primitives of a frame are binned into screen tiles, and the tiles are rasterized
+///!           independently from each other by the workers of a oogl::WorkerPool.
+///! \author   Stevy Kimpe
+///! \version  1.0.0
+///! \see      oogl::software::TileRasterizer
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Standard include list
+#include <algorithm>
+#include <cmath>
+
+// Include list
+#include "Profiler.hpp"
+
+#include "software/TileRasterizer.hpp"    // Inclusion of the header file which declares the class
+                                          // and features which get defined here.
+
+
+
+//==================================================================================================
+// Class constructor.
+//==================================================================================================
+oogl::software::TileRasterizer::TileRasterizer(oogl::WorkerPool & pool) :
+m_pool(pool), m_target({nullptr, 0, 0, 0}), m_tilesX(0), m_tilesY(0), m_primitives(), m_bins()
+{}
+
+
+//==================================================================================================
+// Start a new frame : forget the primitives of the previous one.
+//==================================================================================================
+void oogl::software::TileRasterizer::beginFrame(RenderTarget const & target)
+{
+    m_target = target;
+    m_tilesX = (target.width  + TILE_SIZE - 1) / TILE_SIZE;
+    m_tilesY = (target.height + TILE_SIZE - 1) / TILE_SIZE;
+    m_primitives.clear();
+}
+
+
+//==================================================================================================
+// Clearing is a rectangle covering the whole target.
+//==================================================================================================
+void oogl::software::TileRasterizer::clear(uint32_t color)
+{
+    fillRectangle(0, 0, static_cast<int>(m_target.width), static_cast<int>(m_target.height), color);
+}
+
+
+//==================================================================================================
+// Record a rectangle.
+//==================================================================================================
+void oogl::software::TileRasterizer::fillRectangle(int x, int y, int width, int height,
+                                                   uint32_t color)
+{
+    Primitive primitive;
+    primitive.kind  = Primitive::RECTANGLE;
+    primitive.minX  = x;
+    primitive.minY  = y;
+    primitive.maxX  = x + width;
+    primitive.maxY  = y + height;
+    primitive.color = color;
+
+    record(primitive);
+}
+
+
+//==================================================================================================
+// Record a triangle. Its vertices are reordered so that its signed area is positive, which lets the
+// rasterization test every edge function the same way.
+//==================================================================================================
+void oogl::software::TileRasterizer::fillTriangle(float x0, float y0, float x1, float y1,
+                                                  float x2, float y2, uint32_t color)
+{
+    float const area = (x1 - x0) * (y2 - y0) - (y1 - y0) * (x2 - x0);
+
+    if (area == 0.0f) {    // degenerated triangle : no pixel gets covered
+        return;
+    } else if (area < 0.0f) {
+        std::swap(x1, x2);
+        std::swap(y1, y2);
+    }
+
+    Primitive primitive;
+    primitive.kind  = Primitive::TRIANGLE;
+    primitive.x[0]  = x0;    primitive.y[0] = y0;
+    primitive.x[1]  = x1;    primitive.y[1] = y1;
+    primitive.x[2]  = x2;    primitive.y[2] = y2;
+    primitive.minX  = static_cast<int>(std::floor(std::min({x0, x1, x2})));
+    primitive.minY  = static_cast<int>(std::floor(std::min({y0, y1, y2})));
+    primitive.maxX  = static_cast<int>(std::ceil(std::max({x0, x1, x2})));
+    primitive.maxY  = static_cast<int>(std::ceil(std::max({y0, y1, y2})));
+    primitive.color = color;
+
+    record(primitive);
+}
+
+
+//==================================================================================================
+// Bin the frame primitives per slice, then rasterize the tiles : both steps run on the workers.
+//==================================================================================================
+void oogl::software::TileRasterizer::endFrame()
+{
+    OOGL_PROFILE_ZONE("TileRasterizer::endFrame");
+
+    if (m_primitives.empty()) {    // nothing to draw
+        return;
+    }
+
+    std::size_t const tileCount  = static_cast<std::size_t>(m_tilesX) * m_tilesY;
+    std::size_t const sliceCount = std::min<std::size_t>(m_pool.getWorkerCount(),
+                                                         m_primitives.size());
+
+    m_bins.resize(sliceCount);
+    for (std::vector<std::vector<uint32_t>> & slice : m_bins) {
+        slice.resize(tileCount);
+        for (std::vector<uint32_t> & bin : slice) {
+            bin.clear();                             // keep the memory of the previous frames
+        }
+    }
+
+    {
+        OOGL_PROFILE_ZONE("TileRasterizer::bin");
+        m_pool.parallelFor(sliceCount, [this] (std::size_t slice) { binSlice(slice); });
+    }
+
+    {
+        OOGL_PROFILE_ZONE("TileRasterizer::rasterize");
+        m_pool.parallelFor(tileCount,  [this] (std::size_t tile)  { rasterizeTile(tile); });
+    }
+
+    m_primitives.clear();
+}
+
+
+//==================================================================================================
+// Clip the bounding box of a primitive to the target, and keep it if it still covers pixels.
+//==================================================================================================
+void oogl::software::TileRasterizer::record(Primitive & primitive)
+{
+    primitive.minX = std::max(primitive.minX, 0);
+    primitive.minY = std::max(primitive.minY, 0);
+    primitive.maxX = std::min(primitive.maxX, static_cast<int>(m_target.width));
+    primitive.maxY = std::min(primitive.maxY, static_cast<int>(m_target.height));
+
+    if (primitive.minX < primitive.maxX && primitive.minY < primitive.maxY) {
+        m_primitives.push_back(primitive);
+    }
+}
+
+
+//==================================================================================================
+// Append the primitives of a slice to the bins of the tiles their bounding box overlaps.
+//==================================================================================================
+void oogl::software::TileRasterizer::binSlice(std::size_t slice)
+{
+    std::size_t const sliceCount = m_bins.size();
+    std::size_t const first      = slice       * m_primitives.size() / sliceCount;
+    std::size_t const last       = (slice + 1) * m_primitives.size() / sliceCount;
+
+    std::vector<std::vector<uint32_t>> & bins = m_bins[slice];
+
+    for (std::size_t index = first; index < last; index++) {
+        Primitive const & primitive = m_primitives[index];
+
+        unsigned int const firstTileX = primitive.minX / TILE_SIZE;
+        unsigned int const firstTileY = primitive.minY / TILE_SIZE;
+        unsigned int const lastTileX  = (primitive.maxX - 1) / TILE_SIZE;
+        unsigned int const lastTileY  = (primitive.maxY - 1) / TILE_SIZE;
+
+        for (unsigned int tileY = firstTileY; tileY <= lastTileY; tileY++) {
+            for (unsigned int tileX = firstTileX; tileX <= lastTileX; tileX++) {
+                bins[tileY * m_tilesX + tileX].push_back(static_cast<uint32_t>(index));
+            }
+        }
+    }
+}
+
+
+//==================================================================================================
+// Rasterize a tile : the slices are walked in order, so that the submission order is kept.
+//==================================================================================================
+void oogl::software::TileRasterizer::rasterizeTile(std::size_t tile)
+{
+    int const tileX    = static_cast<int>(tile % m_tilesX) * TILE_SIZE;
+    int const tileY    = static_cast<int>(tile / m_tilesX) * TILE_SIZE;
+    int const tileMaxX = std::min(tileX + static_cast<int>(TILE_SIZE),
+                                  static_cast<int>(m_target.width));
+    int const tileMaxY = std::min(tileY + static_cast<int>(TILE_SIZE),
+                                  static_cast<int>(m_target.height));
+
+    for (std::vector<std::vector<uint32_t>> const & slice : m_bins) {
+        for (uint32_t index : slice[tile]) {
+            rasterize(m_primitives[index], tileX, tileY, tileMaxX, tileMaxY);
+        }
+    }
+}
+
+
+//==================================================================================================
+// Rasterize a primitive within the tile bounds. Triangles are tested against their three edge
+// functions at each pixel center ; the top-left rule decides for the pixels lying on an edge.
+//==================================================================================================
+void oogl::software::TileRasterizer::rasterize(Primitive const & primitive, int tileX, int tileY,
+                                               int tileMaxX, int tileMaxY)
+{
+    int const minX = std::max(primitive.minX, tileX);
+    int const minY = std::max(primitive.minY, tileY);
+    int const maxX = std::min(primitive.maxX, tileMaxX);
+    int const maxY = std::min(primitive.maxY, tileMaxY);
+
+    if (minX >= maxX || minY >= maxY) {    // the bounding box only overlaps a neighbour tile
+        return;
+    }
+
+    if (primitive.kind == Primitive::RECTANGLE) {
+        for (int y = minY; y < maxY; y++) {
+            std::fill_n(m_target.pixels + y * m_target.pitch + minX, maxX - minX, primitive.color);
+        }
+        return;
+    }
+
+    // Edge function of the edge from vertex a to vertex b : E(x, y) = A.x + B.y + C
+    float edgeA[3], edgeB[3], edgeC[3];
+    bool  isTopLeft[3];
+
+    for (int edge = 0; edge < 3; edge++) {
+        int const a = edge;
+        int const b = (edge + 1) % 3;
+
+        edgeA[edge]     = primitive.y[a] - primitive.y[b];
+        edgeB[edge]     = primitive.x[b] - primitive.x[a];
+        edgeC[edge]     = - edgeB[edge] * primitive.y[a] - edgeA[edge] * primitive.x[a];
+        isTopLeft[edge] = (edgeA[edge] > 0.0f) || (edgeA[edge] == 0.0f && edgeB[edge] > 0.0f);
+    }
+
+    for (int y = minY; y < maxY; y++) {
+        uint32_t * const row     = m_target.pixels + y * m_target.pitch;
+        float const      centerY = static_cast<float>(y) + 0.5f;
+
+        for (int x = minX; x < maxX; x++) {
+            float const centerX = static_cast<float>(x) + 0.5f;
+            bool        inside  = true;
+
+            for (int edge = 0; edge < 3 && inside; edge++) {
+                float const value = edgeA[edge] * centerX + edgeB[edge] * centerY + edgeC[edge];
+                inside = (value > 0.0f) || (value == 0.0f && isTopLeft[edge]);
+            }
+
+            if (inside) {
+                row[x] = primitive.color;
+            }
+        }
+    }
+}